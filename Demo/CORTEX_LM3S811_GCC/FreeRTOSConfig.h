@@ -45,14 +45,26 @@
 #define configCPU_CLOCK_HZ			( ( unsigned long ) 20000000 )
 #define configTICK_RATE_HZ			( ( TickType_t ) 1000 )
 #define configMINIMAL_STACK_SIZE	( ( unsigned short ) 160 )
+// The functions that make RAMFUNC=1 runs from SRAM (make ramfunc prints their size), and the
+// branch counters of make PGO=generate, take SRAM from the heap.  The demo's tasks and queues
+// need about 3400 bytes of it, and 4000 with SWITCH_TIMING_TEST.
+#if ( defined( mainRAMFUNC ) && ( mainRAMFUNC == 1 ) ) || ( defined( mainPGO_GENERATE ) && ( mainPGO_GENERATE == 1 ) )
+#define configTOTAL_HEAP_SIZE		( ( size_t ) ( 4500 ) )
+#else
 #define configTOTAL_HEAP_SIZE		( ( size_t ) ( 6000 ) )
+#endif
 #define configMAX_TASK_NAME_LEN		( 10 )
 #define configUSE_TRACE_FACILITY	1
 #define configUSE_16_BIT_TICKS		0
 #define configIDLE_SHOULD_YIELD		0
 #define configMAX_PRIORITIES		( 5 )
 #define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
+// Set to 3 to have the MPU guard the end of each task's stack instead of checking it on every
+// context switch.  The guard takes the bottom 32 to 56 bytes of each stack.  make STACK_CHECK=3
+// sets it from the command line.
+#ifndef configCHECK_FOR_STACK_OVERFLOW
 #define configCHECK_FOR_STACK_OVERFLOW	2
+#endif
 #define configGENERATE_RUN_TIME_STATS	1
 #define configSUPPORT_DYNAMIC_ALLOCATION 1
 
@@ -60,12 +72,39 @@
 #define configFILTER_STACK_SIZE		    ( ( unsigned short ) 150 )
 #define configGRAPH_STACK_SIZE		    ( ( unsigned short ) 145 )
 #define configRECEIVE_CHAR_STACK_SIZE	( ( unsigned short ) 55 )
+// vTopTask also prints the branch counts of make PGO=generate, through libgcov.
+#if defined( mainPGO_GENERATE ) && ( mainPGO_GENERATE == 1 )
+#define configTOP_STACK_SIZE		    ( ( unsigned short ) 130 )
+#else
 #define configTOP_STACK_SIZE		    ( ( unsigned short ) 65 )
+#endif
+#define configSWITCH_STACK_SIZE		    ( ( unsigned short ) 60 )
 
 // Define these macros to enable run-time stats collection
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    ( prvConfigTimer() )
 #define portGET_RUN_TIME_COUNTER_VALUE()            ( ulGetRunTimeCounterValue() )
 
+// Set to 1 to time every critical section and scheduler suspended region per call site.
+// The worst cases are then printed by vTopTask. Timer1 is used as the timestamp counter.
+#define configGENERATE_CRITICAL_SECTION_STATS       0
+#define portGET_CRITICAL_SECTION_TIMESTAMP()        ( ulGetCriticalSectionTimestamp() )
+
+// Switch straight to a task woken by an interrupt (or another task) that preempts the running task,
+// without searching the ready lists.  Off by default, as the search is a single clz on the
+// Cortex-M3 and the gain has not been measured here.  make clean; make WOKEN_TASK_SELECTION=1
+// ISR_LATENCY_TEST=1 turns it on and measures it against a build without it.
+#ifndef configUSE_WOKEN_TASK_SELECTION
+#define configUSE_WOKEN_TASK_SELECTION              0
+#endif
+
+// Set to 1 (make COMPACT_LIST_ITEMS=1) to link the kernel's lists with 16-bit indexes into the
+// 8KB of SRAM instead of pointers.  Each task and each queue is then 16 bytes smaller, and the
+// kernel's own lists 80 bytes smaller.
+#ifndef configUSE_COMPACT_LIST_ITEMS
+#define configUSE_COMPACT_LIST_ITEMS                0
+#endif
+#define configLIST_ARENA_BASE                       0x20000000UL
+
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
 
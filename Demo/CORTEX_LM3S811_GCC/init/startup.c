@@ -40,6 +40,28 @@ extern void vUART_ISR( void );
 extern void vGPIO_ISR( void );
 extern void vPortSVCHandler( void );
 
+//*****************************************************************************
+//
+// When built with make SWITCH_TIMING_TEST=1 the SysTick interrupt goes to
+// vTimedSysTickHandler() in main.c, which times xPortSysTickHandler().
+//
+//*****************************************************************************
+#if defined(mainSWITCH_TIMING_TEST) && (mainSWITCH_TIMING_TEST == 1)
+extern void vTimedSysTickHandler(void);
+#define SysTickHandler                          vTimedSysTickHandler
+#else
+#define SysTickHandler                          xPortSysTickHandler
+#endif
+
+//*****************************************************************************
+//
+// The port only provides vPortMemManageHandler() when configCHECK_FOR_STACK_
+// OVERFLOW is 3, to report writes to the MPU guard at the end of each task's
+// stack.  Otherwise MPU faults go to the default handler.
+//
+//*****************************************************************************
+void vPortMemManageHandler(void) __attribute__ ((weak, alias("IntDefaultHandler")));
+
 //*****************************************************************************
 //
 // The entry point for the application.
@@ -61,10 +83,11 @@ static unsigned long pulStack[STACK_SIZE];
 //
 // The minimal vector table for a Cortex-M3.  Note that the proper constructs
 // must be placed on this to ensure that it ends up at physical address
-// 0x0000.0000.
+// 0x0000.0000.  It is marked used as nothing refers to it, and the link time
+// optimizer (make LTO=1) would otherwise drop it.
 //
 //*****************************************************************************
-__attribute__ ((section(".isr_vector")))
+__attribute__ ((section(".isr_vector"), used))
 void (* const g_pfnVectors[])(void) =
 {
     (void (*)(void))((unsigned long)pulStack + sizeof(pulStack)),
@@ -72,7 +95,7 @@ void (* const g_pfnVectors[])(void) =
     ResetISR,                               // The reset handler
     NmiSR,                                  // The NMI handler
     FaultISR,                               // The hard fault handler
-    IntDefaultHandler,                      // The MPU fault handler
+    vPortMemManageHandler,                  // The MPU fault handler
     IntDefaultHandler,                      // The bus fault handler
     IntDefaultHandler,                      // The usage fault handler
     0,                                      // Reserved
@@ -83,7 +106,7 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // Debug monitor handler
     0,                                      // Reserved
     xPortPendSVHandler,                     // The PendSV handler
-    xPortSysTickHandler,                    // The SysTick handler
+    SysTickHandler,                         // The SysTick handler
     IntDefaultHandler,                      // GPIO Port A
     IntDefaultHandler,                      // GPIO Port B
     IntDefaultHandler,						// GPIO Port C
@@ -121,9 +144,14 @@ void (* const g_pfnVectors[])(void) =
 // The following are constructs created by the linker, indicating where the
 // the "data" and "bss" segments reside in memory.  The initializers for the
 // for the "data" segment resides immediately following the "text" segment.
+// The code of the "ramfunc" segment is loaded at _ramfunc_load, after the
+// vector table.
 //
 //*****************************************************************************
 extern unsigned long _etext;
+extern unsigned long _ramfunc_load;
+extern unsigned long _ramfunc;
+extern unsigned long _eramfunc;
 extern unsigned long _data;
 extern unsigned long _edata;
 extern unsigned long _bss;
@@ -144,6 +172,15 @@ ResetISR(void)
 {
     unsigned long *pulSrc, *pulDest;
 
+    //
+    // Copy the functions that run from SRAM (see standalone.ld) from flash.
+    //
+    pulSrc = &_ramfunc_load;
+    for(pulDest = &_ramfunc; pulDest < &_eramfunc; )
+    {
+        *pulDest++ = *pulSrc++;
+    }
+
     //
     // Copy the data segment initializers from flash to SRAM.
     //
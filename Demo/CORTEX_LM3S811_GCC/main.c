@@ -55,12 +55,49 @@
 
 #define MONITORING_STACK_WATER_MARK 0 //Enable this for stack monitoring
 
+/* Build with make STACK_OVERFLOW_TEST=1 to add a task that overflows its stack on purpose. */
+#ifndef mainSTACK_OVERFLOW_TEST
+#define mainSTACK_OVERFLOW_TEST 0
+#endif
+
+/* Build with make ISR_LATENCY_TEST=1 to time, in Timer1 cycles, how long a character takes to get
+from the UART interrupt to vReceiveCharTask.  The times are printed by vTopTask. */
+#ifndef mainISR_LATENCY_TEST
+#define mainISR_LATENCY_TEST 0
+#endif
+
+/* Build with make SWITCH_TIMING_TEST=1 to time, in Timer1 cycles, each SysTick interrupt and each
+switch between two tasks that yield to each other.  The times are printed by vTopTask.  Build it
+with and without RAMFUNC=1 to see what running the kernel's hot paths from SRAM changes. */
+#ifndef mainSWITCH_TIMING_TEST
+#define mainSWITCH_TIMING_TEST 0
+#endif
+#define mainSWITCH_TIMING_YIELDS    ( 100 )
+
+/* Build with make PGO=generate to count the branches the kernel takes, for a PGO=use build (see the
+Makefile).  vTopTask prints the counts over the UART once the demo has run for mainPGO_DUMP_DELAY. */
+#ifndef mainPGO_GENERATE
+#define mainPGO_GENERATE 0
+#endif
+#define mainPGO_DUMP_DELAY          ( ( TickType_t ) 30000 / portTICK_PERIOD_MS ) // 30 seg
+
+#if ( mainPGO_GENERATE == 1 )
+#include <gcov.h>
+
+/* The counters of each source file, gathered by standalone.ld. */
+extern const struct gcov_info *const __gcov_info_start[];
+extern const struct gcov_info *const __gcov_info_end[];
+#endif
+
 void vTemperatureSensorTask( void *pvParameters );
 void vFilterTask( void *pvParameters );
 void vGraphTask( void *pvParameters );
 void vReceiveCharTask( void *pvParameters );
 void vMonitorTask( void *pvParameters );
 void vTopTask( void *pvParameters );
+void vStackOverflowTask( void *pvParameters );
+void vSwitchTimingTask( void *pvParameters );
+void vSwitchPartnerTask( void *pvParameters );
 
 void prvSetupHardware( void );
 void prvConfigTimer(void);
@@ -75,6 +112,14 @@ void UARTSendString(const char *str);
 void vTimer0IntHandler(void);
 unsigned long ulGetRunTimeCounterValue(void);
 void printTop(void);
+void prvConfigProfilingTimer(void);
+unsigned long ulGetCriticalSectionTimestamp(void);
+void printCriticalSectionStats(void);
+void printISRLatency(void);
+void printSwitchTiming(void);
+void printProfile(void);
+void vTimedSysTickHandler(void);
+void xPortSysTickHandler(void);
 
 
 static uint32_t _dwRandNext = 0xEEEEAAAA;
@@ -83,6 +128,23 @@ int UARTBufferIndex = 0;
 char UARTInputBuffer[UART_BUFFER_SIZE];
 unsigned long runTimeCounter;
 TaskStatus_t *pxTaskStatusArray;
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+CriticalSectionStats_t *pxCriticalSectionStatsArray;
+#endif
+#if ( mainISR_LATENCY_TEST == 1 )
+volatile unsigned long ulUARTInterruptTime;
+unsigned long ulLatencyCount, ulLatencyMin = 0xFFFFFFFFUL, ulLatencyMax;
+unsigned long long ullLatencyTotal;
+#endif
+#if ( mainSWITCH_TIMING_TEST == 1 )
+TaskHandle_t xSwitchPartnerTaskHandle;
+volatile BaseType_t xSwitchBurst;
+volatile unsigned long ulSwitchStart;
+unsigned long ulSwitchCount, ulSwitchMin = 0xFFFFFFFFUL, ulSwitchMax;
+unsigned long long ullSwitchTotal;
+unsigned long ulTickCount, ulTickMin = 0xFFFFFFFFUL, ulTickMax;
+unsigned long long ullTickTotal;
+#endif
 
 
 QueueHandle_t xTemperatureQueue;
@@ -123,6 +185,13 @@ int main( void )
     if(MONITORING_STACK_WATER_MARK){
         xTaskCreate( vMonitorTask, "Monitor", configMINIMAL_STACK_SIZE, NULL, mainCHECK_TASK_PRIORITY - 3, NULL);
     }
+#if ( mainSTACK_OVERFLOW_TEST == 1 )
+    xTaskCreate( vStackOverflowTask, "Overflow", configMINIMAL_STACK_SIZE, NULL, mainCHECK_TASK_PRIORITY - 3, NULL);
+#endif
+#if ( mainSWITCH_TIMING_TEST == 1 )
+    xTaskCreate( vSwitchTimingTask, "Switch", configSWITCH_STACK_SIZE, NULL, mainCHECK_TASK_PRIORITY + 1, NULL);
+    xTaskCreate( vSwitchPartnerTask, "Partner", configSWITCH_STACK_SIZE, NULL, mainCHECK_TASK_PRIORITY + 1, &xSwitchPartnerTaskHandle);
+#endif
 
 	/* Start the scheduler. */
 	vTaskStartScheduler();
@@ -219,6 +288,17 @@ void vReceiveCharTask( void *pvParameters ){
     while(1){
         xQueueReceive(xUARTQueue, &receivedChar, portMAX_DELAY);
 
+#if ( mainISR_LATENCY_TEST == 1 )
+        {
+            unsigned long ulLatency = ulGetCriticalSectionTimestamp() - ulUARTInterruptTime;
+
+            ulLatencyCount++;
+            ullLatencyTotal += ulLatency;
+            if (ulLatency < ulLatencyMin) ulLatencyMin = ulLatency;
+            if (ulLatency > ulLatencyMax) ulLatencyMax = ulLatency;
+        }
+#endif
+
         /* Check if the received character is a digit or Enter */
         if (receivedChar >= '0' && receivedChar <= '9')
         {
@@ -254,6 +334,9 @@ void vReceiveCharTask( void *pvParameters ){
 void vTopTask( void *pvParameters ){
     UBaseType_t uxArraySize = uxTaskGetNumberOfTasks();
 	pxTaskStatusArray = pvPortMalloc(uxArraySize * sizeof(TaskStatus_t));
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+    pxCriticalSectionStatsArray = pvPortMalloc(configCRITICAL_SECTION_STATS_MAX_SITES * sizeof(CriticalSectionStats_t));
+#endif
 
     while(1){
         vTaskDelay(configTOP_DELAY);
@@ -263,6 +346,10 @@ void vTopTask( void *pvParameters ){
         }
 
         printTop();
+        printCriticalSectionStats();
+        printISRLatency();
+        printSwitchTiming();
+        printProfile();
     }
 }
 
@@ -301,9 +388,108 @@ void vMonitorTask(void *pvParameters) {
     }
 }
 
+#if ( mainSTACK_OVERFLOW_TEST == 1 )
+/**
+ * @brief Calls itself until the stack runs out.
+ *
+ * The local buffer and the use of the result after the call keep the compiler
+ * from turning the recursion into a loop.
+ *
+ * @param depth The number of calls so far.
+ * @return The sum of the depths, which is never used.
+ */
+static int prvRecurse(int depth) {
+    volatile char buffer[32];
+
+    buffer[0] = (char) depth;
+    if (depth > 1000) {
+        return 0;
+    }
+    return prvRecurse(depth + 1) + buffer[0];
+}
+
+/**
+ * @brief Overflow the task's stack on purpose, to check that the overflow is caught.
+ *
+ * With configCHECK_FOR_STACK_OVERFLOW 3 the MPU faults on the first write past the
+ * end of the stack and vApplicationStackOverflowHook() is called straight away.  With
+ * 1 or 2 the kernel only checks at the next context switch, by which time the
+ * overflow may already have corrupted memory.
+ */
+void vStackOverflowTask(void *pvParameters) {
+    vTaskDelay(pdMS_TO_TICKS(1000));
+    UARTSendString("Overflowing the stack of the Overflow task\r\n");
+    prvRecurse(0);
+
+    for (;;) {
+        vTaskDelay(portMAX_DELAY);
+    }
+}
+#endif
+
+#if ( mainSWITCH_TIMING_TEST == 1 )
+/**
+ * @brief Yield to the other switch timing task and time the switch back.
+ *
+ * The task that yields records the time in ulSwitchStart, so the time read when the other
+ * task returns from its own yield is one context switch.  Nothing is recorded once the burst
+ * is over, as the switch back then follows vSwitchTimingTask blocking.
+ */
+static void prvYieldAndTime(void) {
+    unsigned long ulSwitch;
+
+    ulSwitchStart = ulGetCriticalSectionTimestamp();
+    taskYIELD();
+    ulSwitch = ulGetCriticalSectionTimestamp() - ulSwitchStart;
+
+    if (xSwitchBurst == pdTRUE) {
+        ulSwitchCount++;
+        ullSwitchTotal += ulSwitch;
+        if (ulSwitch < ulSwitchMin) ulSwitchMin = ulSwitch;
+        if (ulSwitch > ulSwitchMax) ulSwitchMax = ulSwitch;
+    }
+}
+
+/**
+ * @brief Every 100 ms, switch back and forth with vSwitchPartnerTask mainSWITCH_TIMING_YIELDS times.
+ *
+ * Both tasks run at the highest priority, so only the Sensor task and the interrupts can get
+ * in between.  Those switches show up in the maximum rather than the minimum.
+ */
+void vSwitchTimingTask(void *pvParameters) {
+    int i;
+
+    for (;;) {
+        vTaskDelay(configSENSOR_FREQUENCY_MS);
+
+        xSwitchBurst = pdTRUE;
+        xTaskNotifyGive(xSwitchPartnerTaskHandle);
+        for (i = 0; i < mainSWITCH_TIMING_YIELDS; i++) {
+            prvYieldAndTime();
+        }
+        xSwitchBurst = pdFALSE;
+    }
+}
+
+/**
+ * @brief Yield back to vSwitchTimingTask for as long as its burst lasts, then wait for the next one.
+ */
+void vSwitchPartnerTask(void *pvParameters) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while (xSwitchBurst == pdTRUE) {
+            prvYieldAndTime();
+        }
+    }
+}
+#endif
+
 //--------------------CONFIG FUNCTIONS--------------------
 
 void prvSetupHardware(void) {
+    /* The timestamp counter must be running before the first critical section. */
+    prvConfigProfilingTimer();
+
 	/* Enable the UART.  */
 	SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
 	UARTConfigSet(UART0_BASE, mainBAUD_RATE, (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE));
@@ -325,6 +511,17 @@ void prvConfigTimer(void){
     TimerIntRegister(TIMER0_BASE, TIMER_A, vTimer0IntHandler);
     TimerEnable(TIMER0_BASE, TIMER_A);
 }
+
+void prvConfigProfilingTimer(void){
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 ) || ( mainISR_LATENCY_TEST == 1 ) || ( mainSWITCH_TIMING_TEST == 1 )
+    /* Free running 32 bit timer clocked at the system clock, used to time critical sections,
+    the interrupt to task latency, the tick and the context switch */
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER1);
+    TimerConfigure(TIMER1_BASE, TIMER_CFG_32_BIT_PER);
+    TimerLoadSet(TIMER1_BASE, TIMER_A, 0xFFFFFFFF);
+    TimerEnable(TIMER1_BASE, TIMER_A);
+#endif
+}
 /*-----------------------------------------------------------*/
 
 // ------------------------- UTIL FUNCTIONS -------------------------
@@ -518,6 +715,9 @@ int atoi(char *str){
 
 void vApplicationStackOverflowHook(TaskHandle_t pxTask, char *pcTaskName) {
     // Detener el sistema o reiniciar
+    UARTSendString("Stack Overflow: ");
+    UARTSendString(pcTaskName);
+    UARTSendString("\r\n");
     OSRAMClear();
     OSRAMStringDraw("Stack Overflow", 0, 0);
     OSRAMStringDraw(pcTaskName, 0, 1);
@@ -528,6 +728,17 @@ unsigned long ulGetRunTimeCounterValue(void) {
     return runTimeCounter;
 }
 
+/**
+ * @brief Timestamp used by the kernel to time critical sections.
+ *
+ * Timer1 counts down, so it is inverted to get the up counting value the kernel expects.
+ *
+ * @return The current timestamp in system clock cycles.
+ */
+unsigned long ulGetCriticalSectionTimestamp(void) {
+    return 0xFFFFFFFFUL - TimerValueGet(TIMER1_BASE, TIMER_A);
+}
+
 void printTop(void){
     volatile UBaseType_t uxArraySize;
     volatile UBaseType_t x;
@@ -574,11 +785,208 @@ void printTop(void){
     }
 }
 
+/**
+ * @brief Print the critical section and scheduler suspended times of each call site.
+ *
+ * The MAX column is the worst case time in Timer1 cycles, which is what sets the interrupt latency.
+ */
+void printCriticalSectionStats(void){
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+    UBaseType_t uxSites;
+    UBaseType_t x;
+    uint32_t ulDropped;
+    char number[12];
+
+    if (pxCriticalSectionStatsArray != NULL)
+    {
+        uxSites = uxTaskGetCriticalSectionStats(pxCriticalSectionStatsArray, configCRITICAL_SECTION_STATS_MAX_SITES, &ulDropped);
+
+        UARTSendString("SITE\tTYPE\tCOUNT\tMAX\tMEAN\r\n");
+        UARTSendString("---------------------------------------\r\n");
+
+        for (x = 0; x < uxSites; x++)
+        {
+            UARTSendString(pxCriticalSectionStatsArray[x].pcFile);
+            UARTSendString(":");
+            itoa(pxCriticalSectionStatsArray[x].ulLine, number, 10);
+            UARTSendString(number);
+            UARTSendString(pxCriticalSectionStatsArray[x].eType == eInterruptsMasked ? "\tCRIT\t" : "\tSUSP\t");
+            itoa(pxCriticalSectionStatsArray[x].ulCount, number, 10);
+            UARTSendString(number);
+            UARTSendString("\t");
+            itoa(pxCriticalSectionStatsArray[x].ulMaxDuration, number, 10);
+            UARTSendString(number);
+            UARTSendString("\t");
+            itoa(pxCriticalSectionStatsArray[x].ulCount > 0 ? (int)(pxCriticalSectionStatsArray[x].ullTotalDuration / pxCriticalSectionStatsArray[x].ulCount) : 0, number, 10);
+            UARTSendString(number);
+            UARTSendString("\r\n");
+        }
+
+        if (ulDropped > 0)
+        {
+            itoa(ulDropped, number, 10);
+            UARTSendString("Dropped (table full): ");
+            UARTSendString(number);
+            UARTSendString("\r\n");
+        }
+
+        UARTSendString("\r\n\r\n");
+    }
+#endif
+}
+
+/**
+ * @brief Print the time from the UART interrupt to vReceiveCharTask receiving the character.
+ *
+ * The times are in Timer1 cycles.  Under QEMU run with -icount so they count instructions
+ * rather than host time.
+ */
+void printISRLatency(void){
+#if ( mainISR_LATENCY_TEST == 1 )
+    char number[12];
+
+    if (ulLatencyCount > 0)
+    {
+        UARTSendString("ISR->TASK\tCOUNT\tMIN\tMAX\tMEAN\r\n");
+        itoa(ulLatencyCount, number, 10);
+        UARTSendString("\t\t");
+        UARTSendString(number);
+        UARTSendString("\t");
+        itoa(ulLatencyMin, number, 10);
+        UARTSendString(number);
+        UARTSendString("\t");
+        itoa(ulLatencyMax, number, 10);
+        UARTSendString(number);
+        UARTSendString("\t");
+        itoa((int)(ullLatencyTotal / ulLatencyCount), number, 10);
+        UARTSendString(number);
+        UARTSendString("\r\n\r\n");
+    }
+#endif
+}
+
+#if ( mainSWITCH_TIMING_TEST == 1 )
+static void prvPrintTimingRow(const char *pcName, unsigned long ulCount, unsigned long ulMin,
+                              unsigned long ulMax, unsigned long long ullTotal) {
+    char number[12];
+
+    UARTSendString(pcName);
+    UARTSendString("\t");
+    itoa(ulCount, number, 10);
+    UARTSendString(number);
+    UARTSendString("\t");
+    itoa(ulMin, number, 10);
+    UARTSendString(number);
+    UARTSendString("\t");
+    itoa(ulMax, number, 10);
+    UARTSendString(number);
+    UARTSendString("\t");
+    itoa((int)(ullTotal / ulCount), number, 10);
+    UARTSendString(number);
+    UARTSendString("\r\n");
+}
+#endif
+
+/**
+ * @brief Print the time taken by the SysTick interrupt and by a context switch.
+ *
+ * The times are in Timer1 cycles, and include one read of Timer1.  Under QEMU run with -icount
+ * so they count instructions rather than host time.
+ */
+void printSwitchTiming(void){
+#if ( mainSWITCH_TIMING_TEST == 1 )
+    if ((ulTickCount > 0) && (ulSwitchCount > 0))
+    {
+        UARTSendString("TIMING\tCOUNT\tMIN\tMAX\tMEAN\r\n");
+        prvPrintTimingRow("TICK", ulTickCount, ulTickMin, ulTickMax, ullTickTotal);
+        prvPrintTimingRow("SWITCH", ulSwitchCount, ulSwitchMin, ulSwitchMax, ullSwitchTotal);
+        UARTSendString("\r\n");
+    }
+#endif
+}
+
+#if ( mainPGO_GENERATE == 1 )
+static void prvPutGcdaFilename(const char *pcFilename, void *pvArg) {
+    UARTSendString("\r\ngcda:");
+    UARTSendString(pcFilename != NULL ? pcFilename : "");
+    UARTSendString(":");
+}
+
+static void prvPutGcdaData(const void *pvData, unsigned uxLength, void *pvArg) {
+    static const char pcDigits[] = "0123456789abcdef";
+    const unsigned char *pucData = pvData;
+
+    while (uxLength-- > 0) {
+        UARTCharPut(UART0_BASE, pcDigits[*pucData >> 4]);
+        UARTCharPut(UART0_BASE, pcDigits[*pucData++ & 0x0f]);
+    }
+}
+
+static void *prvAllocateGcda(unsigned uxLength, void *pvArg) {
+    return pvPortMalloc(uxLength);
+}
+#endif
+
+/**
+ * @brief Print the branch counts of a PGO=generate build, once the demo has run for mainPGO_DUMP_DELAY.
+ *
+ * The counts of each source file are printed on a line of their own, as the name of its .gcda file and
+ * the contents of the file in hex, for make pgo-profile to write back.  They are printed in a critical
+ * section so that the tick and the other tasks do not change them half way through.
+ */
+void printProfile(void){
+#if ( mainPGO_GENERATE == 1 )
+    static BaseType_t xPrinted = pdFALSE;
+    const struct gcov_info *const *ppxInfo = __gcov_info_start;
+
+    if ((xPrinted == pdFALSE) && (xTaskGetTickCount() >= mainPGO_DUMP_DELAY))
+    {
+        xPrinted = pdTRUE;
+
+        /* Hide where ppxInfo points, as comparing pointers into two different arrays is
+        undefined and the compiler could drop the loop. */
+        __asm volatile ("" : "+r" (ppxInfo));
+
+        taskENTER_CRITICAL();
+        for (; ppxInfo < __gcov_info_end; ppxInfo++)
+        {
+            __gcov_info_to_gcda(*ppxInfo, prvPutGcdaFilename, prvPutGcdaData, prvAllocateGcda, NULL);
+            UARTSendString("\r\n");
+        }
+        taskEXIT_CRITICAL();
+    }
+#endif
+}
+
 // ------------------------- ISR --------------------------------
 
+#if ( mainSWITCH_TIMING_TEST == 1 )
+/**
+ * @brief SysTick handler used in place of xPortSysTickHandler() (see init/startup.c) to time it.
+ */
+void vTimedSysTickHandler(void)
+{
+    unsigned long ulStart, ulTick;
+
+    ulStart = ulGetCriticalSectionTimestamp();
+    xPortSysTickHandler();
+    ulTick = ulGetCriticalSectionTimestamp() - ulStart;
+
+    ulTickCount++;
+    ullTickTotal += ulTick;
+    if (ulTick < ulTickMin) ulTickMin = ulTick;
+    if (ulTick > ulTickMax) ulTickMax = ulTick;
+}
+#endif
+
 void vUART_ISR(void)
 {
     unsigned long ulStatus;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+#if ( mainISR_LATENCY_TEST == 1 )
+    ulUARTInterruptTime = ulGetCriticalSectionTimestamp();
+#endif
 
 	/* What caused the interrupt. */
 	ulStatus = UARTIntStatus( UART0_BASE, pdTRUE );
@@ -594,8 +1002,12 @@ void vUART_ISR(void)
 		/* Read the received character */
         receivedChar = UARTCharGet(UART0_BASE);
 
-        xQueueSendFromISR(xUARTQueue, &receivedChar, NULL);
+        xQueueSendFromISR(xUARTQueue, &receivedChar, &xHigherPriorityTaskWoken);
 	}
+
+	/* Switch to vReceiveCharTask as the interrupt returns, rather than at the next tick, if it
+	preempts the interrupted task. */
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
 }
 
 void vTimer0IntHandler(void){
@@ -0,0 +1,352 @@
+#!/usr/bin/env python3
+#
+# stack_usage.py - Worst case stack use of each task and of the interrupts,
+# worked out when the demo is built rather than by running it.  See the
+# "stack" rule in the Makefile.
+#
+# The stack frame of each function comes from the .su files written by
+# -fstack-usage.  Functions that have no .su entry (the driver library,
+# libgcc and naked functions such as the PendSV handler) are measured from
+# the push/stmdb/sub sp instructions in their disassembly.  The calls between
+# functions are taken from the disassembly of the linked image, so only code
+# that is actually linked is followed, tail calls included.
+#
+# Each task's need is the deepest call chain from its entry function plus
+# what the Cortex-M3 port puts on the task stack when the task is switched
+# out: the exception frame stacked by the hardware (8 words, plus a word of
+# alignment padding) and r4-r11 saved by xPortPendSVHandler (8 words).
+# Interrupts run on the main stack, so their cost is reported against that
+# instead, with --nesting levels of the most expensive handlers stacked on
+# top of each other.
+#
+# The tasks are found in the xTaskCreate() calls of the preprocessed source
+# given on the command line; sizes that are macros (for the idle task, say)
+# are expanded with the #define lines that "gcc -E -dD" leaves in that file.
+# Recursion and calls through function pointers cannot be bounded and are
+# reported.
+#
+# With --measured the high water marks that vTopTask prints over the UART
+# (captured by the "stack-check" rule) are checked against the analysis.  A
+# task that used more of its stack at run time than its worst case means the
+# analysis missed a path, and is reported.
+#
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+WORD = 4
+
+# Stacked by the hardware on exception entry (r0-r3, r12, lr, pc, xPSR),
+# plus the word of padding added when the stack is not 8 byte aligned.
+EXCEPTION_FRAME = 8 * WORD + WORD
+
+# r4-r11, saved on the task stack by xPortPendSVHandler.
+CONTEXT_SAVE = 8 * WORD
+
+FUNCTION_RE = re.compile(r'^([0-9a-f]+) <([^>]+)>:$')
+INSTRUCTION_RE = re.compile(r'^\s*[0-9a-f]+:\s+[0-9a-f ]+\t(\S+)\s*(.*)$')
+TARGET_RE = re.compile(r'^(?:0x)?[0-9a-f]+ <([^>+]+)>')
+# The linker reaches functions out of range of a bl, such as those run from
+# SRAM with make RAMFUNC=1, through a veneer, which branches with a load.
+VENEER_RE = re.compile(r'^__(\w+)_veneer$')
+REGISTER_LIST_RE = re.compile(r'\{([^}]*)\}')
+SUB_SP_RE = re.compile(r'^sp, (?:sp, )?#(\d+)')
+CALL_RE = re.compile(r'xTaskCreate\s*\(\s*(\w+)\s*,\s*"([^"]*)"\s*,\s*([^,]+),')
+DEFINE_RE = re.compile(r'^#define (\w+) (.*)$')
+CAST_RE = re.compile(r'\(\s*(?:unsigned|signed|short|int|long|char|size_t|uint\d+_t|\s)+\)')
+
+
+def read_su_files(directory):
+    # Map each function to the bytes given in the .su files.  Static
+    # functions of the same name in different files keep the largest.
+    frames = {}
+    unbounded = set()
+    for name in sorted(os.listdir(directory)):
+        if not name.endswith('.su'):
+            continue
+        with open(os.path.join(directory, name)) as su:
+            for line in su:
+                fields = line.rstrip('\n').split('\t')
+                if len(fields) != 3:
+                    continue
+                function = fields[0].rsplit(':', 1)[-1]
+                frames[function] = max(frames.get(function, 0), int(fields[1]))
+                if fields[2] == 'dynamic':
+                    unbounded.add(function)
+    return frames, unbounded
+
+
+def register_count(operands):
+    match = REGISTER_LIST_RE.search(operands)
+    if match is None:
+        return 0
+    count = 0
+    for register in match.group(1).split(','):
+        register = register.strip()
+        if '-' in register:
+            first, last = register.split('-')
+            count += int(last.lstrip('rd')) - int(first.lstrip('rd')) + 1
+        elif register:
+            count += 1
+    return count
+
+
+def read_disassembly(objdump, image):
+    # Returns the callees, the indirect calls and the stack adjustment found
+    # in the disassembly of every function.
+    output = subprocess.run([objdump, '-d', image], check=True,
+                            stdout=subprocess.PIPE, universal_newlines=True).stdout
+    calls = {}
+    indirect = set()
+    pushed = {}
+    function = None
+    for line in output.splitlines():
+        match = FUNCTION_RE.match(line)
+        if match is not None:
+            function = match.group(2)
+            calls.setdefault(function, set())
+            pushed.setdefault(function, 0)
+            continue
+        match = INSTRUCTION_RE.match(line)
+        if function is None or match is None:
+            continue
+        mnemonic, operands = match.group(1), match.group(2)
+        if mnemonic in ('push', 'push.w', 'vpush') or (mnemonic in ('stmdb', 'stmdb.w') and operands.startswith('sp!')):
+            pushed[function] += register_count(operands) * (2 * WORD if mnemonic == 'vpush' else WORD)
+        elif mnemonic in ('sub', 'sub.w', 'subw'):
+            match = SUB_SP_RE.match(operands)
+            if match is not None:
+                pushed[function] += int(match.group(1))
+        elif mnemonic == 'blx' and not TARGET_RE.match(operands):
+            indirect.add(function)
+        elif mnemonic.startswith('b') and mnemonic not in ('bx', 'bic', 'bics', 'bfi', 'bfc', 'bkpt'):
+            # bl and blx are calls.  A plain or conditional branch to the
+            # start of another function is a tail call, and to the start of
+            # the same function a loop.
+            match = TARGET_RE.match(operands)
+            if match is not None and (mnemonic in ('bl', 'blx') or match.group(1) != function):
+                target = match.group(1)
+                veneer = VENEER_RE.match(target)
+                calls[function].add(veneer.group(1) if veneer is not None else target)
+    return calls, indirect, pushed
+
+
+def read_symbols(objdump, image):
+    # Map each symbol to its address, size and section, and each function
+    # address to its name.
+    output = subprocess.run([objdump, '-t', image], check=True,
+                            stdout=subprocess.PIPE, universal_newlines=True).stdout
+    symbols = {}
+    functions = {}
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) >= 5 and re.match(r'^[0-9a-f]+$', fields[0]):
+            symbols[fields[-1]] = (int(fields[0], 16), int(fields[-2], 16), fields[-3])
+            if 'F' in fields[1:-3]:
+                functions[int(fields[0], 16) & ~1] = fields[-1]
+    return symbols, functions
+
+
+def read_vectors(objdump, image, symbols, functions, table):
+    # The reset handler and the other handlers in the vector table.  The
+    # first word is the initial stack pointer.
+    if table not in symbols:
+        return None, []
+    start, size, section = symbols[table]
+    dump = subprocess.run([objdump, '-s', '-j', section,
+                           '--start-address=%d' % start, '--stop-address=%d' % (start + size), image],
+                          check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+    # Each line is an address followed by up to 16 bytes in groups of four
+    # and their ASCII.  Not every objdump honours the address range.
+    data = {}
+    for line in dump.splitlines():
+        match = re.match(r'^ ([0-9a-f]+) ((?:[0-9a-f]{2,8} ){1,4})', line + ' ')
+        if match is not None:
+            address = int(match.group(1), 16)
+            for value in bytes.fromhex(match.group(2).replace(' ', '')):
+                data[address] = value
+                address += 1
+    handlers = []
+    for offset in range(start + WORD, start + size, WORD):
+        address = int.from_bytes(bytes(data.get(offset + i, 0) for i in range(WORD)), 'little') & ~1
+        handlers.append(functions.get(address))
+    reset = handlers.pop(0) if handlers else None
+    return reset, [handler for index, handler in enumerate(handlers)
+                   if handler is not None and handler not in handlers[:index]]
+
+
+def evaluate(expression, macros, depth=0):
+    # Expand object-like macros, drop casts and integer suffixes, then
+    # evaluate what is left if it is plain arithmetic.
+    if depth > 16:
+        return None
+    expanded = re.sub(r'\b[A-Za-z_]\w*\b',
+                      lambda match: '(%s)' % macros[match.group(0)] if match.group(0) in macros else match.group(0),
+                      expression)
+    if expanded != expression:
+        return evaluate(expanded, macros, depth + 1)
+    expression = CAST_RE.sub('', expression)
+    expression = re.sub(r'\b(\d+)[uUlL]+\b', r'\1', expression)
+    if not re.match(r'^[\d\s()+\-*/]+$', expression):
+        return None
+    return int(eval(expression.replace('/', '//')))
+
+
+def read_measured(log):
+    # The lowest high water mark (free words) printed for each task in the
+    # "TASK CPU% STACK FREE TICKS" tables of vTopTask.
+    free = {}
+    with open(log, errors='replace') as output:
+        for line in output:
+            fields = line.replace('\r', '').replace('\0', '').rstrip('\n').split('\t')
+            fields = [field for field in fields if field]
+            if len(fields) != 4 or not fields[1].endswith('%') or not fields[2].isdigit():
+                continue
+            free[fields[0]] = min(free.get(fields[0], int(fields[2])), int(fields[2]))
+    return free
+
+
+def read_tasks(source):
+    # (name, entry function, size expression) for every xTaskCreate() in the
+    # preprocessed source, and the macros it defines.
+    macros = {}
+    text = []
+    with open(source) as preprocessed:
+        for line in preprocessed:
+            match = DEFINE_RE.match(line)
+            if match is not None:
+                macros[match.group(1)] = match.group(2)
+            elif not line.startswith('#'):
+                text.append(line)
+    tasks = [(name, entry, size.strip()) for entry, name, size in CALL_RE.findall(' '.join(text))]
+    return tasks, macros
+
+
+class Graph:
+    def __init__(self, frames, unbounded, calls, indirect, pushed):
+        self.frames = frames
+        self.unbounded = unbounded
+        self.calls = calls
+        self.indirect = indirect
+        self.pushed = pushed
+        self.worst = {}
+        self.problems = set()
+
+    def frame(self, function):
+        # Naked functions have a zero .su entry, so use the disassembly then.
+        if self.frames.get(function, 0) > 0:
+            return self.frames[function]
+        return self.pushed.get(function, 0)
+
+    def deepest(self, function, active=()):
+        # The bytes used by the deepest call chain from function, and the
+        # chain itself.
+        if function in self.worst:
+            return self.worst[function]
+        if function in active:
+            self.problems.add('recursion through %s' % function)
+            return 0, [function]
+        if function in self.unbounded:
+            self.problems.add('%s uses a dynamically sized stack frame' % function)
+        if function in self.indirect:
+            self.problems.add('%s calls through a function pointer' % function)
+        best, chain = 0, []
+        for callee in sorted(self.calls.get(function, ())):
+            used, callee_chain = self.deepest(callee, active + (function,))
+            if used > best:
+                best, chain = used, callee_chain
+        result = (self.frame(function) + best, [function] + chain)
+        self.worst[function] = result
+        return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Worst case stack use of the tasks and interrupts of a linked image.')
+    parser.add_argument('image', help='the linked image (.axf)')
+    parser.add_argument('source', help='preprocessed source (gcc -E -dD) containing the xTaskCreate() calls')
+    parser.add_argument('--objdump', default='arm-none-eabi-objdump')
+    parser.add_argument('--su-dir', required=True, help='directory holding the .su files')
+    parser.add_argument('--task', action='append', default=[], metavar='NAME:ENTRY:SIZE',
+                        help='a task that is not created in the source, such as the idle task')
+    parser.add_argument('--isr', action='append', default=[], metavar='HANDLER',
+                        help='a handler installed at run time rather than in the vector table')
+    parser.add_argument('--vectors', default='g_pfnVectors', help='the vector table symbol')
+    parser.add_argument('--nesting', type=int, default=1,
+                        help='the number of interrupt priority levels that can preempt each other')
+    parser.add_argument('--guard', type=int, default=0,
+                        help='bytes at the end of each stack that must stay unused (the overflow check pattern)')
+    parser.add_argument('--main-stack', default='pulStack', help='the array that is the main stack')
+    parser.add_argument('--spare', type=int, default=100,
+                        help='warn when a task has more than this percentage of its need to spare')
+    parser.add_argument('--measured', metavar='LOG',
+                        help='UART output of vTopTask, to check the high water marks against the analysis')
+    arguments = parser.parse_args()
+
+    frames, unbounded = read_su_files(arguments.su_dir)
+    calls, indirect, pushed = read_disassembly(arguments.objdump, arguments.image)
+    graph = Graph(frames, unbounded, calls, indirect, pushed)
+    tasks, macros = read_tasks(arguments.source)
+    tasks += [tuple(task.split(':', 2)) for task in arguments.task]
+    measured = read_measured(arguments.measured) if arguments.measured else {}
+    warnings = []
+
+    print('%-10s %-28s %7s %7s %7s %7s  %s' % ('Task', 'Entry', 'Needs', 'Size', 'Spare', 'Used', 'Deepest chain'))
+    for name, entry, size in tasks:
+        if entry not in calls:
+            # Not in the image, so the task is never created.
+            continue
+        used, chain = graph.deepest(entry)
+        needed = (used + EXCEPTION_FRAME + CONTEXT_SAVE + arguments.guard + WORD - 1) // WORD
+        words = evaluate(size, macros)
+        if words is None:
+            warnings.append('%s: cannot evaluate the stack size %s' % (name, size))
+            words = 0
+        spare = words - needed
+        # The task names printed by vTopTask are cut to configMAX_TASK_NAME_LEN.
+        printed = [task for task in measured if name.startswith(task)]
+        run_time = words - measured[max(printed, key=len)] if printed else None
+        print('%-10s %-28s %7d %7d %7d %7s  %s' % (name, entry, needed, words, spare,
+                                                 run_time if run_time is not None else '', ' > '.join(chain)))
+        if run_time is not None and run_time > needed:
+            warnings.append('%s: %d words were used at run time but the analysis allows %d' % (name, run_time, needed))
+        elif arguments.measured and run_time is None:
+            warnings.append('%s: no high water mark in %s' % (name, arguments.measured))
+        if spare < 0:
+            warnings.append('%s: the stack is %d words but up to %d can be used' % (name, words, needed))
+        elif spare * 100 > needed * arguments.spare:
+            warnings.append('%s: the stack is %d words but no more than %d are used' % (name, words, needed))
+
+    symbols, functions = read_symbols(arguments.objdump, arguments.image)
+    reset, handlers = read_vectors(arguments.objdump, arguments.image, symbols, functions, arguments.vectors)
+    handlers += [isr for isr in arguments.isr if isr in calls and isr not in handlers]
+    costs = []
+    for handler in handlers:
+        used, chain = graph.deepest(handler)
+        costs.append((used + EXCEPTION_FRAME, handler, chain))
+    costs.sort(reverse=True)
+    for used, handler, chain in costs:
+        print('%-10s %-28s %7d %7s %7s %7s  %s' % ('(isr)', handler, (used + WORD - 1) // WORD, '', '', '', ' > '.join(chain)))
+
+    # Before the scheduler starts main() runs on the main stack, which is
+    # then reset and used only by interrupts.
+    interrupts = sum(cost[0] for cost in costs[:arguments.nesting])
+    startup = graph.deepest(reset)[0] if reset is not None else 0
+    needed = (max(interrupts, startup) + WORD - 1) // WORD
+    words = symbols[arguments.main_stack][1] // WORD if arguments.main_stack in symbols else 0
+    print('%-10s %-28s %7d %7s %7s' % ('(main)', '%d nested interrupts' % arguments.nesting, needed,
+                                       words if words else '', words - needed if words else ''))
+    if words and needed > words:
+        warnings.append('the main stack is %d words but up to %d can be used' % (words, needed))
+
+    for problem in sorted(graph.problems):
+        warnings.append('not bounded: %s' % problem)
+    for warning in warnings:
+        print('warning: %s' % warning)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,50 @@
+/*
+ * FreeRTOS configuration for the host benchmarks in this directory that run
+ * the stack under the Posix port (see the Makefile).  The run time stats are
+ * clocked by perf_timestamp(), so the time each task spends running is in the
+ * same units as the LWIP_PERF measurements.
+ */
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#define configUSE_PREEMPTION			1
+#define configUSE_IDLE_HOOK				0
+#define configUSE_TICK_HOOK				0
+#define configTICK_RATE_HZ				( ( TickType_t ) 1000 )
+/* Each task is a thread with its FreeRTOS stack as its pthread stack, which
+must be at least PTHREAD_STACK_MIN bytes. */
+#define configMINIMAL_STACK_SIZE		( ( unsigned short ) 4096 )
+#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 256 * 1024 ) )
+#define configMAX_TASK_NAME_LEN			( 16 )
+#define configUSE_TRACE_FACILITY		1
+#define configUSE_16_BIT_TICKS			0
+#define configIDLE_SHOULD_YIELD			1
+#define configMAX_PRIORITIES			( 5 )
+#define configCHECK_FOR_STACK_OVERFLOW	0
+#define configSUPPORT_DYNAMIC_ALLOCATION	1
+#define configUSE_MUTEXES				1
+#define configUSE_COUNTING_SEMAPHORES	1
+#define configUSE_TIMERS				1
+#define configTIMER_TASK_PRIORITY		3
+#define configTIMER_QUEUE_LENGTH		10
+#define configTIMER_TASK_STACK_DEPTH	configMINIMAL_STACK_SIZE
+
+/* Run time stats in perf_timestamp() units.  The counter is 64 bits wide as a
+cycle counter wraps 32 bits in about a second.  The ALT form is used because
+the Posix portmacro.h defines portGET_RUN_TIME_COUNTER_VALUE() itself, to
+return the process CPU time in clock ticks. */
+#define configGENERATE_RUN_TIME_STATS	1
+#define configRUN_TIME_COUNTER_TYPE		unsigned long long
+unsigned long long perf_timestamp( void );
+#define portALT_GET_RUN_TIME_COUNTER_VALUE( ullValue )	( ullValue ) = perf_timestamp()
+
+#define INCLUDE_vTaskDelete				1
+#define INCLUDE_vTaskDelay				1
+#define INCLUDE_vTaskSuspend			1
+#define INCLUDE_xTaskGetIdleTaskHandle	1
+#define INCLUDE_xTaskGetSchedulerState	1
+
+void vAssertCalled( const char *pcFile, unsigned long ulLine );
+#define configASSERT( x ) if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ )
+
+#endif /* FREERTOS_CONFIG_H */
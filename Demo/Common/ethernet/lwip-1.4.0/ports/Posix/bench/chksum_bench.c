@@ -0,0 +1,178 @@
+/*
+ * Measures the Internet checksum routine selected by LWIP_CHKSUM_ALGORITHM
+ * and the checksum copy selected by LWIP_CHKSUM_COPY_ALGORITHM, after first
+ * checking both against a byte-at-a-time reference.  The Makefile builds one
+ * executable per algorithm; "make chksum" runs them all.
+ *
+ * Results are in nanoseconds per call and bytes per nanosecond for the
+ * lengths that dominate TCP: a 20 byte header, a 536 byte default MSS and a
+ * 1460 byte Ethernet MSS, at each alignment modulo 4.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lwip/opt.h"
+#include "lwip/inet_chksum.h"
+
+#define benchBUFFER_SIZE		2048
+#define benchCHECK_ITERATIONS	20000
+#define benchTARGET_BYTES		400000000UL
+
+static unsigned char ucSource[ benchBUFFER_SIZE + 8 ] __attribute__( ( aligned( 8 ) ) );
+static unsigned char ucDestination[ benchBUFFER_SIZE + 8 ] __attribute__( ( aligned( 8 ) ) );
+
+/* Stops the compiler discarding the results. */
+static volatile u16_t usSink;
+
+/*-----------------------------------------------------------*/
+
+static u16_t prvReferenceChecksum( const unsigned char *pucData, int iLength )
+{
+u32_t ulSum = 0;
+int i;
+
+	for( i = 0; i + 1 < iLength; i += 2 )
+	{
+		ulSum += ( ( u32_t ) pucData[ i ] << 8 ) | pucData[ i + 1 ];
+	}
+
+	if( ( iLength & 1 ) != 0 )
+	{
+		ulSum += ( u32_t ) pucData[ iLength - 1 ] << 8;
+	}
+
+	while( ( ulSum >> 16 ) != 0 )
+	{
+		ulSum = ( ulSum & 0xffffUL ) + ( ulSum >> 16 );
+	}
+
+	/* inet_chksum() returns the complement in network order. */
+	return ( u16_t ) ~htons( ( u16_t ) ulSum );
+}
+/*-----------------------------------------------------------*/
+
+static double prvNow( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( double ) xNow.tv_sec * 1e9 + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static int prvCheck( void )
+{
+int i, j, iOffset, iDestinationOffset, iLength;
+u16_t usExpected;
+int iErrors = 0;
+
+	srand( 1 );
+
+	for( i = 0; i < benchCHECK_ITERATIONS; i++ )
+	{
+		iOffset = rand() & 7;
+		iDestinationOffset = ( ( i & 1 ) != 0 ) ? iOffset : ( rand() & 7 );
+		iLength = rand() % ( benchBUFFER_SIZE - 8 );
+
+		if( ( i & 0xff ) == 0 )
+		{
+			/* Mostly 0xff bytes, to exercise the carries. */
+			memset( ucSource, 0xff, sizeof( ucSource ) );
+		}
+		else
+		{
+			for( j = 0; j < ( int ) sizeof( ucSource ); j++ )
+			{
+				ucSource[ j ] = ( unsigned char ) rand();
+			}
+		}
+
+		usExpected = prvReferenceChecksum( &ucSource[ iOffset ], iLength );
+
+		if( inet_chksum( &ucSource[ iOffset ], ( u16_t ) iLength ) != usExpected )
+		{
+			printf( "inet_chksum mismatch: offset %d length %d\n", iOffset, iLength );
+			iErrors++;
+		}
+
+		#if LWIP_CHECKSUM_ON_COPY
+		{
+			memset( ucDestination, 0, sizeof( ucDestination ) );
+
+			if( ( u16_t ) ~LWIP_CHKSUM_COPY( &ucDestination[ iDestinationOffset ], &ucSource[ iOffset ], ( u16_t ) iLength ) != usExpected )
+			{
+				printf( "LWIP_CHKSUM_COPY mismatch: offsets %d/%d length %d\n", iDestinationOffset, iOffset, iLength );
+				iErrors++;
+			}
+
+			if( memcmp( &ucDestination[ iDestinationOffset ], &ucSource[ iOffset ], ( size_t ) iLength ) != 0 )
+			{
+				printf( "LWIP_CHKSUM_COPY bad copy: offsets %d/%d length %d\n", iDestinationOffset, iOffset, iLength );
+				iErrors++;
+			}
+		}
+		#endif /* LWIP_CHECKSUM_ON_COPY */
+	}
+
+	return iErrors;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasure( int iLength, int iOffset )
+{
+unsigned long ulIterations = benchTARGET_BYTES / ( unsigned long ) iLength, i;
+double dStart, dElapsed;
+
+	dStart = prvNow();
+
+	for( i = 0; i < ulIterations; i++ )
+	{
+		usSink = inet_chksum( &ucSource[ iOffset ], ( u16_t ) iLength );
+	}
+
+	dElapsed = prvNow() - dStart;
+	printf( "chksum  %5d  %d  %8.1f ns  %6.2f B/ns\n", iLength, iOffset,
+			dElapsed / ( double ) ulIterations, ( ( double ) ulIterations * ( double ) iLength ) / dElapsed );
+
+	#if LWIP_CHECKSUM_ON_COPY
+	{
+		dStart = prvNow();
+
+		for( i = 0; i < ulIterations; i++ )
+		{
+			usSink = LWIP_CHKSUM_COPY( &ucDestination[ iOffset ], &ucSource[ iOffset ], ( u16_t ) iLength );
+		}
+
+		dElapsed = prvNow() - dStart;
+		printf( "copy    %5d  %d  %8.1f ns  %6.2f B/ns\n", iLength, iOffset,
+				dElapsed / ( double ) ulIterations, ( ( double ) ulIterations * ( double ) iLength ) / dElapsed );
+	}
+	#endif /* LWIP_CHECKSUM_ON_COPY */
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+const int iLengths[] = { 20, 536, 1460 };
+int iLength, iOffset;
+
+	if( prvCheck() != 0 )
+	{
+		return 1;
+	}
+
+	printf( "LWIP_CHKSUM_ALGORITHM %d, LWIP_CHKSUM_COPY_ALGORITHM %d\n", LWIP_CHKSUM_ALGORITHM, LWIP_CHKSUM_COPY_ALGORITHM );
+
+	for( iLength = 0; iLength < ( int ) ( sizeof( iLengths ) / sizeof( iLengths[ 0 ] ) ); iLength++ )
+	{
+		for( iOffset = 0; iOffset < 4; iOffset++ )
+		{
+			prvMeasure( iLengths[ iLength ], iOffset );
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * lwIP options for the host benchmarks in this directory.  Each benchmark is
+ * built with -D options that select what it measures (see the Makefile), so
+ * the options here only set what all of them share, plus the configuration
+ * of the whole stack that STACK_BENCH selects.
+ */
+#ifndef __LWIPOPTS_H__
+#define __LWIPOPTS_H__
+
+/* The checksum copy is only compiled when checksum on copy is enabled. */
+#ifndef LWIP_CHECKSUM_ON_COPY
+	#define LWIP_CHECKSUM_ON_COPY		1
+#endif
+
+#define MEM_ALIGNMENT					8
+#define LWIP_TIMEVAL_PRIVATE			0
+
+/* The whole stack, as built for stack_bench.c.  Each option can be
+overridden from the command line, for example
+make stack STACK_BENCH_FLAGS="-DTCP_MSS=536". */
+#ifdef STACK_BENCH
+
+	#define SYS_LIGHTWEIGHT_PROT		1
+	#define LWIP_NETIF_API				1
+	#define LWIP_COMPAT_SOCKETS			0
+	#define ERRNO						1
+
+	/* Every measurement the stack can make. */
+	#define LWIP_STATS					1
+	#define LWIP_PERF					1
+
+	#ifndef MEM_SIZE
+		#define MEM_SIZE				( 256 * 1024 )
+	#endif
+	#ifndef MEMP_NUM_PBUF
+		#define MEMP_NUM_PBUF			64
+	#endif
+	#ifndef MEMP_NUM_TCP_PCB
+		#define MEMP_NUM_TCP_PCB		16
+	#endif
+	#ifndef MEMP_NUM_TCP_SEG
+		#define MEMP_NUM_TCP_SEG		128
+	#endif
+	#ifndef MEMP_NUM_NETBUF
+		#define MEMP_NUM_NETBUF			32
+	#endif
+	#ifndef MEMP_NUM_NETCONN
+		#define MEMP_NUM_NETCONN		16
+	#endif
+	#ifndef MEMP_NUM_TCPIP_MSG_INPKT
+		#define MEMP_NUM_TCPIP_MSG_INPKT	64
+	#endif
+	#ifndef PBUF_POOL_SIZE
+		#define PBUF_POOL_SIZE			256
+	#endif
+	#ifndef TCP_MSS
+		#define TCP_MSS					1460
+	#endif
+	#ifndef TCP_WND
+		#define TCP_WND					( 16 * TCP_MSS )
+	#endif
+	#ifndef TCP_SND_BUF
+		#define TCP_SND_BUF				( 16 * TCP_MSS )
+	#endif
+	#ifndef TCP_SND_QUEUELEN
+		#define TCP_SND_QUEUELEN		64
+	#endif
+
+	#define TCPIP_MBOX_SIZE				128
+	#define DEFAULT_TCP_RECVMBOX_SIZE	64
+	#define DEFAULT_UDP_RECVMBOX_SIZE	64
+	#define DEFAULT_ACCEPTMBOX_SIZE		8
+	#define TCPIP_THREAD_PRIO			3
+	#define TCPIP_THREAD_STACKSIZE		configMINIMAL_STACK_SIZE
+
+#endif /* STACK_BENCH */
+
+#endif /* __LWIPOPTS_H__ */
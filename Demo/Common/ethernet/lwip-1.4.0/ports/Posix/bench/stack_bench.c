@@ -0,0 +1,563 @@
+/*
+ * Runs the whole stack - sockets API, tcpip thread, TCP, UDP, IP, ARP and
+ * Ethernet - under the FreeRTOS Posix port, between two pcapif interfaces
+ * that pass each transmitted frame straight to the other.  No network, pcap
+ * library or privileges are needed.  "make stack" builds and runs it.
+ *
+ * Three workloads are run in turn, each by a client task on 10.0.0.1 against
+ * a server task on 10.0.0.2:
+ *
+ *   tcp bulk   one connection carries benchTCP_BYTES to the server.
+ *   udp rr     benchUDP_TRANSACTIONS request/response exchanges, each
+ *              timed individually.
+ *   tcp churn  benchCHURN_CONNECTIONS connections, each of which opens,
+ *              exchanges one small request and response, and closes.
+ *
+ * After each workload the following are printed:
+ *
+ *   - the throughput, transaction rate or connection rate;
+ *   - the Ethernet frames sent and the cycles per frame spent in the tcpip
+ *     thread, and in all tasks together (FreeRTOS run time stats, see
+ *     FreeRTOSConfig.h);
+ *   - the LWIP_PERF section times (perf_report());
+ *   - the mem heap and every memp pool that was used, with its high water
+ *     mark, the number of allocations and the number of failed allocations.
+ *     The allocations are counted by wrapping mem_malloc() and memp_malloc()
+ *     at link time (see the Makefile), the rest comes from lwip_stats.
+ *
+ * Cycles are perf_timestamp() units: CPU cycles where the cycle counter can
+ * be read from user space, nanoseconds otherwise.  As every task is a host
+ * thread the absolute figures include the simulator's scheduling overhead,
+ * so compare runs of the same build on the same machine, for example with
+ * and without an option under test.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "lwip/opt.h"
+#include "lwip/tcpip.h"
+#include "lwip/sockets.h"
+#include "lwip/stats.h"
+#include "lwip/memp.h"
+#include "lwip/mem.h"
+#include "arch/perf.h"
+#include "netif/pcapif.h"
+
+#ifndef benchTCP_BYTES
+	#define benchTCP_BYTES			( 16UL * 1024UL * 1024UL )
+#endif
+
+#ifndef benchTCP_CHUNK
+	#define benchTCP_CHUNK			8192
+#endif
+
+#ifndef benchUDP_TRANSACTIONS
+	#define benchUDP_TRANSACTIONS	20000
+#endif
+
+#ifndef benchCHURN_CONNECTIONS
+	#define benchCHURN_CONNECTIONS	2000
+#endif
+
+/* The size of the UDP and connection churn requests and responses. */
+#define benchREQUEST_SIZE		64
+
+#define benchTCP_PORT			5001
+#define benchUDP_PORT			5002
+#define benchCHURN_PORT			5003
+
+#define benchTASK_PRIORITY		( tskIDLE_PRIORITY + 2 )
+#define benchTASK_STACK_SIZE	configMINIMAL_STACK_SIZE
+#define benchMAX_TASKS			16
+
+typedef struct xBENCH_SAMPLE
+{
+	double dTime;
+	unsigned long long ullTcpip;
+	unsigned long long ullBusy;
+	unsigned long ulFrames;
+	unsigned long ulMemAllocs;
+	unsigned long ulMempAllocs[ MEMP_MAX ];
+} xBenchSample;
+
+static struct netif xClientNetIf, xServerNetIf;
+static struct xPcapIf xClientPcapIf = { NULL, NULL, &xServerNetIf };
+static struct xPcapIf xServerPcapIf = { NULL, NULL, &xClientNetIf };
+
+/* The pool names, in memp_t order. */
+static const char * const pcMempNames[ MEMP_MAX ] =
+{
+	#define LWIP_MEMPOOL( name, num, size, desc ) desc,
+	#include "lwip/memp_std.h"
+};
+
+/* Incremented by the wrappers below, from whichever task allocates. */
+static volatile unsigned long ulMemAllocs;
+static volatile unsigned long ulMempAllocs[ MEMP_MAX ];
+
+/* The task that runs the workloads, notified when a server task finishes. */
+static TaskHandle_t xBenchTask;
+
+static unsigned char ucBuffer[ benchTCP_CHUNK ];
+static unsigned char ucServerBuffer[ benchTCP_CHUNK ];
+
+/*-----------------------------------------------------------*/
+
+void *__real_mem_malloc( mem_size_t xSize );
+void *__real_memp_malloc( memp_t xType );
+
+void *__wrap_mem_malloc( mem_size_t xSize )
+{
+	__atomic_fetch_add( &ulMemAllocs, 1UL, __ATOMIC_RELAXED );
+	return __real_mem_malloc( xSize );
+}
+/*-----------------------------------------------------------*/
+
+void *__wrap_memp_malloc( memp_t xType )
+{
+	if( xType < MEMP_MAX )
+	{
+		__atomic_fetch_add( &ulMempAllocs[ xType ], 1UL, __ATOMIC_RELAXED );
+	}
+
+	return __real_memp_malloc( xType );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFail( const char *pcWhat )
+{
+	printf( "%s failed, errno %d\n", pcWhat, errno );
+	exit( 1 );
+}
+/*-----------------------------------------------------------*/
+
+static double prvNow( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( double ) xNow.tv_sec + ( double ) xNow.tv_nsec * 1e-9;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetAddress( struct sockaddr_in *pxAddress, const char *pcAddress, u16_t usPort )
+{
+	memset( pxAddress, 0, sizeof( *pxAddress ) );
+	pxAddress->sin_len = sizeof( *pxAddress );
+	pxAddress->sin_family = AF_INET;
+	pxAddress->sin_port = htons( usPort );
+	pxAddress->sin_addr.s_addr = inet_addr( pcAddress );
+}
+/*-----------------------------------------------------------*/
+
+static int prvListen( int iType, u16_t usPort )
+{
+struct sockaddr_in xAddress;
+int iSocket;
+
+	iSocket = lwip_socket( AF_INET, iType, 0 );
+	prvSetAddress( &xAddress, "10.0.0.2", usPort );
+
+	if( ( iSocket < 0 ) || ( lwip_bind( iSocket, ( struct sockaddr * ) &xAddress, sizeof( xAddress ) ) != 0 ) )
+	{
+		prvFail( "bind" );
+	}
+
+	if( ( iType == SOCK_STREAM ) && ( lwip_listen( iSocket, DEFAULT_ACCEPTMBOX_SIZE ) != 0 ) )
+	{
+		prvFail( "listen" );
+	}
+
+	return iSocket;
+}
+/*-----------------------------------------------------------*/
+
+static int prvConnect( int iType, u16_t usPort )
+{
+struct sockaddr_in xAddress;
+int iSocket;
+
+	iSocket = lwip_socket( AF_INET, iType, 0 );
+	prvSetAddress( &xAddress, "10.0.0.2", usPort );
+
+	if( ( iSocket < 0 ) || ( lwip_connect( iSocket, ( struct sockaddr * ) &xAddress, sizeof( xAddress ) ) != 0 ) )
+	{
+		prvFail( "connect" );
+	}
+
+	return iSocket;
+}
+/*-----------------------------------------------------------*/
+
+/* Receive exactly iLength bytes from a stream socket. */
+static void prvReceiveAll( int iSocket, unsigned char *pucBuffer, int iLength )
+{
+int iReceived;
+
+	while( iLength > 0 )
+	{
+		iReceived = lwip_recv( iSocket, pucBuffer, ( size_t ) iLength, 0 );
+
+		if( iReceived <= 0 )
+		{
+			prvFail( "recv" );
+		}
+
+		pucBuffer += iReceived;
+		iLength -= iReceived;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSample( xBenchSample *pxSample )
+{
+TaskStatus_t xStatus[ benchMAX_TASKS ];
+configRUN_TIME_COUNTER_TYPE ullTotal;
+UBaseType_t uxTasks, x;
+int i;
+
+	/* lwip_stats.link.xmit is only 16 bits wide, so the frames are counted by
+	the interfaces. */
+	pxSample->dTime = prvNow();
+	pxSample->ulFrames = xClientPcapIf.ulTransmitted + xServerPcapIf.ulTransmitted;
+	pxSample->ulMemAllocs = ulMemAllocs;
+
+	for( i = 0; i < MEMP_MAX; i++ )
+	{
+		pxSample->ulMempAllocs[ i ] = ulMempAllocs[ i ];
+	}
+
+	/* The time spent by the task calling this is only added to its counter
+	when it is switched out, which makes no difference over a workload. */
+	uxTasks = uxTaskGetSystemState( xStatus, benchMAX_TASKS, &ullTotal );
+	pxSample->ullBusy = ullTotal - ulTaskGetIdleRunTimeCounter();
+	pxSample->ullTcpip = 0;
+
+	for( x = 0; x < uxTasks; x++ )
+	{
+		if( strcmp( xStatus[ x ].pcTaskName, TCPIP_THREAD_NAME ) == 0 )
+		{
+			pxSample->ullTcpip = xStatus[ x ].ulRunTimeCounter;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* Start the high water marks and the LWIP_PERF measurements afresh, then
+take the sample the end of the workload is compared against.  Called while
+the stack is idle between workloads. */
+static void prvBegin( xBenchSample *pxStart )
+{
+SYS_ARCH_DECL_PROTECT( xLevel );
+int i;
+
+	SYS_ARCH_PROTECT( xLevel );
+	{
+		lwip_stats.mem.max = lwip_stats.mem.used;
+		lwip_stats.mem.err = 0;
+
+		for( i = 0; i < MEMP_MAX; i++ )
+		{
+			lwip_stats.memp[ i ].max = lwip_stats.memp[ i ].used;
+			lwip_stats.memp[ i ].err = 0;
+		}
+	}
+	SYS_ARCH_UNPROTECT( xLevel );
+
+	perf_reset();
+	prvSample( pxStart );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEnd( const xBenchSample *pxStart )
+{
+xBenchSample xEnd;
+unsigned long ulFrames, ulAllocs;
+int i;
+
+	prvSample( &xEnd );
+	ulFrames = xEnd.ulFrames - pxStart->ulFrames;
+
+	if( ulFrames == 0 )
+	{
+		ulFrames = 1;
+	}
+
+	printf( "  frames %lu, %llu cycles/frame in the tcpip thread, %llu cycles/frame in all tasks\n",
+			xEnd.ulFrames - pxStart->ulFrames,
+			( xEnd.ullTcpip - pxStart->ullTcpip ) / ulFrames,
+			( xEnd.ullBusy - pxStart->ullBusy ) / ulFrames );
+
+	perf_report();
+
+	printf( "  %-16s max %7lu of %7lu  allocations %8lu  failures %lu\n", "mem",
+			( unsigned long ) lwip_stats.mem.max, ( unsigned long ) lwip_stats.mem.avail,
+			xEnd.ulMemAllocs - pxStart->ulMemAllocs, ( unsigned long ) lwip_stats.mem.err );
+
+	for( i = 0; i < MEMP_MAX; i++ )
+	{
+		ulAllocs = xEnd.ulMempAllocs[ i ] - pxStart->ulMempAllocs[ i ];
+
+		if( ( ulAllocs != 0 ) || ( lwip_stats.memp[ i ].err != 0 ) )
+		{
+			printf( "  %-16s max %7lu of %7lu  allocations %8lu  failures %lu\n", pcMempNames[ i ],
+					( unsigned long ) lwip_stats.memp[ i ].max, ( unsigned long ) lwip_stats.memp[ i ].avail,
+					ulAllocs, ( unsigned long ) lwip_stats.memp[ i ].err );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTcpBulkServer( void *pvParameters )
+{
+unsigned long ulTotal = 0;
+int iListener = ( int ) ( intptr_t ) pvParameters, iSocket, iReceived;
+
+	iSocket = lwip_accept( iListener, NULL, NULL );
+
+	if( iSocket < 0 )
+	{
+		prvFail( "accept" );
+	}
+
+	while( ( iReceived = lwip_recv( iSocket, ucServerBuffer, sizeof( ucServerBuffer ), 0 ) ) > 0 )
+	{
+		ulTotal += ( unsigned long ) iReceived;
+	}
+
+	if( ulTotal != benchTCP_BYTES )
+	{
+		printf( "tcp bulk: received %lu of %lu bytes\n", ulTotal, benchTCP_BYTES );
+		exit( 1 );
+	}
+
+	lwip_close( iSocket );
+	xTaskNotifyGive( xBenchTask );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTcpBulk( void )
+{
+xBenchSample xStart;
+unsigned long ulSent;
+int iListener, iSocket, iLength;
+double dElapsed;
+
+	iListener = prvListen( SOCK_STREAM, benchTCP_PORT );
+	xTaskCreate( prvTcpBulkServer, "TcpBulk", benchTASK_STACK_SIZE, ( void * ) ( intptr_t ) iListener, benchTASK_PRIORITY, NULL );
+
+	prvBegin( &xStart );
+	iSocket = prvConnect( SOCK_STREAM, benchTCP_PORT );
+
+	for( ulSent = 0; ulSent < benchTCP_BYTES; ulSent += ( unsigned long ) iLength )
+	{
+		iLength = ( int ) ( ( ( benchTCP_BYTES - ulSent ) < sizeof( ucBuffer ) ) ? ( benchTCP_BYTES - ulSent ) : sizeof( ucBuffer ) );
+
+		if( lwip_send( iSocket, ucBuffer, ( size_t ) iLength, 0 ) != iLength )
+		{
+			prvFail( "send" );
+		}
+	}
+
+	lwip_close( iSocket );
+	ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	dElapsed = prvNow() - xStart.dTime;
+
+	printf( "tcp bulk: %lu bytes in %.3f s, %.1f Mbit/s\n", benchTCP_BYTES, dElapsed,
+			( ( double ) benchTCP_BYTES * 8.0 ) / ( dElapsed * 1e6 ) );
+	prvEnd( &xStart );
+
+	lwip_close( iListener );
+}
+/*-----------------------------------------------------------*/
+
+static void prvUdpServer( void *pvParameters )
+{
+struct sockaddr_in xFrom;
+socklen_t xFromLength;
+int iSocket = ( int ) ( intptr_t ) pvParameters, iReceived;
+
+	for( ;; )
+	{
+		xFromLength = sizeof( xFrom );
+		iReceived = lwip_recvfrom( iSocket, ucServerBuffer, sizeof( ucServerBuffer ), 0, ( struct sockaddr * ) &xFrom, &xFromLength );
+
+		if( iReceived < 0 )
+		{
+			prvFail( "recvfrom" );
+		}
+
+		/* A one byte datagram ends the workload. */
+		if( iReceived == 1 )
+		{
+			break;
+		}
+
+		if( lwip_sendto( iSocket, ucServerBuffer, ( size_t ) iReceived, 0, ( struct sockaddr * ) &xFrom, xFromLength ) != iReceived )
+		{
+			prvFail( "sendto" );
+		}
+	}
+
+	xTaskNotifyGive( xBenchTask );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvUdpRequestResponse( void )
+{
+xBenchSample xStart;
+unsigned long long ullSent, ullLatency, ullTotal = 0, ullMin = ~0ULL, ullMax = 0;
+int iServer, iSocket, i;
+double dElapsed;
+
+	iServer = prvListen( SOCK_DGRAM, benchUDP_PORT );
+	xTaskCreate( prvUdpServer, "UdpServer", benchTASK_STACK_SIZE, ( void * ) ( intptr_t ) iServer, benchTASK_PRIORITY, NULL );
+
+	prvBegin( &xStart );
+	iSocket = prvConnect( SOCK_DGRAM, benchUDP_PORT );
+
+	for( i = 0; i < benchUDP_TRANSACTIONS; i++ )
+	{
+		ullSent = perf_timestamp();
+
+		if( ( lwip_send( iSocket, ucBuffer, benchREQUEST_SIZE, 0 ) != benchREQUEST_SIZE ) ||
+			( lwip_recv( iSocket, ucBuffer, sizeof( ucBuffer ), 0 ) != benchREQUEST_SIZE ) )
+		{
+			prvFail( "udp request" );
+		}
+
+		ullLatency = perf_timestamp() - ullSent;
+		ullTotal += ullLatency;
+		ullMin = ( ullLatency < ullMin ) ? ullLatency : ullMin;
+		ullMax = ( ullLatency > ullMax ) ? ullLatency : ullMax;
+	}
+
+	lwip_send( iSocket, ucBuffer, 1, 0 );
+	ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	dElapsed = prvNow() - xStart.dTime;
+
+	printf( "udp rr: %d transactions in %.3f s, %.0f/s, latency mean %llu min %llu max %llu cycles\n",
+			benchUDP_TRANSACTIONS, dElapsed, ( double ) benchUDP_TRANSACTIONS / dElapsed,
+			ullTotal / benchUDP_TRANSACTIONS, ullMin, ullMax );
+	prvEnd( &xStart );
+
+	lwip_close( iSocket );
+	lwip_close( iServer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvChurnServer( void *pvParameters )
+{
+int iListener = ( int ) ( intptr_t ) pvParameters, iSocket, i;
+
+	for( i = 0; i < benchCHURN_CONNECTIONS; i++ )
+	{
+		iSocket = lwip_accept( iListener, NULL, NULL );
+
+		if( iSocket < 0 )
+		{
+			prvFail( "accept" );
+		}
+
+		prvReceiveAll( iSocket, ucServerBuffer, benchREQUEST_SIZE );
+
+		if( lwip_send( iSocket, ucServerBuffer, benchREQUEST_SIZE, 0 ) != benchREQUEST_SIZE )
+		{
+			prvFail( "send" );
+		}
+
+		lwip_close( iSocket );
+	}
+
+	xTaskNotifyGive( xBenchTask );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTcpChurn( void )
+{
+xBenchSample xStart;
+int iListener, iSocket, i;
+double dElapsed;
+
+	iListener = prvListen( SOCK_STREAM, benchCHURN_PORT );
+	xTaskCreate( prvChurnServer, "Churn", benchTASK_STACK_SIZE, ( void * ) ( intptr_t ) iListener, benchTASK_PRIORITY, NULL );
+
+	prvBegin( &xStart );
+
+	for( i = 0; i < benchCHURN_CONNECTIONS; i++ )
+	{
+		iSocket = prvConnect( SOCK_STREAM, benchCHURN_PORT );
+
+		if( lwip_send( iSocket, ucBuffer, benchREQUEST_SIZE, 0 ) != benchREQUEST_SIZE )
+		{
+			prvFail( "send" );
+		}
+
+		prvReceiveAll( iSocket, ucBuffer, benchREQUEST_SIZE );
+		lwip_close( iSocket );
+	}
+
+	ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	dElapsed = prvNow() - xStart.dTime;
+
+	printf( "tcp churn: %d connections in %.3f s, %.0f/s\n", benchCHURN_CONNECTIONS, dElapsed,
+			( double ) benchCHURN_CONNECTIONS / dElapsed );
+	prvEnd( &xStart );
+
+	lwip_close( iListener );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void *pvParameters )
+{
+ip_addr_t xClientAddress, xServerAddress, xNetMask, xGateway;
+
+	( void ) pvParameters;
+
+	tcpip_init( NULL, NULL );
+
+	IP4_ADDR( &xClientAddress, 10, 0, 0, 1 );
+	IP4_ADDR( &xServerAddress, 10, 0, 0, 2 );
+	IP4_ADDR( &xNetMask, 255, 255, 255, 0 );
+	IP4_ADDR( &xGateway, 0, 0, 0, 0 );
+
+	netifapi_netif_add( &xClientNetIf, &xClientAddress, &xNetMask, &xGateway, &xClientPcapIf, pcapif_init, tcpip_input );
+	netifapi_netif_add( &xServerNetIf, &xServerAddress, &xNetMask, &xGateway, &xServerPcapIf, pcapif_init, tcpip_input );
+	netifapi_netif_set_up( &xClientNetIf );
+	netifapi_netif_set_up( &xServerNetIf );
+
+	prvTcpBulk();
+	prvUdpRequestResponse();
+	prvTcpChurn();
+
+	exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	/* The results are printed from tasks that are never switched back in
+	once the program exits. */
+	setvbuf( stdout, NULL, _IONBF, 0 );
+
+	xTaskCreate( prvBenchTask, "Bench", benchTASK_STACK_SIZE, NULL, benchTASK_PRIORITY, &xBenchTask );
+	vTaskStartScheduler();
+
+	return 1;
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char *pcFile, unsigned long ulLine )
+{
+	printf( "configASSERT() failed: %s line %lu\n", pcFile, ulLine );
+	exit( 1 );
+}
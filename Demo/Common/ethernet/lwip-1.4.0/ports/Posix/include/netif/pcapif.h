@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2001-2003 Swedish Institute of Computer Science.
+ * All rights reserved. 
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT 
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING 
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ * 
+ * Author: Adam Dunkels <adam@sics.se>
+ *
+ */
+#ifndef __NETIF_PCAPIF_H__
+#define __NETIF_PCAPIF_H__
+
+#include <stdio.h>
+
+#include "lwip/netif.h"
+#include "netif/rxbuf.h"
+
+/* The largest frame, excluding any ETH_PAD_SIZE padding, that is replayed or
+transmitted.  Longer frames are counted as dropped. */
+#define pcapifMAX_FRAME_SIZE	1518
+
+#if LWIP_NETIF_RX_ZEROCOPY
+	/* With zero-copy receive, received frames are copied (as a MAC would DMA
+	them) into a ring of this many buffers, which are passed to the stack
+	without a further copy. */
+	#define pcapifRX_BUFFERS		32
+	#define pcapifRX_BUFFER_SIZE	( ( ETH_PAD_SIZE + pcapifMAX_FRAME_SIZE + MEM_ALIGNMENT - 1 ) & ~( MEM_ALIGNMENT - 1 ) )
+#endif
+
+/* The per-interface state passed as the state parameter of netif_add().  The
+first three members are set by the application before netif_add() is called,
+the remaining members are private to pcapif.c.
+
+For example, two interfaces that exchange frames with each other, the first of
+which also replays a capture into the stack:
+
+	static struct xPcapIf xIfA = { "capture.pcap", NULL, &xNetIfB };
+	static struct xPcapIf xIfB = { NULL, NULL, &xNetIfA };
+
+	netif_add( &xNetIfA, &xAddrA, &xMask, &xGateway, &xIfA, pcapif_init, tcpip_input );
+	netif_add( &xNetIfB, &xAddrB, &xMask, &xGateway, &xIfB, pcapif_init, tcpip_input );
+*/
+struct xPcapIf
+{
+	/* pcap file whose frames are passed to the stack by pcapif_replay(), or
+	NULL. */
+	const char *pcReplayFile;
+
+	/* pcap file that every transmitted frame is written to, or NULL. */
+	const char *pcRecordFile;
+
+	/* The interface that transmitted frames are received on.  NULL loops the
+	frames back to the transmitting interface. */
+	struct netif *pxPeer;
+
+	/* Private. */
+	unsigned char *pucReplayBuffer;
+	size_t xReplayLength;
+	int iReplaySwapped;
+	FILE *pxRecord;
+	unsigned long ulTransmitted;
+	unsigned long ulReceived;
+	unsigned long ulDropped;
+	unsigned char ucFrame[ ETH_PAD_SIZE + pcapifMAX_FRAME_SIZE ];
+	#if LWIP_NETIF_RX_ZEROCOPY
+		struct rxbuf_pool xRxPool;
+		struct rxbuf xRxBuffers[ pcapifRX_BUFFERS ];
+		struct rxbuf *pxFreeRxBuffers[ pcapifRX_BUFFERS ];
+		int iFreeRxBuffers;
+		unsigned char ucRxMemory[ pcapifRX_BUFFERS ][ pcapifRX_BUFFER_SIZE ] __attribute__( ( aligned( MEM_ALIGNMENT ) ) );
+	#endif
+};
+
+/*
+ * Initialise an interface.  Passed as the init parameter of netif_add().
+ * Returns ERR_ARG if the replay file cannot be read or is not an Ethernet
+ * capture, and ERR_IF if the record file cannot be created.
+ */
+err_t pcapif_init( struct netif *pxNetIf );
+
+/*
+ * Pass every frame in the interface's replay file to pxNetIf->input(),
+ * ulRepetitions times.  Must be called from a task other than the tcpip
+ * thread.  If the stack cannot accept a frame the calling task blocks for a
+ * tick and tries again, so the replay runs at the rate the stack can sustain.
+ * With TCPIP_INPUT_BATCH_SIZE > 0 and tcpip_input as the interface's input
+ * function, up to TCPIP_INPUT_BATCH_SIZE frames are passed to the tcpip
+ * thread at a time with tcpip_input_batch().
+ * Returns the number of frames that were accepted.
+ */
+unsigned long pcapif_replay( struct netif *pxNetIf, unsigned long ulRepetitions );
+
+/*
+ * Release the replay buffer and close the record file.
+ */
+void pcapif_close( struct netif *pxNetIf );
+
+#endif /* __NETIF_PCAPIF_H__ */
@@ -0,0 +1,645 @@
+/*
+ * Copyright (c) 2001-2003 Swedish Institute of Computer Science.
+ * All rights reserved. 
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT 
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING 
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ * 
+ * Author: Adam Dunkels <adam@sics.se>
+ *
+ */
+
+/* A network interface for running the stack on a Linux host without a
+network.  Transmitted frames are delivered to a peer interface (or looped back
+to the transmitting interface) and can be recorded to a pcap file, and frames
+can be replayed into the stack from a pcap file.  See netif/pcapif.h. */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* lwIP includes. */
+#include "lwip/opt.h"
+#include "lwip/def.h"
+#include "lwip/pbuf.h"
+#include "lwip/stats.h"
+#include "lwip/snmp.h"
+#include "lwip/tcpip.h"
+#include "netif/etharp.h"
+#include "netif/pcapif.h"
+
+/* Define those to better describe your network interface. */
+#define IFNAME0 'p'
+#define IFNAME1 'c'
+
+#define netifMAX_MTU 1500
+
+/* pcap file format constants. */
+#define pcapifMAGIC_USEC		0xa1b2c3d4UL
+#define pcapifMAGIC_NSEC		0xa1b23c4dUL
+#define pcapifLINKTYPE_ETHERNET	1UL
+#define pcapifFILE_HEADER_SIZE	24
+#define pcapifRECORD_HEADER_SIZE	16
+
+/* The number of times a replayed frame is offered to the stack before it is
+dropped.  The calling task blocks for a tick between attempts. */
+#define pcapifMAX_REPLAY_ATTEMPTS	100
+
+/*
+ * Read a 32-bit field from a pcap file, swapping it if the file was written
+ * on a host of the opposite endianness.
+ */
+static u32_t prvRead32( const unsigned char *pucField, int iSwapped );
+
+/*
+ * Load the replay file into memory and check its header.
+ */
+static err_t prvLoadReplayFile( struct xPcapIf *pxPcapIf );
+
+/*
+ * Create the record file and write its header.
+ */
+static err_t prvCreateRecordFile( struct xPcapIf *pxPcapIf );
+
+#if LWIP_NETIF_RX_ZEROCOPY
+	/*
+	 * Return a receive buffer to the interface's ring once the stack has
+	 * freed it.
+	 */
+	static void prvReleaseRxBuffer( struct rxbuf *pxBuffer );
+#endif
+
+/*
+ * Copy a frame into a pbuf (or a receive buffer, with zero-copy receive).
+ * Returns NULL if no buffer is free.
+ */
+static struct pbuf *prvFrameToPbuf( struct netif *pxNetIf, const unsigned char *pucFrame, u16_t usLength );
+
+/*
+ * Copy a frame into a pbuf and pass it to pxNetIf->input().
+ */
+static err_t prvInjectFrame( struct netif *pxNetIf, const unsigned char *pucFrame, u16_t usLength );
+
+#if TCPIP_INPUT_BATCH_SIZE
+	/*
+	 * Pass the usFrames pbufs collected by pcapif_replay() to the tcpip
+	 * thread with tcpip_input_batch().  Returns the number of frames accepted;
+	 * the frames are dropped if the stack does not accept them.
+	 */
+	static unsigned long prvInjectBatch( struct netif *pxNetIf, struct pbuf **ppxBatch, u16_t usFrames );
+#endif
+
+/*
+ * Send a frame to the peer interface and the record file.
+ */
+static err_t prvLowLevelOutput( struct netif *pxNetIf, struct pbuf *p );
+
+/*-----------------------------------------------------------*/
+
+static u32_t prvRead32( const unsigned char *pucField, int iSwapped )
+{
+u32_t ulValue;
+
+	memcpy( &ulValue, pucField, sizeof( ulValue ) );
+
+	if( iSwapped != 0 )
+	{
+		ulValue = ( ( ulValue & 0x000000ffUL ) << 24 ) | ( ( ulValue & 0x0000ff00UL ) << 8 ) |
+				  ( ( ulValue & 0x00ff0000UL ) >> 8 ) | ( ( ulValue & 0xff000000UL ) >> 24 );
+	}
+
+	return ulValue;
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvLoadReplayFile( struct xPcapIf *pxPcapIf )
+{
+FILE *pxFile;
+long lLength;
+u32_t ulMagic;
+err_t xReturn = ERR_ARG;
+
+	pxFile = fopen( pxPcapIf->pcReplayFile, "rb" );
+
+	if( pxFile != NULL )
+	{
+		if( ( fseek( pxFile, 0L, SEEK_END ) == 0 ) && ( ( lLength = ftell( pxFile ) ) >= pcapifFILE_HEADER_SIZE ) )
+		{
+			rewind( pxFile );
+			pxPcapIf->pucReplayBuffer = malloc( ( size_t ) lLength );
+
+			if( ( pxPcapIf->pucReplayBuffer != NULL ) &&
+				( fread( pxPcapIf->pucReplayBuffer, 1, ( size_t ) lLength, pxFile ) == ( size_t ) lLength ) )
+			{
+				pxPcapIf->xReplayLength = ( size_t ) lLength;
+
+				/* The magic number is written in the byte order of the host that
+				created the file.  Only the record timestamps differ between the
+				microsecond and nanosecond formats, and they are not used. */
+				ulMagic = prvRead32( pxPcapIf->pucReplayBuffer, 0 );
+
+				if( ( ulMagic == pcapifMAGIC_USEC ) || ( ulMagic == pcapifMAGIC_NSEC ) )
+				{
+					pxPcapIf->iReplaySwapped = 0;
+					xReturn = ERR_OK;
+				}
+				else
+				{
+					ulMagic = prvRead32( pxPcapIf->pucReplayBuffer, 1 );
+
+					if( ( ulMagic == pcapifMAGIC_USEC ) || ( ulMagic == pcapifMAGIC_NSEC ) )
+					{
+						pxPcapIf->iReplaySwapped = 1;
+						xReturn = ERR_OK;
+					}
+				}
+
+				/* Only Ethernet captures can be replayed. */
+				if( ( xReturn == ERR_OK ) &&
+					( prvRead32( &( pxPcapIf->pucReplayBuffer[ 20 ] ), pxPcapIf->iReplaySwapped ) != pcapifLINKTYPE_ETHERNET ) )
+				{
+					xReturn = ERR_ARG;
+				}
+			}
+		}
+
+		fclose( pxFile );
+	}
+
+	if( xReturn != ERR_OK )
+	{
+		LWIP_DEBUGF( NETIF_DEBUG, ( "pcapif_init: cannot replay %s\n", pxPcapIf->pcReplayFile ) );
+		free( pxPcapIf->pucReplayBuffer );
+		pxPcapIf->pucReplayBuffer = NULL;
+		pxPcapIf->xReplayLength = 0;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvCreateRecordFile( struct xPcapIf *pxPcapIf )
+{
+const u32_t ulHeader[ 6 ] = { pcapifMAGIC_USEC, 0x00040002UL, 0UL, 0UL, pcapifMAX_FRAME_SIZE, pcapifLINKTYPE_ETHERNET };
+err_t xReturn = ERR_IF;
+
+	/* The header is written in host byte order, as the magic number tells the
+	reader which order that was.  0x00040002 is version 2.4. */
+	pxPcapIf->pxRecord = fopen( pxPcapIf->pcRecordFile, "wb" );
+
+	if( pxPcapIf->pxRecord != NULL )
+	{
+		if( fwrite( ulHeader, sizeof( ulHeader ), 1, pxPcapIf->pxRecord ) == 1 )
+		{
+			xReturn = ERR_OK;
+		}
+		else
+		{
+			fclose( pxPcapIf->pxRecord );
+			pxPcapIf->pxRecord = NULL;
+		}
+	}
+
+	if( xReturn != ERR_OK )
+	{
+		LWIP_DEBUGF( NETIF_DEBUG, ( "pcapif_init: cannot record to %s\n", pxPcapIf->pcRecordFile ) );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if LWIP_NETIF_RX_ZEROCOPY
+
+static void prvReleaseRxBuffer( struct rxbuf *pxBuffer )
+{
+struct xPcapIf *pxPcapIf = ( struct xPcapIf * ) pxBuffer->arg;
+
+	/* Called from the tcpip thread or an application task. */
+	taskENTER_CRITICAL();
+	{
+		pxPcapIf->pxFreeRxBuffers[ pxPcapIf->iFreeRxBuffers++ ] = pxBuffer;
+	}
+	taskEXIT_CRITICAL();
+}
+
+#endif /* LWIP_NETIF_RX_ZEROCOPY */
+/*-----------------------------------------------------------*/
+
+static struct pbuf *prvFrameToPbuf( struct netif *pxNetIf, const unsigned char *pucFrame, u16_t usLength )
+{
+struct pbuf *p = NULL;
+
+	#if LWIP_NETIF_RX_ZEROCOPY
+	{
+	struct xPcapIf *pxPcapIf = ( struct xPcapIf * ) pxNetIf->state;
+	struct rxbuf *pxBuffer = NULL;
+
+		taskENTER_CRITICAL();
+		{
+			if( pxPcapIf->iFreeRxBuffers > 0 )
+			{
+				pxBuffer = pxPcapIf->pxFreeRxBuffers[ --pxPcapIf->iFreeRxBuffers ];
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( pxBuffer != NULL )
+		{
+			/* This copy stands in for the MAC's DMA. */
+			memcpy( ( unsigned char * ) pxBuffer->mem + ETH_PAD_SIZE, pucFrame, usLength );
+			p = rxbuf_pbuf( pxBuffer, usLength );
+		}
+	}
+	#endif /* LWIP_NETIF_RX_ZEROCOPY */
+
+	if( p == NULL )
+	{
+		p = pbuf_alloc( PBUF_RAW, usLength + ETH_PAD_SIZE, PBUF_POOL );
+
+		if( p != NULL )
+		{
+			#if ETH_PAD_SIZE
+				pbuf_header( p, -ETH_PAD_SIZE ); /* drop the padding word */
+			#endif
+
+			pbuf_take( p, pucFrame, usLength );
+
+			#if ETH_PAD_SIZE
+				pbuf_header( p, ETH_PAD_SIZE ); /* reclaim the padding word */
+			#endif
+		}
+	}
+
+	#if !LWIP_NETIF_RX_ZEROCOPY
+		( void ) pxNetIf;
+	#endif
+
+	return p;
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvInjectFrame( struct netif *pxNetIf, const unsigned char *pucFrame, u16_t usLength )
+{
+struct xPcapIf *pxPcapIf = ( struct xPcapIf * ) pxNetIf->state;
+struct pbuf *p;
+err_t xReturn = ERR_MEM;
+
+	p = prvFrameToPbuf( pxNetIf, pucFrame, usLength );
+
+	if( p != NULL )
+	{
+		/* Ownership of the pbuf passes to the stack unless input() fails. */
+		xReturn = pxNetIf->input( p, pxNetIf );
+
+		if( xReturn == ERR_OK )
+		{
+			LINK_STATS_INC( link.recv );
+			snmp_add_ifinoctets( pxNetIf, usLength );
+			pxPcapIf->ulReceived++;
+		}
+		else
+		{
+			pbuf_free( p );
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if TCPIP_INPUT_BATCH_SIZE
+
+static unsigned long prvInjectBatch( struct netif *pxNetIf, struct pbuf **ppxBatch, u16_t usFrames )
+{
+struct xPcapIf *pxPcapIf = ( struct xPcapIf * ) pxNetIf->state;
+u32_t ulOctets = 0;
+u16_t x;
+int iAttempt;
+
+	if( usFrames == 0 )
+	{
+		return 0;
+	}
+
+	/* Count the octets now, the stack may free the pbufs as soon as they
+	have been posted. */
+	for( x = 0; x < usFrames; x++ )
+	{
+		ulOctets += ppxBatch[ x ]->tot_len - ETH_PAD_SIZE;
+	}
+
+	for( iAttempt = 0; iAttempt < pcapifMAX_REPLAY_ATTEMPTS; iAttempt++ )
+	{
+		if( tcpip_input_batch( ppxBatch, usFrames, pxNetIf ) == ERR_OK )
+		{
+			for( x = 0; x < usFrames; x++ )
+			{
+				LINK_STATS_INC( link.recv );
+			}
+
+			snmp_add_ifinoctets( pxNetIf, ulOctets );
+			pxPcapIf->ulReceived += usFrames;
+			return usFrames;
+		}
+
+		/* The tcpip mailbox is full.  Let the tcpip thread catch up. */
+		vTaskDelay( 1 );
+	}
+
+	for( x = 0; x < usFrames; x++ )
+	{
+		LINK_STATS_INC( link.drop );
+		pbuf_free( ppxBatch[ x ] );
+	}
+
+	pxPcapIf->ulDropped += usFrames;
+
+	return 0;
+}
+
+#endif /* TCPIP_INPUT_BATCH_SIZE */
+/*-----------------------------------------------------------*/
+
+static err_t prvLowLevelOutput( struct netif *pxNetIf, struct pbuf *p )
+{
+struct xPcapIf *pxPcapIf = ( struct xPcapIf * ) pxNetIf->state;
+struct netif *pxPeer;
+u16_t usLength = p->tot_len - ETH_PAD_SIZE;
+u32_t ulRecordHeader[ 4 ];
+struct timeval xNow;
+err_t xReturn = ERR_OK;
+
+	if( usLength > pcapifMAX_FRAME_SIZE )
+	{
+		LINK_STATS_INC( link.lenerr );
+		xReturn = ERR_BUF;
+	}
+	else
+	{
+		/* Flatten the chain.  The copy is needed whatever the shape of the
+		chain, as the stack may reuse p once this function returns. */
+		pbuf_copy_partial( p, pxPcapIf->ucFrame, usLength, ETH_PAD_SIZE );
+
+		if( pxPcapIf->pxRecord != NULL )
+		{
+			gettimeofday( &xNow, NULL );
+			ulRecordHeader[ 0 ] = ( u32_t ) xNow.tv_sec;
+			ulRecordHeader[ 1 ] = ( u32_t ) xNow.tv_usec;
+			ulRecordHeader[ 2 ] = usLength;
+			ulRecordHeader[ 3 ] = usLength;
+			fwrite( ulRecordHeader, sizeof( ulRecordHeader ), 1, pxPcapIf->pxRecord );
+			fwrite( pxPcapIf->ucFrame, usLength, 1, pxPcapIf->pxRecord );
+		}
+
+		pxPeer = ( pxPcapIf->pxPeer != NULL ) ? pxPcapIf->pxPeer : pxNetIf;
+
+		/* A frame the peer cannot accept is lost, as it would be on a real
+		link.  TCP retransmits it. */
+		if( prvInjectFrame( pxPeer, pxPcapIf->ucFrame, usLength ) != ERR_OK )
+		{
+			xReturn = ERR_BUF;
+		}
+	}
+
+	if( xReturn == ERR_OK )
+	{
+		LINK_STATS_INC( link.xmit );
+		snmp_add_ifoutoctets( pxNetIf, usLength );
+		pxPcapIf->ulTransmitted++;
+	}
+	else
+	{
+		LINK_STATS_INC( link.drop );
+		snmp_inc_ifoutdiscards( pxNetIf );
+		pxPcapIf->ulDropped++;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long pcapif_replay( struct netif *pxNetIf, unsigned long ulRepetitions )
+{
+struct xPcapIf *pxPcapIf = ( struct xPcapIf * ) pxNetIf->state;
+size_t xOffset;
+u32_t ulCapturedLength;
+unsigned long ulAccepted = 0, ulRepetition;
+int iAttempt;
+#if TCPIP_INPUT_BATCH_SIZE
+	/* Frames are batched when the interface feeds the tcpip thread. */
+	int iBatched = ( pxNetIf->input == tcpip_input );
+	struct pbuf *pxBatch[ TCPIP_INPUT_BATCH_SIZE ], *p;
+	u16_t usFrames = 0;
+#endif
+
+	for( ulRepetition = 0; ulRepetition < ulRepetitions; ulRepetition++ )
+	{
+		xOffset = pcapifFILE_HEADER_SIZE;
+
+		while( ( xOffset + pcapifRECORD_HEADER_SIZE ) <= pxPcapIf->xReplayLength )
+		{
+			ulCapturedLength = prvRead32( &( pxPcapIf->pucReplayBuffer[ xOffset + 8 ] ), pxPcapIf->iReplaySwapped );
+			xOffset += pcapifRECORD_HEADER_SIZE;
+
+			if( ulCapturedLength > ( pxPcapIf->xReplayLength - xOffset ) )
+			{
+				/* Truncated file. */
+				break;
+			}
+
+			if( ulCapturedLength > pcapifMAX_FRAME_SIZE )
+			{
+				pxPcapIf->ulDropped++;
+			}
+			#if TCPIP_INPUT_BATCH_SIZE
+			else if( iBatched != 0 )
+			{
+				for( iAttempt = 0; iAttempt < pcapifMAX_REPLAY_ATTEMPTS; iAttempt++ )
+				{
+					p = prvFrameToPbuf( pxNetIf, &( pxPcapIf->pucReplayBuffer[ xOffset ] ), ( u16_t ) ulCapturedLength );
+
+					if( p != NULL )
+					{
+						pxBatch[ usFrames++ ] = p;
+
+						if( usFrames == TCPIP_INPUT_BATCH_SIZE )
+						{
+							ulAccepted += prvInjectBatch( pxNetIf, pxBatch, usFrames );
+							usFrames = 0;
+						}
+
+						break;
+					}
+
+					/* Out of pbufs.  Pass on the frames collected so far
+					and let the tcpip thread catch up. */
+					ulAccepted += prvInjectBatch( pxNetIf, pxBatch, usFrames );
+					usFrames = 0;
+					vTaskDelay( 1 );
+				}
+
+				if( iAttempt == pcapifMAX_REPLAY_ATTEMPTS )
+				{
+					LINK_STATS_INC( link.drop );
+					pxPcapIf->ulDropped++;
+				}
+			}
+			#endif /* TCPIP_INPUT_BATCH_SIZE */
+			else
+			{
+				for( iAttempt = 0; iAttempt < pcapifMAX_REPLAY_ATTEMPTS; iAttempt++ )
+				{
+					if( prvInjectFrame( pxNetIf, &( pxPcapIf->pucReplayBuffer[ xOffset ] ), ( u16_t ) ulCapturedLength ) == ERR_OK )
+					{
+						ulAccepted++;
+						break;
+					}
+
+					/* Out of pbufs or the tcpip mailbox is full.  Let the
+					tcpip thread catch up. */
+					vTaskDelay( 1 );
+				}
+
+				if( iAttempt == pcapifMAX_REPLAY_ATTEMPTS )
+				{
+					LINK_STATS_INC( link.drop );
+					pxPcapIf->ulDropped++;
+				}
+			}
+
+			xOffset += ulCapturedLength;
+		}
+	}
+
+	#if TCPIP_INPUT_BATCH_SIZE
+		ulAccepted += prvInjectBatch( pxNetIf, pxBatch, usFrames );
+	#endif
+
+	return ulAccepted;
+}
+/*-----------------------------------------------------------*/
+
+void pcapif_close( struct netif *pxNetIf )
+{
+struct xPcapIf *pxPcapIf = ( struct xPcapIf * ) pxNetIf->state;
+
+	free( pxPcapIf->pucReplayBuffer );
+	pxPcapIf->pucReplayBuffer = NULL;
+	pxPcapIf->xReplayLength = 0;
+
+	if( pxPcapIf->pxRecord != NULL )
+	{
+		fclose( pxPcapIf->pxRecord );
+		pxPcapIf->pxRecord = NULL;
+	}
+}
+/*-----------------------------------------------------------*/
+
+err_t pcapif_init( struct netif *pxNetIf )
+{
+struct xPcapIf *pxPcapIf;
+err_t xReturn = ERR_OK;
+
+	LWIP_ASSERT( "pxNetIf != NULL", ( pxNetIf != NULL ) );
+	LWIP_ASSERT( "pxNetIf->state != NULL", ( pxNetIf->state != NULL ) );
+
+	pxPcapIf = ( struct xPcapIf * ) pxNetIf->state;
+	pxPcapIf->pucReplayBuffer = NULL;
+	pxPcapIf->xReplayLength = 0;
+	pxPcapIf->pxRecord = NULL;
+	pxPcapIf->ulTransmitted = 0;
+	pxPcapIf->ulReceived = 0;
+	pxPcapIf->ulDropped = 0;
+
+	#if LWIP_NETIF_RX_ZEROCOPY
+	{
+	int i;
+
+		/* Frames are copied once the stack holds all but four buffers, so
+		the ring never runs dry. */
+		rxbuf_pool_init( &( pxPcapIf->xRxPool ), prvReleaseRxBuffer, pcapifRX_BUFFERS - 4 );
+
+		for( i = 0; i < pcapifRX_BUFFERS; i++ )
+		{
+			rxbuf_init( &( pxPcapIf->xRxPool ), &( pxPcapIf->xRxBuffers[ i ] ), pxPcapIf->ucRxMemory[ i ], pcapifRX_BUFFER_SIZE, pxPcapIf );
+			pxPcapIf->pxFreeRxBuffers[ i ] = &( pxPcapIf->xRxBuffers[ i ] );
+		}
+
+		pxPcapIf->iFreeRxBuffers = pcapifRX_BUFFERS;
+	}
+	#endif /* LWIP_NETIF_RX_ZEROCOPY */
+
+	#if LWIP_NETIF_HOSTNAME
+	{
+		/* Initialize interface hostname */
+		pxNetIf->hostname = "lwip";
+	}
+	#endif /* LWIP_NETIF_HOSTNAME */
+
+	/*
+	 * Initialize the snmp variables and counters inside the struct netif.
+	 * The last argument should be replaced with your link speed, in units
+	 * of bits per second.
+	 */
+	NETIF_INIT_SNMP( pxNetIf, snmp_ifType_ethernet_csmacd, 100000000 );
+
+	pxNetIf->name[ 0 ] = IFNAME0;
+	pxNetIf->name[ 1 ] = IFNAME1;
+	pxNetIf->output = etharp_output;
+	pxNetIf->linkoutput = prvLowLevelOutput;
+	pxNetIf->mtu = netifMAX_MTU;
+	pxNetIf->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_LINK_UP;
+
+	/* A locally administered unicast address that is unique per interface. */
+	pxNetIf->hwaddr_len = ETHARP_HWADDR_LEN;
+	pxNetIf->hwaddr[ 0 ] = 0x02;
+	pxNetIf->hwaddr[ 1 ] = 0x00;
+	pxNetIf->hwaddr[ 2 ] = 0x00;
+	pxNetIf->hwaddr[ 3 ] = 0x00;
+	pxNetIf->hwaddr[ 4 ] = 0x00;
+	pxNetIf->hwaddr[ 5 ] = pxNetIf->num + 1;
+
+	if( pxPcapIf->pcReplayFile != NULL )
+	{
+		xReturn = prvLoadReplayFile( pxPcapIf );
+	}
+
+	if( ( xReturn == ERR_OK ) && ( pxPcapIf->pcRecordFile != NULL ) )
+	{
+		xReturn = prvCreateRecordFile( pxPcapIf );
+
+		if( xReturn != ERR_OK )
+		{
+			pcapif_close( pxNetIf );
+		}
+	}
+
+	return xReturn;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2001, Swedish Institute of Computer Science.
+ * All rights reserved. 
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met: 
+ * 1. Redistributions of source code must retain the above copyright 
+ *    notice, this list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright 
+ *    notice, this list of conditions and the following disclaimer in the 
+ *    documentation and/or other materials provided with the distribution. 
+ * 3. Neither the name of the Institute nor the names of its contributors 
+ *    may be used to endorse or promote products derived from this software 
+ *    without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND 
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE 
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY 
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF 
+ * SUCH DAMAGE. 
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ * 
+ * Author: Adam Dunkels <adam@sics.se>
+ *
+ */
+
+/* Accumulates the PERF_START/PERF_STOP() measurements made by the core of the
+stack when LWIP_PERF is set to 1.  Timestamps are read from the CPU cycle
+counter where one is readable from user space, and are otherwise nanoseconds
+from the monotonic clock. */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "lwip/opt.h"
+#include "arch/perf.h"
+
+#if LWIP_PERF
+
+/* The number of distinct PERF_STOP() names that can be recorded.  There are
+four in the lwIP 1.4.0 core. */
+#define perfMAX_RECORDS		8
+
+typedef struct xPERF_RECORD
+{
+	const char *pcName;
+	unsigned long ulCount;
+	unsigned long long ullTotal;
+	unsigned long long ullMax;
+} xPerfRecord;
+
+static xPerfRecord xRecords[ perfMAX_RECORDS ];
+/*-----------------------------------------------------------*/
+
+unsigned long long perf_timestamp( void )
+{
+	#if defined( __x86_64__ ) || defined( __i386__ )
+	{
+	unsigned int ulLow, ulHigh;
+
+		__asm volatile ( "rdtsc" : "=a" ( ulLow ), "=d" ( ulHigh ) );
+		return ( ( unsigned long long ) ulHigh << 32 ) | ulLow;
+	}
+	#elif defined( __aarch64__ )
+	{
+	unsigned long long ullValue;
+
+		__asm volatile ( "isb; mrs %0, cntvct_el0" : "=r" ( ullValue ) );
+		return ullValue;
+	}
+	#else
+	{
+	struct timespec xNow;
+
+		clock_gettime( CLOCK_MONOTONIC, &xNow );
+		return ( ( unsigned long long ) xNow.tv_sec * 1000000000ULL ) + ( unsigned long long ) xNow.tv_nsec;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+void perf_record( const char *pcName, unsigned long long ullElapsed )
+{
+int i;
+
+	/* pbuf_free() is also called by application tasks, so a task switch
+	between its PERF_START and PERF_STOP() can leave the shared start time
+	later than the stop time.  Such a measurement is discarded. */
+	if( ( long long ) ullElapsed < 0 )
+	{
+		return;
+	}
+
+	/* The names are string literals, so comparing the pointers first avoids
+	the strcmp() on every call after the first. */
+	for( i = 0; i < perfMAX_RECORDS; i++ )
+	{
+		if( ( xRecords[ i ].pcName == pcName ) || ( xRecords[ i ].pcName == NULL ) || ( strcmp( xRecords[ i ].pcName, pcName ) == 0 ) )
+		{
+			break;
+		}
+	}
+
+	if( i < perfMAX_RECORDS )
+	{
+		xRecords[ i ].pcName = pcName;
+		xRecords[ i ].ulCount++;
+		xRecords[ i ].ullTotal += ullElapsed;
+
+		if( ullElapsed > xRecords[ i ].ullMax )
+		{
+			xRecords[ i ].ullMax = ullElapsed;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void perf_report( void )
+{
+int i;
+
+	for( i = 0; ( i < perfMAX_RECORDS ) && ( xRecords[ i ].pcName != NULL ); i++ )
+	{
+		printf( "%-12s calls %10lu  mean %10llu  max %10llu\n",
+				xRecords[ i ].pcName,
+				xRecords[ i ].ulCount,
+				xRecords[ i ].ullTotal / xRecords[ i ].ulCount,
+				xRecords[ i ].ullMax );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void perf_reset( void )
+{
+	memset( xRecords, 0x00, sizeof( xRecords ) );
+}
+
+#endif /* LWIP_PERF */
@@ -603,6 +603,9 @@ netconn_write(struct netconn *conn, const void *dataptr, size_t size, u8_t apifl
   msg.msg.msg.w.dataptr = dataptr;
   msg.msg.msg.w.apiflags = apiflags;
   msg.msg.msg.w.len = size;
+#if LWIP_SOCKET_ZEROCOPY
+  msg.msg.msg.w.done = NULL;
+#endif /* LWIP_SOCKET_ZEROCOPY */
   /* For locking the core: this _can_ be delayed on low memory/low send buffer,
      but if it is, this is done inside api_msg.c:do_write(), so we can use the
      non-blocking version here. */
@@ -612,6 +615,55 @@ netconn_write(struct netconn *conn, const void *dataptr, size_t size, u8_t apifl
   return err;
 }
 
+#if LWIP_SOCKET_ZEROCOPY
+/**
+ * Send data over a TCP netconn without copying it. The data is referenced
+ * by the queued segments until the remote host acknowledges it, so it must
+ * not be changed until 'done' is called.
+ *
+ * @param conn the TCP netconn over which to send data
+ * @param dataptr pointer to the application buffer with the data to send
+ * @param size size of the application data to send
+ * @param apiflags combination of following flags :
+ * - NETCONN_MORE: for TCP connection, PSH flag will be set on last segment sent
+ * - NETCONN_DONTBLOCK: only write the data if all data can be written at once
+ * (NETCONN_COPY is ignored)
+ * @param done called from the tcpip thread once the data is acknowledged,
+ *        or with an error if the connection was aborted first. It is
+ *        only called if this function returns ERR_OK.
+ * @param arg argument passed to done
+ * @return ERR_OK if data was queued, ERR_MEM if the connection already has
+ *         LWIP_SOCKET_ZEROCOPY_QUEUE zero-copy writes waiting, or any error
+ *         netconn_write() returns
+ */
+err_t
+netconn_write_zc(struct netconn *conn, const void *dataptr, size_t size,
+                 u8_t apiflags, netconn_zc_done_fn done, void *arg)
+{
+  struct api_msg msg;
+  err_t err;
+
+  LWIP_ERROR("netconn_write_zc: invalid conn",  (conn != NULL), return ERR_ARG;);
+  LWIP_ERROR("netconn_write_zc: invalid conn->type",  (conn->type == NETCONN_TCP), return ERR_VAL;);
+  LWIP_ERROR("netconn_write_zc: invalid done",  (done != NULL), return ERR_ARG;);
+  if (size == 0) {
+    return ERR_VAL;
+  }
+
+  msg.function = do_write;
+  msg.msg.conn = conn;
+  msg.msg.msg.w.dataptr = dataptr;
+  msg.msg.msg.w.apiflags = (u8_t)(apiflags & ~NETCONN_COPY);
+  msg.msg.msg.w.len = size;
+  msg.msg.msg.w.done = done;
+  msg.msg.msg.w.done_arg = arg;
+  err = TCPIP_APIMSG(&msg);
+
+  NETCONN_SET_SAFE_ERR(conn, err);
+  return err;
+}
+#endif /* LWIP_SOCKET_ZEROCOPY */
+
 /**
  * Close ot shutdown a TCP netconn (doesn't delete it).
  *
@@ -206,6 +206,34 @@ recv_udp(void *arg, struct udp_pcb *pcb, struct pbuf *p,
 #endif /* LWIP_UDP */
 
 #if LWIP_TCP
+#if LWIP_SOCKET_ZEROCOPY
+/**
+ * Call back the zero-copy writes of a TCP netconn that the stack no longer
+ * references.
+ *
+ * @param conn the TCP netconn
+ * @param pcb the pcb of conn, its lastack tells which writes are acknowledged,
+ *        or NULL if the pcb is gone and all writes have been discarded
+ * @param err passed to the callbacks of discarded writes
+ */
+static void
+netconn_zc_complete(struct netconn *conn, struct tcp_pcb *pcb, err_t err)
+{
+  struct netconn_zc *zc;
+
+  while (conn->zc_count > 0) {
+    zc = &conn->zc[conn->zc_first];
+    if ((pcb != NULL) && ((s32_t)(pcb->lastack - zc->end) < 0)) {
+      /* not (entirely) acknowledged yet, neither are the following ones */
+      break;
+    }
+    conn->zc_first = (conn->zc_first + 1) % LWIP_SOCKET_ZEROCOPY_QUEUE;
+    conn->zc_count--;
+    zc->done(zc->arg, (pcb != NULL) ? ERR_OK : err);
+  }
+}
+#endif /* LWIP_SOCKET_ZEROCOPY */
+
 /**
  * Receive callback function for TCP netconns.
  * Posts the packet to conn->recvmbox, but doesn't delete it on errors.
@@ -317,6 +345,11 @@ sent_tcp(void *arg, struct tcp_pcb *pcb, u16_t len)
   LWIP_UNUSED_ARG(pcb);
   LWIP_ASSERT("conn != NULL", (conn != NULL));
 
+#if LWIP_SOCKET_ZEROCOPY
+  /* before do_close_internal(), which waits for these */
+  netconn_zc_complete(conn, pcb, ERR_OK);
+#endif /* LWIP_SOCKET_ZEROCOPY */
+
   if (conn->state == NETCONN_WRITE) {
     do_writemore(conn);
   } else if (conn->state == NETCONN_CLOSE) {
@@ -360,6 +393,12 @@ err_tcp(void *arg, err_t err)
   conn->last_err = err;
   SYS_ARCH_UNPROTECT(lev);
 
+#if LWIP_SOCKET_ZEROCOPY
+  /* the pcb's segments have been (or are about to be) freed without
+     being sent again */
+  netconn_zc_complete(conn, NULL, err);
+#endif /* LWIP_SOCKET_ZEROCOPY */
+
   /* reset conn->state now before waking up other threads */
   old_state = conn->state;
   conn->state = NETCONN_NONE;
@@ -623,6 +662,10 @@ netconn_alloc(enum netconn_type t, netconn_callback callback)
 #if LWIP_TCP
   conn->current_msg  = NULL;
   conn->write_offset = 0;
+#if LWIP_SOCKET_ZEROCOPY
+  conn->zc_first     = 0;
+  conn->zc_count     = 0;
+#endif /* LWIP_SOCKET_ZEROCOPY */
 #endif /* LWIP_TCP */
 #if LWIP_SO_RCVTIMEO
   conn->recv_timeout = 0;
@@ -749,6 +792,15 @@ do_close_internal(struct netconn *conn)
   /* shutting down both ends is the same as closing */
   close = shut == NETCONN_SHUT_RDWR;
 
+#if LWIP_SOCKET_ZEROCOPY
+  if (close && (conn->zc_count > 0)) {
+    /* The pcb still references zero-copy data. Once closed, it would not
+       tell us when the data has been acknowledged, so wait for sent_tcp
+       (or err_tcp) to complete the writes first. */
+    return;
+  }
+#endif /* LWIP_SOCKET_ZEROCOPY */
+
   /* Set back some callback pointers */
   if (close) {
     tcp_arg(conn->pcb.tcp, NULL);
@@ -1283,6 +1335,20 @@ do_writemore(struct netconn *conn)
   }
 
   if (write_finished) {
+#if LWIP_SOCKET_ZEROCOPY
+    if ((conn->current_msg->msg.w.done != NULL) &&
+        ((err == ERR_OK) || (conn->write_offset > 0))) {
+      /* Wait for the acknowledgement of the data now referenced by the
+         pcb. After an error, part of it may have been queued: then the
+         callback is called although the write failed. */
+      struct netconn_zc *zc = &conn->zc[(conn->zc_first + conn->zc_count) % LWIP_SOCKET_ZEROCOPY_QUEUE];
+      zc->end = conn->pcb.tcp->snd_lbb;
+      zc->done = conn->current_msg->msg.w.done;
+      zc->arg = conn->current_msg->msg.w.done_arg;
+      conn->zc_count++;
+      conn->write_offset = 0;
+    }
+#endif /* LWIP_SOCKET_ZEROCOPY */
     /* everything was written: set back connection state
        and back to application task */
     conn->current_msg->err = err;
@@ -1321,6 +1387,14 @@ do_write(struct api_msg_msg *msg)
         /* netconn is connecting, closing or in blocking write */
         msg->err = ERR_INPROGRESS;
       } else if (msg->conn->pcb.tcp != NULL) {
+#if LWIP_SOCKET_ZEROCOPY
+        if ((msg->msg.w.done != NULL) &&
+            (msg->conn->zc_count >= LWIP_SOCKET_ZEROCOPY_QUEUE)) {
+          msg->err = ERR_MEM;
+          TCPIP_APIMSG_ACK(msg);
+          return;
+        }
+#endif /* LWIP_SOCKET_ZEROCOPY */
         msg->conn->state = NETCONN_WRITE;
         /* set all the variables used by do_writemore */
         LWIP_ASSERT("already writing or closing", msg->conn->current_msg == NULL &&
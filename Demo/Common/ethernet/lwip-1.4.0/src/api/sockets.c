@@ -80,6 +80,11 @@ struct lwip_sock {
   int err;
   /** counter of how many threads are waiting for this socket using select */
   int select_waiting;
+#if LWIP_SOCKET_ZEROCOPY
+  /** bytes given back with lwip_recv_zc_release() but not yet passed to
+      netconn_recved() */
+  u32_t zc_recved;
+#endif /* LWIP_SOCKET_ZEROCOPY */
 };
 
 /** Description for a task waiting in select */
@@ -158,6 +163,13 @@ static const int err_to_errno_table[] = {
   ((unsigned)(-(err)) < ERR_TO_ERRNO_TABLE_SIZE ? \
     err_to_errno_table[-(err)] : EIO)
 
+#if LWIP_SOCKET_ZEROCOPY
+/** lwip_recv_zc_release() calls netconn_recved() (a round trip to the tcpip
+    thread) once this many bytes have been given back, like tcp_recved() only
+    sends a window update after TCP_WND / 4 bytes */
+#define LWIP_RECV_ZC_RECVED_THRESHOLD (TCP_WND / 4)
+#endif /* LWIP_SOCKET_ZEROCOPY */
+
 #ifdef ERRNO
 #ifndef set_errno
 #define set_errno(err) errno = (err)
@@ -263,6 +275,9 @@ alloc_socket(struct netconn *newconn, int accepted)
       sockets[i].errevent   = 0;
       sockets[i].err        = 0;
       sockets[i].select_waiting = 0;
+#if LWIP_SOCKET_ZEROCOPY
+      sockets[i].zc_recved  = 0;
+#endif /* LWIP_SOCKET_ZEROCOPY */
       return i;
     }
     SYS_ARCH_UNPROTECT(lev);
@@ -730,6 +745,129 @@ lwip_recvfrom(int s, void *mem, size_t len, int flags,
   return off;
 }
 
+#if LWIP_SOCKET_ZEROCOPY
+/**
+ * Receive data without copying it: the pbuf chain holding the data is handed
+ * to the application, which must give it back with lwip_recv_zc_release()
+ * once it is done with it. For TCP, the receive window is only opened again
+ * by lwip_recv_zc_release(), so held buffers throttle the sender.
+ *
+ * @param s the socket to receive from
+ * @param p where to store the received pbuf chain
+ * @param flags MSG_DONTWAIT is supported, MSG_PEEK is not
+ * @return the number of bytes in *p, 0 if the TCP connection was closed by
+ *         the remote host, or -1 on error
+ */
+int
+lwip_recv_zc(int s, struct pbuf **p, int flags)
+{
+  struct lwip_sock *sock;
+  void             *buf;
+  struct pbuf      *q;
+  err_t            err;
+
+  LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_recv_zc(%d, %p, 0x%x)\n", s, (void *)p, flags));
+  sock = get_socket(s);
+  if (!sock) {
+    return -1;
+  }
+  if ((p == NULL) || ((flags & MSG_PEEK) != 0)) {
+    sock_set_errno(sock, EINVAL);
+    return -1;
+  }
+
+  if (sock->lastdata) {
+    /* data left by lwip_recvfrom() */
+    buf = sock->lastdata;
+  } else {
+    if (((flags & MSG_DONTWAIT) || netconn_is_nonblocking(sock->conn)) &&
+        (sock->rcvevent <= 0)) {
+      LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_recv_zc(%d): returning EWOULDBLOCK\n", s));
+      sock_set_errno(sock, EWOULDBLOCK);
+      return -1;
+    }
+    if ((sock->rcvevent <= 0) && (netconn_type(sock->conn) == NETCONN_TCP)) {
+      /* about to wait for data: open the window for everything released */
+      lwip_recv_zc_release(s, NULL);
+    }
+    if (netconn_type(sock->conn) == NETCONN_TCP) {
+      err = netconn_recv_tcp_pbuf(sock->conn, (struct pbuf **)&buf);
+    } else {
+      err = netconn_recv(sock->conn, (struct netbuf **)&buf);
+    }
+    if (err != ERR_OK) {
+      LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_recv_zc(%d): error is \"%s\"!\n",
+        s, lwip_strerr(err)));
+      sock_set_errno(sock, err_to_errno(err));
+      return (err == ERR_CLSD) ? 0 : -1;
+    }
+  }
+
+  if (netconn_type(sock->conn) == NETCONN_TCP) {
+    q = (struct pbuf *)buf;
+    /* drop what lwip_recvfrom() already consumed; the window was opened
+       for that part when it was copied */
+    while (sock->lastoffset >= q->len) {
+      struct pbuf *next = q->next;
+      sock->lastoffset -= q->len;
+      q->next = NULL;
+      pbuf_free(q);
+      q = next;
+    }
+    if (sock->lastoffset > 0) {
+      pbuf_header(q, -(s16_t)sock->lastoffset);
+    }
+  } else {
+    /* take the pbuf chain out of the netbuf */
+    q = ((struct netbuf *)buf)->p;
+    ((struct netbuf *)buf)->p = ((struct netbuf *)buf)->ptr = NULL;
+    netbuf_delete((struct netbuf *)buf);
+  }
+  sock->lastdata = NULL;
+  sock->lastoffset = 0;
+
+  *p = q;
+  sock_set_errno(sock, 0);
+  return q->tot_len;
+}
+
+/**
+ * Give back a pbuf chain received with lwip_recv_zc(). For TCP sockets, this
+ * opens the receive window by the length of the chain, so the chain must be
+ * given back unchanged.
+ *
+ * @param s the socket p was received from
+ * @param p the pbuf chain returned by lwip_recv_zc(), or NULL to only open
+ *        the window for chains given back before
+ */
+void
+lwip_recv_zc_release(int s, struct pbuf *p)
+{
+  struct lwip_sock *sock = tryget_socket(s);
+  u32_t recved = 0;
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  if ((sock != NULL) && (sock->conn != NULL) &&
+      (netconn_type(sock->conn) == NETCONN_TCP)) {
+    SYS_ARCH_PROTECT(lev);
+    if (p != NULL) {
+      sock->zc_recved += p->tot_len;
+    }
+    if ((p == NULL) || (sock->zc_recved >= LWIP_RECV_ZC_RECVED_THRESHOLD)) {
+      recved = sock->zc_recved;
+      sock->zc_recved = 0;
+    }
+    SYS_ARCH_UNPROTECT(lev);
+    if (recved > 0) {
+      netconn_recved(sock->conn, recved);
+    }
+  }
+  if (p != NULL) {
+    pbuf_free(p);
+  }
+}
+#endif /* LWIP_SOCKET_ZEROCOPY */
+
 int
 lwip_read(int s, void *mem, size_t len)
 {
@@ -784,6 +922,126 @@ lwip_send(int s, const void *data, size_t size, int flags)
   return (err == ERR_OK ? (int)size : -1);
 }
 
+#if LWIP_SOCKET_ZEROCOPY
+#if (LWIP_UDP || LWIP_RAW) && !LWIP_NETIF_TX_SINGLE_PBUF
+/** A pbuf referencing the application buffer of a lwip_send_zc() datagram */
+struct lwip_zc_pbuf {
+  struct pbuf_custom pc;
+  netconn_zc_done_fn done;
+  void *arg;
+};
+
+/** Called by pbuf_free() when the stack no longer references a datagram */
+static void
+lwip_zc_pbuf_free(struct pbuf *p)
+{
+  struct lwip_zc_pbuf *zp = (struct lwip_zc_pbuf *)p;
+  if (zp->done != NULL) {
+    zp->done(zp->arg, ERR_OK);
+  }
+  mem_free(zp);
+}
+#endif /* (LWIP_UDP || LWIP_RAW) && !LWIP_NETIF_TX_SINGLE_PBUF */
+
+/**
+ * Send data from an application buffer without copying it. The buffer must
+ * not be changed until 'done' is called: for TCP, that is once the remote
+ * host has acknowledged the data, from the tcpip thread; for UDP and RAW,
+ * once the datagram has left the stack (possibly before this function
+ * returns). If the connection is aborted first, 'done' gets the error.
+ * 'done' is only called if this function succeeds. Datagram sockets must be
+ * connected.
+ *
+ * @param s the socket to send on
+ * @param data the data to send
+ * @param size number of bytes to send
+ * @param flags MSG_MORE and MSG_DONTWAIT as for lwip_send()
+ * @param done called when the stack no longer references data
+ * @param arg passed to done
+ * @return size, or -1 on error
+ */
+int
+lwip_send_zc(int s, const void *data, size_t size, int flags,
+             netconn_zc_done_fn done, void *arg)
+{
+  struct lwip_sock *sock;
+  err_t err;
+
+  LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_send_zc(%d, data=%p, size=%"SZT_F", flags=0x%x)\n",
+                              s, data, size, flags));
+
+  sock = get_socket(s);
+  if (!sock) {
+    return -1;
+  }
+  if (done == NULL) {
+    sock_set_errno(sock, EINVAL);
+    return -1;
+  }
+
+  if (sock->conn->type == NETCONN_TCP) {
+#if LWIP_TCP
+    if ((flags & MSG_DONTWAIT) || netconn_is_nonblocking(sock->conn)) {
+      if ((size > TCP_SND_BUF) || ((size / TCP_MSS) > TCP_SND_QUEUELEN)) {
+        /* too much data to ever send nonblocking! */
+        sock_set_errno(sock, EMSGSIZE);
+        return -1;
+      }
+    }
+    err = netconn_write_zc(sock->conn, data, size,
+      ((flags & MSG_MORE)     ? NETCONN_MORE      : 0) |
+      ((flags & MSG_DONTWAIT) ? NETCONN_DONTBLOCK : 0), done, arg);
+#else /* LWIP_TCP */
+    err = ERR_ARG;
+#endif /* LWIP_TCP */
+  } else {
+#if (LWIP_UDP || LWIP_RAW) && !LWIP_NETIF_TX_SINGLE_PBUF
+    struct lwip_zc_pbuf *zp;
+    struct netbuf buf;
+
+    LWIP_ASSERT("lwip_send_zc: size must fit in u16_t", size <= 0xffff);
+    zp = (struct lwip_zc_pbuf *)mem_malloc(sizeof(struct lwip_zc_pbuf));
+    if (zp == NULL) {
+      err = ERR_MEM;
+    } else {
+      zp->pc.custom_free_function = lwip_zc_pbuf_free;
+      zp->done = done;
+      zp->arg = arg;
+      /* no payload_mem: the headers cannot be written in front of data */
+      buf.p = buf.ptr = pbuf_alloced_custom(PBUF_RAW, (u16_t)size, PBUF_REF,
+        &zp->pc, NULL, (u16_t)size);
+      buf.p->payload = (void *)data;
+#if LWIP_CHECKSUM_ON_COPY
+      buf.flags = 0;
+#endif /* LWIP_CHECKSUM_ON_COPY */
+      /* send to the connected peer */
+      ip_addr_set_any(&buf.addr);
+      netbuf_fromport(&buf) = 0;
+      err = netconn_send(sock->conn, &buf);
+      if (err != ERR_OK) {
+        zp->done = NULL;
+      }
+      /* calls done now, unless a netif driver still holds the pbuf */
+      pbuf_free(buf.p);
+    }
+#elif LWIP_UDP || LWIP_RAW
+    /* the netif needs each packet in a single pbuf: copy it */
+    if (lwip_send(s, data, size, flags) < 0) {
+      return -1;
+    }
+    done(arg, ERR_OK);
+    return (int)size;
+#else /* (LWIP_UDP || LWIP_RAW) && !LWIP_NETIF_TX_SINGLE_PBUF */
+    err = ERR_ARG;
+#endif /* (LWIP_UDP || LWIP_RAW) && !LWIP_NETIF_TX_SINGLE_PBUF */
+  }
+
+  LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_send_zc(%d) err=%d size=%"SZT_F"\n", s, err, size));
+  sock_set_errno(sock, err_to_errno(err));
+  return (err == ERR_OK ? (int)size : -1);
+}
+#endif /* LWIP_SOCKET_ZEROCOPY */
+
 int
 lwip_sendto(int s, const void *data, size_t size, int flags,
        const struct sockaddr *to, socklen_t tolen)
@@ -59,6 +59,23 @@ static sys_mbox_t mbox;
 sys_mutex_t lock_tcpip_core;
 #endif /* LWIP_TCPIP_CORE_LOCKING */
 
+/**
+ * Pass a received packet to ethernet_input() or ip_input(), depending on
+ * the type of the interface it was received on.
+ */
+static err_t
+tcpip_packet_input(struct pbuf *p, struct netif *inp)
+{
+#if LWIP_ETHERNET
+  if (inp->flags & (NETIF_FLAG_ETHARP | NETIF_FLAG_ETHERNET)) {
+    return ethernet_input(p, inp);
+  } else
+#endif /* LWIP_ETHERNET */
+  {
+    return ip_input(p, inp);
+  }
+}
+
 
 /**
  * The main lwIP thread. This thread has exclusive access to lwIP core functions
@@ -74,6 +91,9 @@ static void
 tcpip_thread(void *arg)
 {
   struct tcpip_msg *msg;
+#if TCPIP_INPUT_BATCH_SIZE && !LWIP_TCPIP_CORE_LOCKING_INPUT
+  u16_t i;
+#endif /* TCPIP_INPUT_BATCH_SIZE && !LWIP_TCPIP_CORE_LOCKING_INPUT */
   LWIP_UNUSED_ARG(arg);
 
   if (tcpip_init_done != NULL) {
@@ -98,16 +118,19 @@ tcpip_thread(void *arg)
 #if !LWIP_TCPIP_CORE_LOCKING_INPUT
     case TCPIP_MSG_INPKT:
       LWIP_DEBUGF(TCPIP_DEBUG, ("tcpip_thread: PACKET %p\n", (void *)msg));
-#if LWIP_ETHERNET
-      if (msg->msg.inp.netif->flags & (NETIF_FLAG_ETHARP | NETIF_FLAG_ETHERNET)) {
-        ethernet_input(msg->msg.inp.p, msg->msg.inp.netif);
-      } else
-#endif /* LWIP_ETHERNET */
-      {
-        ip_input(msg->msg.inp.p, msg->msg.inp.netif);
-      }
+      tcpip_packet_input(msg->msg.inp.p, msg->msg.inp.netif);
       memp_free(MEMP_TCPIP_MSG_INPKT, msg);
       break;
+
+#if TCPIP_INPUT_BATCH_SIZE
+    case TCPIP_MSG_INBATCH:
+      LWIP_DEBUGF(TCPIP_DEBUG, ("tcpip_thread: BATCH %p (%"U16_F" packets)\n", (void *)msg, msg->msg.inbatch.num));
+      for (i = 0; i < msg->msg.inbatch.num; i++) {
+        tcpip_packet_input(msg->msg.inbatch.p[i], msg->msg.inbatch.netif);
+      }
+      memp_free(MEMP_TCPIP_MSG_INBATCH, msg);
+      break;
+#endif /* TCPIP_INPUT_BATCH_SIZE */
 #endif /* LWIP_TCPIP_CORE_LOCKING_INPUT */
 
 #if LWIP_NETIF_API
@@ -159,14 +182,7 @@ tcpip_input(struct pbuf *p, struct netif *inp)
   err_t ret;
   LWIP_DEBUGF(TCPIP_DEBUG, ("tcpip_input: PACKET %p/%p\n", (void *)p, (void *)inp));
   LOCK_TCPIP_CORE();
-#if LWIP_ETHERNET
-  if (inp->flags & (NETIF_FLAG_ETHARP | NETIF_FLAG_ETHERNET)) {
-    ret = ethernet_input(p, inp);
-  } else
-#endif /* LWIP_ETHERNET */
-  {
-    ret = ip_input(p, inp);
-  }
+  ret = tcpip_packet_input(p, inp);
   UNLOCK_TCPIP_CORE();
   return ret;
 #else /* LWIP_TCPIP_CORE_LOCKING_INPUT */
@@ -191,6 +207,61 @@ tcpip_input(struct pbuf *p, struct netif *inp)
 #endif /* LWIP_TCPIP_CORE_LOCKING_INPUT */
 }
 
+#if TCPIP_INPUT_BATCH_SIZE
+/**
+ * Pass a batch of received packets to tcpip_thread for input processing
+ * with a single message. All packets must have been received on the same
+ * interface. On success the stack owns all of them, on error none of them.
+ *
+ * @param p array of num received packets (see tcpip_input), the array
+ *          itself is copied and may be reused by the caller
+ * @param num number of packets in p, 1..TCPIP_INPUT_BATCH_SIZE
+ * @param inp the network interface on which the packets were received
+ */
+err_t
+tcpip_input_batch(struct pbuf **p, u16_t num, struct netif *inp)
+{
+  u16_t i;
+#if !LWIP_TCPIP_CORE_LOCKING_INPUT
+  struct tcpip_msg *msg;
+#endif /* !LWIP_TCPIP_CORE_LOCKING_INPUT */
+
+  LWIP_ERROR("tcpip_input_batch: invalid batch size",
+    (num > 0) && (num <= TCPIP_INPUT_BATCH_SIZE), return ERR_ARG;);
+
+#if LWIP_TCPIP_CORE_LOCKING_INPUT
+  LWIP_DEBUGF(TCPIP_DEBUG, ("tcpip_input_batch: %"U16_F" packets/%p\n", num, (void *)inp));
+  LOCK_TCPIP_CORE();
+  for (i = 0; i < num; i++) {
+    tcpip_packet_input(p[i], inp);
+  }
+  UNLOCK_TCPIP_CORE();
+  return ERR_OK;
+#else /* LWIP_TCPIP_CORE_LOCKING_INPUT */
+  if (sys_mbox_valid(&mbox)) {
+    msg = (struct tcpip_msg *)memp_malloc(MEMP_TCPIP_MSG_INBATCH);
+    if (msg == NULL) {
+      return ERR_MEM;
+    }
+
+    msg->type = TCPIP_MSG_INBATCH;
+    msg->msg.inbatch.p = (struct pbuf **)(void *)(msg + 1);
+    msg->msg.inbatch.num = num;
+    msg->msg.inbatch.netif = inp;
+    for (i = 0; i < num; i++) {
+      msg->msg.inbatch.p[i] = p[i];
+    }
+    if (sys_mbox_trypost(&mbox, msg) != ERR_OK) {
+      memp_free(MEMP_TCPIP_MSG_INBATCH, msg);
+      return ERR_MEM;
+    }
+    return ERR_OK;
+  }
+  return ERR_VAL;
+#endif /* LWIP_TCPIP_CORE_LOCKING_INPUT */
+}
+#endif /* TCPIP_INPUT_BATCH_SIZE */
+
 /**
  * Call a specific function in the thread context of
  * tcpip_thread for easy access synchronization.
@@ -187,6 +187,21 @@
 #if IP_FRAG && IP_FRAG_USES_STATIC_BUF && LWIP_NETIF_TX_SINGLE_PBUF
   #error "LWIP_NETIF_TX_SINGLE_PBUF does not work with IP_FRAG_USES_STATIC_BUF==1 as that creates pbuf queues"
 #endif
+#if LWIP_PCB_HASH_SIZE & (LWIP_PCB_HASH_SIZE - 1)
+  #error "LWIP_PCB_HASH_SIZE must be a power of 2"
+#endif
+#if ETHARP_HASH_SIZE & (ETHARP_HASH_SIZE - 1)
+  #error "ETHARP_HASH_SIZE must be a power of 2"
+#endif
+#if LWIP_ARP && ETHARP_LOCKFREE_READ && !NO_SYS && !defined(SYS_ARCH_MEMORY_BARRIER)
+  #error "ETHARP_LOCKFREE_READ needs SYS_ARCH_MEMORY_BARRIER() to be defined in your arch/sys_arch.h"
+#endif
+#if MEMP_LOCKFREE && (MEMP_MEM_MALLOC || MEMP_SANITY_CHECK || (MEMP_OVERFLOW_CHECK >= 2))
+  #error "MEMP_LOCKFREE cannot be used with MEMP_MEM_MALLOC, MEMP_SANITY_CHECK or MEMP_OVERFLOW_CHECK>=2"
+#endif
+#if MEMP_LOCKFREE && !NO_SYS && !defined(SYS_ARCH_CAS32)
+  #error "MEMP_LOCKFREE needs SYS_ARCH_CAS32() to be defined in your arch/sys_arch.h"
+#endif
 
 
 /* Compile-time checks for deprecated options.
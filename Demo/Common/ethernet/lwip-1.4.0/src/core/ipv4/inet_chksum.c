@@ -52,7 +52,7 @@
  * #define LWIP_CHKSUM <your_checksum_routine> 
  *
  * Or you can select from the implementations below by defining
- * LWIP_CHKSUM_ALGORITHM to 1, 2 or 3.
+ * LWIP_CHKSUM_ALGORITHM to 1, 2, 3 or 4.
  */
 
 #ifndef LWIP_CHKSUM
@@ -256,6 +256,105 @@ lwip_standard_chksum(void *dataptr, int len)
 }
 #endif
 
+#if (LWIP_CHKSUM_ALGORITHM == 4) || (LWIP_CHKSUM_COPY_ALGORITHM == 2)
+/* Fold the 64-bit accumulator used by version #4 and the fused copy down to
+ * 16 bits, and undo the byte swap caused by starting at an odd address.
+ */
+static u16_t
+lwip_chksum_fold64(unsigned long long sum, int odd)
+{
+  u32_t sum32;
+
+  sum32 = (u32_t)sum;
+  sum32 += (u32_t)(sum >> 32);
+  if (sum32 < (u32_t)(sum >> 32)) {
+    sum32++;                    /* add back carry */
+  }
+  sum32 = FOLD_U32T(sum32);
+  sum32 = FOLD_U32T(sum32);
+
+  if (odd) {
+    sum32 = SWAP_BYTES_IN_WORD(sum32);
+  }
+
+  return (u16_t)sum32;
+}
+#endif
+
+#if (LWIP_CHKSUM_ALGORITHM == 4) /* Alternative version #4 */
+/**
+ * Like version #3, but the 32-bit words are added into a 64-bit accumulator
+ * so the carries are only folded back in once at the end, instead of being
+ * tested after every addition, and the inner loop is unrolled to 32 bytes.
+ * On a 32-bit CPU the 64-bit additions are an add and an add-with-carry; on
+ * a 64-bit CPU they are single instructions the compiler can vectorise.
+ *
+ * @arg start of buffer to be checksummed. May be an odd byte address.
+ * @len number of bytes in the buffer to be checksummed.
+ * @return host order (!) lwip checksum (non-inverted Internet sum) 
+ */
+
+static u16_t
+lwip_standard_chksum(void *dataptr, int len)
+{
+  u8_t *pb = (u8_t *)dataptr;
+  u32_t *pl;
+  u16_t t = 0;
+  unsigned long long sum = 0;
+  /* starts at odd byte address? */
+  int odd = ((mem_ptr_t)pb & 1);
+
+  if (odd && len > 0) {
+    ((u8_t *)&t)[1] = *pb++;
+    len--;
+  }
+
+  if (((mem_ptr_t)pb & 3) && len > 1) {
+    sum += *(u16_t *)(void *)pb;
+    pb += 2;
+    len -= 2;
+  }
+
+  pl = (u32_t *)(void *)pb;
+
+  while (len > 31) {
+    sum += pl[0];
+    sum += pl[1];
+    sum += pl[2];
+    sum += pl[3];
+    sum += pl[4];
+    sum += pl[5];
+    sum += pl[6];
+    sum += pl[7];
+    pl += 8;
+    len -= 32;
+  }
+
+  while (len > 3) {
+    sum += *pl++;
+    len -= 4;
+  }
+
+  pb = (u8_t *)pl;
+
+  /* 16-bit aligned word remaining? */
+  if (len > 1) {
+    sum += *(u16_t *)(void *)pb;
+    pb += 2;
+    len -= 2;
+  }
+
+  /* dangling tail byte remaining? */
+  if (len > 0) {                /* include odd byte */
+    ((u8_t *)&t)[0] = *pb;
+  }
+
+  sum += t;                     /* add end bytes */
+
+  return lwip_chksum_fold64(sum, odd);
+}
+#endif
+
 /* inet_chksum_pseudo:
  *
  * Calculates the pseudo Internet checksum used by TCP and UDP for a pbuf chain.
@@ -448,3 +547,93 @@ lwip_chksum_copy(void *dst, const void *src, u16_t len)
   return LWIP_CHKSUM(dst, len);
 }
 #endif /* (LWIP_CHKSUM_COPY_ALGORITHM == 1) */
+
+#if (LWIP_CHKSUM_COPY_ALGORITHM == 2) /* Version #2 */
+/** Copy and checksum in a single pass, using the word-at-a-time summing of
+ * LWIP_CHKSUM_ALGORITHM 4 so each word is loaded once. Falls back to
+ * version #1 when dst and src are not equally aligned, as the words could
+ * then not be stored without unaligned accesses.
+ */
+u16_t
+lwip_chksum_copy(void *dst, const void *src, u16_t len)
+{
+  u8_t *pd = (u8_t *)dst;
+  const u8_t *ps = (const u8_t *)src;
+  u32_t *pld;
+  const u32_t *pls;
+  u32_t w0, w1, w2, w3;
+  u16_t t = 0, w;
+  int left = len;
+  unsigned long long sum = 0;
+  int odd;
+
+  if (((mem_ptr_t)pd ^ (mem_ptr_t)ps) & 3) {
+    MEMCPY(dst, src, len);
+    return LWIP_CHKSUM(dst, len);
+  }
+
+  odd = ((mem_ptr_t)ps & 1);
+
+  if (odd && left > 0) {
+    ((u8_t *)&t)[1] = *pd++ = *ps++;
+    left--;
+  }
+
+  if (((mem_ptr_t)ps & 3) && left > 1) {
+    w = *(const u16_t *)(const void *)ps;
+    *(u16_t *)(void *)pd = w;
+    sum += w;
+    ps += 2;
+    pd += 2;
+    left -= 2;
+  }
+
+  pls = (const u32_t *)(const void *)ps;
+  pld = (u32_t *)(void *)pd;
+
+  while (left > 15) {
+    w0 = pls[0];
+    w1 = pls[1];
+    w2 = pls[2];
+    w3 = pls[3];
+    pld[0] = w0;
+    pld[1] = w1;
+    pld[2] = w2;
+    pld[3] = w3;
+    sum += w0;
+    sum += w1;
+    sum += w2;
+    sum += w3;
+    pls += 4;
+    pld += 4;
+    left -= 16;
+  }
+
+  while (left > 3) {
+    w0 = *pls++;
+    *pld++ = w0;
+    sum += w0;
+    left -= 4;
+  }
+
+  ps = (const u8_t *)pls;
+  pd = (u8_t *)pld;
+
+  if (left > 1) {
+    w = *(const u16_t *)(const void *)ps;
+    *(u16_t *)(void *)pd = w;
+    sum += w;
+    ps += 2;
+    pd += 2;
+    left -= 2;
+  }
+
+  if (left > 0) {
+    ((u8_t *)&t)[0] = *pd = *ps;
+  }
+
+  sum += t;
+
+  return lwip_chksum_fold64(sum, odd);
+}
+#endif /* (LWIP_CHKSUM_COPY_ALGORITHM == 2) */
@@ -105,6 +105,38 @@ tcp_timer_needed(void)
     sys_timeout(TCP_TMR_INTERVAL, tcpip_tcp_timer, NULL);
   }
 }
+
+#if TCP_COALESCE_DEADLINE
+/** global variable that shows if the tcp coalescing timer is currently scheduled or not */
+static int tcpip_tcp_coalesce_timer_active;
+
+/**
+ * Timer callback function that calls tcp_coalesce_tmr().
+ *
+ * @param arg unused argument
+ */
+static void
+tcpip_tcp_coalesce_timer(void *arg)
+{
+  LWIP_UNUSED_ARG(arg);
+
+  tcpip_tcp_coalesce_timer_active = 0;
+  tcp_coalesce_tmr();
+}
+
+/**
+ * Called from tcp_output when it holds back data for coalescing:
+ * starts the one-shot timer that sends it after TCP_COALESCE_DEADLINE ms.
+ */
+void
+tcp_coalesce_timer_needed(void)
+{
+  if (!tcpip_tcp_coalesce_timer_active) {
+    tcpip_tcp_coalesce_timer_active = 1;
+    sys_timeout(TCP_COALESCE_DEADLINE, tcpip_tcp_coalesce_timer, NULL);
+  }
+}
+#endif /* TCP_COALESCE_DEADLINE */
 #endif /* LWIP_TCP */
 
 #if IP_REASSEMBLY
@@ -479,4 +511,12 @@ void
 tcp_timer_needed(void)
 {
 }
+
+#if LWIP_TCP && TCP_COALESCE_DEADLINE
+/* The application calls tcp_coalesce_tmr() periodically instead */
+void
+tcp_coalesce_timer_needed(void)
+{
+}
+#endif /* LWIP_TCP && TCP_COALESCE_DEADLINE */
 #endif /* LWIP_TIMERS */
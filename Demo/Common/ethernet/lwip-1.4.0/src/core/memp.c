@@ -64,7 +64,12 @@
 #if !MEMP_MEM_MALLOC /* don't build if not configured for use in lwipopts.h */
 
 struct memp {
+#if MEMP_LOCKFREE
+  /** index + 1 of the next free element in the pool (0: none) */
+  u32_t next;
+#else /* MEMP_LOCKFREE */
   struct memp *next;
+#endif /* MEMP_LOCKFREE */
 #if MEMP_OVERFLOW_CHECK
   const char *file;
   int line;
@@ -100,6 +105,8 @@ struct memp {
 /* MEMP_SIZE: save space for struct memp and for sanity check */
 #define MEMP_SIZE          (LWIP_MEM_ALIGN_SIZE(sizeof(struct memp)) + MEMP_SANITY_REGION_BEFORE_ALIGNED)
 #define MEMP_ALIGN_SIZE(x) (LWIP_MEM_ALIGN_SIZE(x) + MEMP_SANITY_REGION_AFTER_ALIGNED)
+/* distance between two elements of a pool */
+#define MEMP_ELEMENT_SIZE(type) (MEMP_SIZE + memp_sizes[type] + MEMP_SANITY_REGION_AFTER_ALIGNED)
 
 #else /* MEMP_OVERFLOW_CHECK */
 
@@ -109,13 +116,50 @@ struct memp {
  */
 #define MEMP_SIZE           0
 #define MEMP_ALIGN_SIZE(x) (LWIP_MEM_ALIGN_SIZE(x))
+#define MEMP_ELEMENT_SIZE(type) (memp_sizes[type])
 
 #endif /* MEMP_OVERFLOW_CHECK */
 
+#if MEMP_LOCKFREE
+
+/** This array holds the first free element of each pool as a single word,
+ *  so that it can be updated with SYS_ARCH_CAS32(). The low 16 bits are the
+ *  index + 1 of the element (0: pool empty), the high 16 bits a tag that
+ *  every memp_malloc() increments. A pop that races with another pop and a
+ *  push of the same element (ABA) then sees the tag change, and retries
+ *  instead of installing a stale next pointer. */
+static volatile u32_t memp_tab[MEMP_MAX];
+
+/** This array holds the first element of each pool, from which the element
+ *  indices are counted. */
+static u8_t *memp_first[MEMP_MAX];
+
+#define MEMP_INDEX_MASK    0x0000ffffUL
+#define MEMP_TAG_MASK      0xffff0000UL
+#define MEMP_TAG_ONE       0x00010000UL
+
+#if NO_SYS && !defined(SYS_ARCH_CAS32)
+/* without an OS and without interrupts using memp, a plain store will do */
+#define SYS_ARCH_CAS32(ptr, expected, desired) \
+  ((*(ptr) == (expected)) ? ((*(ptr) = (desired)), 1) : 0)
+#endif /* NO_SYS && !defined(SYS_ARCH_CAS32) */
+
+/** The statistics are not atomic, so they keep their critical section */
+#if MEMP_STATS
+#define MEMP_LOCKFREE_STATS(x) do { SYS_ARCH_DECL_PROTECT(lev); \
+                                    SYS_ARCH_PROTECT(lev); x; SYS_ARCH_UNPROTECT(lev); } while(0)
+#else /* MEMP_STATS */
+#define MEMP_LOCKFREE_STATS(x)
+#endif /* MEMP_STATS */
+
+#else /* MEMP_LOCKFREE */
+
 /** This array holds the first free element of each pool.
  *  Elements form a linked list. */
 static struct memp *memp_tab[MEMP_MAX];
 
+#endif /* MEMP_LOCKFREE */
+
 #else /* MEMP_MEM_MALLOC */
 
 #define MEMP_ALIGN_SIZE(x) (LWIP_MEM_ALIGN_SIZE(x))
@@ -328,6 +372,57 @@ memp_overflow_init(void)
 }
 #endif /* MEMP_OVERFLOW_CHECK */
 
+#if MEMP_LOCKFREE
+/**
+ * Take the first free element off a pool.
+ *
+ * @param type the pool to take an element from
+ * @return the element (not yet adjusted by MEMP_SIZE), or NULL if the pool
+ *         is empty
+ */
+static struct memp *
+memp_pop(memp_t type)
+{
+  u32_t head, next;
+  struct memp *memp;
+
+  do {
+    head = memp_tab[type];
+    if ((head & MEMP_INDEX_MASK) == 0) {
+      return NULL;
+    }
+    memp = (struct memp *)(void *)(memp_first[type] +
+      ((head & MEMP_INDEX_MASK) - 1) * MEMP_ELEMENT_SIZE(type));
+    /* If another thread takes this element first, 'next' may be stale, but
+       the tag in memp_tab has then changed and the swap fails. */
+    next = *(volatile u32_t *)&memp->next;
+  } while (!SYS_ARCH_CAS32(&memp_tab[type], head,
+                           ((head + MEMP_TAG_ONE) & MEMP_TAG_MASK) | next));
+
+  return memp;
+}
+
+/**
+ * Put an element back on a pool.
+ *
+ * @param type the pool the element belongs to
+ * @param memp the element (already adjusted by MEMP_SIZE)
+ */
+static void
+memp_push(memp_t type, struct memp *memp)
+{
+  u32_t head, index;
+
+  index = (u32_t)(((u8_t *)memp - memp_first[type]) / MEMP_ELEMENT_SIZE(type)) + 1;
+  LWIP_ASSERT("memp_free: element not in pool", (index > 0) && (index <= memp_num[type]));
+
+  do {
+    head = memp_tab[type];
+    memp->next = head & MEMP_INDEX_MASK;
+  } while (!SYS_ARCH_CAS32(&memp_tab[type], head, (head & MEMP_TAG_MASK) | index));
+}
+#endif /* MEMP_LOCKFREE */
+
 /**
  * Initialize this module.
  * 
@@ -351,19 +446,26 @@ memp_init(void)
 #endif /* !MEMP_SEPARATE_POOLS */
   /* for every pool: */
   for (i = 0; i < MEMP_MAX; ++i) {
-    memp_tab[i] = NULL;
 #if MEMP_SEPARATE_POOLS
     memp = (struct memp*)memp_bases[i];
 #endif /* MEMP_SEPARATE_POOLS */
+#if MEMP_LOCKFREE
+    LWIP_ASSERT("memp_init: pool too large for MEMP_LOCKFREE", memp_num[i] < MEMP_INDEX_MASK);
+    memp_first[i] = (u8_t *)memp;
+    memp_tab[i] = 0;
+#else /* MEMP_LOCKFREE */
+    memp_tab[i] = NULL;
+#endif /* MEMP_LOCKFREE */
     /* create a linked list of memp elements */
     for (j = 0; j < memp_num[i]; ++j) {
+#if MEMP_LOCKFREE
+      memp->next = memp_tab[i];
+      memp_tab[i] = j + 1;
+#else /* MEMP_LOCKFREE */
       memp->next = memp_tab[i];
       memp_tab[i] = memp;
-      memp = (struct memp *)(void *)((u8_t *)memp + MEMP_SIZE + memp_sizes[i]
-#if MEMP_OVERFLOW_CHECK
-        + MEMP_SANITY_REGION_AFTER_ALIGNED
-#endif
-      );
+#endif /* MEMP_LOCKFREE */
+      memp = (struct memp *)(void *)((u8_t *)memp + MEMP_ELEMENT_SIZE(i));
     }
   }
 #if MEMP_OVERFLOW_CHECK
@@ -392,10 +494,30 @@ memp_malloc_fn(memp_t type, const char* file, const int line)
 #endif
 {
   struct memp *memp;
+#if !MEMP_LOCKFREE
   SYS_ARCH_DECL_PROTECT(old_level);
+#endif /* !MEMP_LOCKFREE */
  
   LWIP_ERROR("memp_malloc: type < MEMP_MAX", (type < MEMP_MAX), return NULL;);
 
+#if MEMP_LOCKFREE
+  memp = memp_pop(type);
+
+  if (memp != NULL) {
+#if MEMP_OVERFLOW_CHECK
+    memp->next = 0;
+    memp->file = file;
+    memp->line = line;
+#endif /* MEMP_OVERFLOW_CHECK */
+    MEMP_LOCKFREE_STATS(MEMP_STATS_INC_USED(used, type));
+    LWIP_ASSERT("memp_malloc: memp properly aligned",
+                ((mem_ptr_t)memp % MEM_ALIGNMENT) == 0);
+    memp = (struct memp*)(void *)((u8_t*)memp + MEMP_SIZE);
+  } else {
+    LWIP_DEBUGF(MEMP_DEBUG | LWIP_DBG_LEVEL_SERIOUS, ("memp_malloc: out of memory in pool %s\n", memp_desc[type]));
+    MEMP_LOCKFREE_STATS(MEMP_STATS_INC(err, type));
+  }
+#else /* MEMP_LOCKFREE */
   SYS_ARCH_PROTECT(old_level);
 #if MEMP_OVERFLOW_CHECK >= 2
   memp_overflow_check_all();
@@ -420,6 +542,7 @@ memp_malloc_fn(memp_t type, const char* file, const int line)
   }
 
   SYS_ARCH_UNPROTECT(old_level);
+#endif /* MEMP_LOCKFREE */
 
   return memp;
 }
@@ -434,7 +557,9 @@ void
 memp_free(memp_t type, void *mem)
 {
   struct memp *memp;
+#if !MEMP_LOCKFREE
   SYS_ARCH_DECL_PROTECT(old_level);
+#endif /* !MEMP_LOCKFREE */
 
   if (mem == NULL) {
     return;
@@ -444,6 +569,16 @@ memp_free(memp_t type, void *mem)
 
   memp = (struct memp *)(void *)((u8_t*)mem - MEMP_SIZE);
 
+#if MEMP_LOCKFREE
+#if MEMP_OVERFLOW_CHECK
+  memp_overflow_check_element_overflow(memp, type);
+  memp_overflow_check_element_underflow(memp, type);
+#endif /* MEMP_OVERFLOW_CHECK */
+
+  MEMP_LOCKFREE_STATS(MEMP_STATS_DEC(used, type));
+
+  memp_push(type, memp);
+#else /* MEMP_LOCKFREE */
   SYS_ARCH_PROTECT(old_level);
 #if MEMP_OVERFLOW_CHECK
 #if MEMP_OVERFLOW_CHECK >= 2
@@ -464,6 +599,7 @@ memp_free(memp_t type, void *mem)
 #endif /* MEMP_SANITY_CHECK */
 
   SYS_ARCH_UNPROTECT(old_level);
+#endif /* MEMP_LOCKFREE */
 }
 
 #endif /* MEMP_MEM_MALLOC */
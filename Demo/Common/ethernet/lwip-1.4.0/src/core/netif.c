@@ -174,6 +174,8 @@ netif_add(struct netif *netif, ip_addr_t *ipaddr, ip_addr_t *netmask,
   netif->input = input;
 #if LWIP_NETIF_HWADDRHINT
   netif->addr_hint = NULL;
+#elif LWIP_ARP && ETHARP_HASH_SIZE
+  netif->arp_hint = 0;
 #endif /* LWIP_NETIF_HWADDRHINT*/
 #if ENABLE_LOOPBACK && LWIP_LOOPBACK_MAX_PBUFS
   netif->loop_cnt_current = 0;
@@ -369,7 +369,7 @@ pbuf_alloced_custom(pbuf_layer l, u16_t length, pbuf_type type, struct pbuf_cust
     return NULL;
   }
 
-  if (LWIP_MEM_ALIGN_SIZE(offset) + length < payload_mem_len) {
+  if (LWIP_MEM_ALIGN_SIZE(offset) + length > payload_mem_len) {
     LWIP_DEBUGF(PBUF_DEBUG | LWIP_DBG_LEVEL_WARNING, ("pbuf_alloced_custom(length=%"U16_F") buffer too short\n", length));
     return NULL;
   }
@@ -381,6 +381,7 @@ pbuf_alloced_custom(pbuf_layer l, u16_t length, pbuf_type type, struct pbuf_cust
     p->pbuf.payload = NULL;
   }
   p->pbuf.flags = PBUF_FLAG_IS_CUSTOM;
+  p->payload_mem = payload_mem;
   p->pbuf.len = p->pbuf.tot_len = length;
   p->pbuf.type = type;
   p->pbuf.ref = 1;
@@ -538,6 +539,14 @@ pbuf_header(struct pbuf *p, s16_t header_size_increment)
     if ((header_size_increment < 0) && (increment_magnitude <= p->len)) {
       /* increase payload pointer */
       p->payload = (u8_t *)p->payload - header_size_increment;
+#if LWIP_SUPPORT_CUSTOM_PBUF
+    /* a custom pbuf owns its buffer from payload_mem on: a header that was
+       hidden (e.g. on a received frame) can be revealed again */
+    } else if ((header_size_increment > 0) && ((p->flags & PBUF_FLAG_IS_CUSTOM) != 0) &&
+               (((struct pbuf_custom *)p)->payload_mem != NULL) &&
+               ((u8_t *)p->payload - (u8_t *)((struct pbuf_custom *)p)->payload_mem >= header_size_increment)) {
+      p->payload = (u8_t *)p->payload - header_size_increment;
+#endif /* LWIP_SUPPORT_CUSTOM_PBUF */
     } else {
       /* cannot expand payload to front (yet!)
        * bail out unsuccesfully */
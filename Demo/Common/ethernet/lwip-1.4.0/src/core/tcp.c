@@ -97,6 +97,15 @@ struct tcp_pcb ** const tcp_pcb_lists[] = {&tcp_listen_pcbs.pcbs, &tcp_bound_pcb
 /** Only used for temporary storage. */
 struct tcp_pcb *tcp_tmp_pcb;
 
+#if LWIP_PCB_HASH_SIZE
+/** tcp_active_pcbs hashed by remote address and ports */
+struct tcp_pcb *tcp_active_hash[LWIP_PCB_HASH_SIZE];
+/** tcp_tw_pcbs hashed by remote address and ports */
+struct tcp_pcb *tcp_tw_hash[LWIP_PCB_HASH_SIZE];
+/** tcp_listen_pcbs hashed by local port */
+union tcp_listen_pcbs_t tcp_listen_hash[LWIP_PCB_HASH_SIZE];
+#endif /* LWIP_PCB_HASH_SIZE */
+
 /** Timer counter to handle calling slow-timer from tcp_tmr() */ 
 static u8_t tcp_timer;
 static u16_t tcp_new_port(void);
@@ -916,6 +925,7 @@ tcp_slowtmr(void)
         LWIP_ASSERT("tcp_slowtmr: first pcb == tcp_active_pcbs", tcp_active_pcbs == pcb);
         tcp_active_pcbs = pcb->next;
       }
+      TCP_HASH_RMV(&tcp_active_pcbs, pcb);
 
       TCP_EVENT_ERR(pcb->errf, pcb->callback_arg, ERR_ABRT);
       if (pcb_reset) {
@@ -973,6 +983,7 @@ tcp_slowtmr(void)
         LWIP_ASSERT("tcp_slowtmr: first pcb == tcp_tw_pcbs", tcp_tw_pcbs == pcb);
         tcp_tw_pcbs = pcb->next;
       }
+      TCP_HASH_RMV(&tcp_tw_pcbs, pcb);
       pcb2 = pcb;
       pcb = pcb->next;
       memp_free(MEMP_TCP_PCB, pcb2);
@@ -1022,6 +1033,70 @@ tcp_fasttmr(void)
   }
 }
 
+#if LWIP_PCB_HASH_SIZE
+/**
+ * Returns the hash chain a pcb on one of the pcb lists belongs to.
+ *
+ * @param pcbs the pcb list pcb is on
+ * @param pcb the tcp_pcb
+ * @return the head of the hash chain, or NULL if the list is not hashed
+ */
+static struct tcp_pcb **
+tcp_pcb_hash_chain(struct tcp_pcb **pcbs, struct tcp_pcb *pcb)
+{
+  if (pcbs == &tcp_active_pcbs) {
+    return &tcp_active_hash[TCP_PCB_HASH(&pcb->remote_ip, pcb->remote_port, pcb->local_port)];
+  } else if (pcbs == &tcp_tw_pcbs) {
+    return &tcp_tw_hash[TCP_PCB_HASH(&pcb->remote_ip, pcb->remote_port, pcb->local_port)];
+  } else if (pcbs == &tcp_listen_pcbs.pcbs) {
+    return &tcp_listen_hash[TCP_LISTEN_HASH(pcb->local_port)].pcbs;
+  }
+  /* tcp_bound_pcbs are not looked up by tcp_input */
+  return NULL;
+}
+
+/**
+ * Adds a pcb to the hash table of the pcb list it was registered with
+ * (called from TCP_REG).
+ *
+ * @param pcbs the pcb list pcb was added to
+ * @param pcb the tcp_pcb to add
+ */
+void
+tcp_pcb_hash_add(struct tcp_pcb **pcbs, struct tcp_pcb *pcb)
+{
+  struct tcp_pcb **chain = tcp_pcb_hash_chain(pcbs, pcb);
+
+  if (chain != NULL) {
+    pcb->hash_next = *chain;
+    *chain = pcb;
+  }
+}
+
+/**
+ * Removes a pcb from the hash table of the pcb list it was removed from
+ * (called from TCP_RMV).
+ *
+ * @param pcbs the pcb list pcb was removed from
+ * @param pcb the tcp_pcb to remove
+ */
+void
+tcp_pcb_hash_remove(struct tcp_pcb **pcbs, struct tcp_pcb *pcb)
+{
+  struct tcp_pcb **chain = tcp_pcb_hash_chain(pcbs, pcb);
+
+  if (chain != NULL) {
+    for (; *chain != NULL; chain = &(*chain)->hash_next) {
+      if (*chain == pcb) {
+        *chain = pcb->hash_next;
+        break;
+      }
+    }
+    pcb->hash_next = NULL;
+  }
+}
+#endif /* LWIP_PCB_HASH_SIZE */
+
 /**
  * Deallocates a list of TCP segments (tcp_seg structures).
  *
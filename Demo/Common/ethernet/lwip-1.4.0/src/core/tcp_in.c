@@ -91,10 +91,15 @@ static err_t tcp_timewait_input(struct tcp_pcb *pcb);
 void
 tcp_input(struct pbuf *p, struct netif *inp)
 {
-  struct tcp_pcb *pcb, *prev;
+  struct tcp_pcb *pcb;
+#if !LWIP_PCB_HASH_SIZE
+  struct tcp_pcb *prev;
+#endif /* !LWIP_PCB_HASH_SIZE */
   struct tcp_pcb_listen *lpcb;
 #if SO_REUSE
+#if !LWIP_PCB_HASH_SIZE
   struct tcp_pcb *lpcb_prev = NULL;
+#endif /* !LWIP_PCB_HASH_SIZE */
   struct tcp_pcb_listen *lpcb_any = NULL;
 #endif /* SO_REUSE */
   u8_t hdrlen;
@@ -176,10 +181,15 @@ tcp_input(struct pbuf *p, struct netif *inp)
 
   /* Demultiplex an incoming segment. First, we check if it is destined
      for an active connection. */
+#if LWIP_PCB_HASH_SIZE
+  for(pcb = tcp_active_hash[TCP_PCB_HASH(&current_iphdr_src, tcphdr->src, tcphdr->dest)];
+      pcb != NULL; pcb = pcb->hash_next) {
+#else /* LWIP_PCB_HASH_SIZE */
   prev = NULL;
 
   
   for(pcb = tcp_active_pcbs; pcb != NULL; pcb = pcb->next) {
+#endif /* LWIP_PCB_HASH_SIZE */
     LWIP_ASSERT("tcp_input: active pcb->state != CLOSED", pcb->state != CLOSED);
     LWIP_ASSERT("tcp_input: active pcb->state != TIME-WAIT", pcb->state != TIME_WAIT);
     LWIP_ASSERT("tcp_input: active pcb->state != LISTEN", pcb->state != LISTEN);
@@ -188,6 +198,7 @@ tcp_input(struct pbuf *p, struct netif *inp)
        ip_addr_cmp(&(pcb->remote_ip), &current_iphdr_src) &&
        ip_addr_cmp(&(pcb->local_ip), &current_iphdr_dest)) {
 
+#if !LWIP_PCB_HASH_SIZE
       /* Move this PCB to the front of the list so that subsequent
          lookups will be faster (we exploit locality in TCP segment
          arrivals). */
@@ -198,15 +209,23 @@ tcp_input(struct pbuf *p, struct netif *inp)
         tcp_active_pcbs = pcb;
       }
       LWIP_ASSERT("tcp_input: pcb->next != pcb (after cache)", pcb->next != pcb);
+#endif /* !LWIP_PCB_HASH_SIZE */
       break;
     }
+#if !LWIP_PCB_HASH_SIZE
     prev = pcb;
+#endif /* !LWIP_PCB_HASH_SIZE */
   }
 
   if (pcb == NULL) {
     /* If it did not go to an active connection, we check the connections
        in the TIME-WAIT state. */
+#if LWIP_PCB_HASH_SIZE
+    for(pcb = tcp_tw_hash[TCP_PCB_HASH(&current_iphdr_src, tcphdr->src, tcphdr->dest)];
+        pcb != NULL; pcb = pcb->hash_next) {
+#else /* LWIP_PCB_HASH_SIZE */
     for(pcb = tcp_tw_pcbs; pcb != NULL; pcb = pcb->next) {
+#endif /* LWIP_PCB_HASH_SIZE */
       LWIP_ASSERT("tcp_input: TIME-WAIT pcb->state == TIME-WAIT", pcb->state == TIME_WAIT);
       if (pcb->remote_port == tcphdr->src &&
          pcb->local_port == tcphdr->dest &&
@@ -224,8 +243,13 @@ tcp_input(struct pbuf *p, struct netif *inp)
 
     /* Finally, if we still did not get a match, we check all PCBs that
        are LISTENing for incoming connections. */
+#if LWIP_PCB_HASH_SIZE
+    for(lpcb = tcp_listen_hash[TCP_LISTEN_HASH(tcphdr->dest)].listen_pcbs;
+        lpcb != NULL; lpcb = lpcb->hash_next) {
+#else /* LWIP_PCB_HASH_SIZE */
     prev = NULL;
     for(lpcb = tcp_listen_pcbs.listen_pcbs; lpcb != NULL; lpcb = lpcb->next) {
+#endif /* LWIP_PCB_HASH_SIZE */
       if (lpcb->local_port == tcphdr->dest) {
 #if SO_REUSE
         if (ip_addr_cmp(&(lpcb->local_ip), &current_iphdr_dest)) {
@@ -234,7 +258,9 @@ tcp_input(struct pbuf *p, struct netif *inp)
         } else if(ip_addr_isany(&(lpcb->local_ip))) {
           /* found an ANY-match */
           lpcb_any = lpcb;
+#if !LWIP_PCB_HASH_SIZE
           lpcb_prev = prev;
+#endif /* !LWIP_PCB_HASH_SIZE */
         }
 #else /* SO_REUSE */
         if (ip_addr_cmp(&(lpcb->local_ip), &current_iphdr_dest) ||
@@ -244,17 +270,22 @@ tcp_input(struct pbuf *p, struct netif *inp)
         }
 #endif /* SO_REUSE */
       }
+#if !LWIP_PCB_HASH_SIZE
       prev = (struct tcp_pcb *)lpcb;
+#endif /* !LWIP_PCB_HASH_SIZE */
     }
 #if SO_REUSE
     /* first try specific local IP */
     if (lpcb == NULL) {
       /* only pass to ANY if no specific local IP has been found */
       lpcb = lpcb_any;
+#if !LWIP_PCB_HASH_SIZE
       prev = lpcb_prev;
+#endif /* !LWIP_PCB_HASH_SIZE */
     }
 #endif /* SO_REUSE */
     if (lpcb != NULL) {
+#if !LWIP_PCB_HASH_SIZE
       /* Move this PCB to the front of the list so that subsequent
          lookups will be faster (we exploit locality in TCP segment
          arrivals). */
@@ -265,6 +296,7 @@ tcp_input(struct pbuf *p, struct netif *inp)
               /* put this listening pcb at the head of the listening list */
         tcp_listen_pcbs.listen_pcbs = lpcb;
       }
+#endif /* !LWIP_PCB_HASH_SIZE */
     
       LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_input: packed for LISTENing connection.\n"));
       tcp_listen_input(lpcb);
@@ -635,6 +667,7 @@ tcp_process(struct tcp_pcb *pcb)
       pcb->snd_wnd = tcphdr->wnd;
       pcb->snd_wl1 = seqno - 1; /* initialise to seqno - 1 to force window update */
       pcb->state = ESTABLISHED;
+      tcp_quickack(pcb);
 
 #if TCP_CALCULATE_EFF_SEND_MSS
       pcb->mss = tcp_eff_send_mss(pcb->mss, &(pcb->remote_ip));
@@ -683,6 +716,7 @@ tcp_process(struct tcp_pcb *pcb)
       if (TCP_SEQ_BETWEEN(ackno, pcb->lastack+1, pcb->snd_nxt)) {
         u16_t old_cwnd;
         pcb->state = ESTABLISHED;
+        tcp_quickack(pcb);
         LWIP_DEBUGF(TCP_DEBUG, ("TCP connection established %"U16_F" -> %"U16_F".\n", inseg.tcphdr->src, inseg.tcphdr->dest));
 #if LWIP_CALLBACK_API
         LWIP_ASSERT("pcb->accept != NULL", pcb->accept != NULL);
@@ -1176,6 +1210,8 @@ tcp_receive(struct tcp_pcb *pcb)
 
         LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_receive: duplicate seqno %"U32_F"\n", seqno));
         tcp_ack_now(pcb);
+        /* the peer retransmitted, so it has restarted slow start */
+        tcp_quickack(pcb);
       }
     }
 
@@ -1339,6 +1375,8 @@ tcp_receive(struct tcp_pcb *pcb)
       } else {
         /* We get here if the incoming segment is out-of-sequence. */
         tcp_send_empty_ack(pcb);
+        /* ACK the segments that fill the hole without delay */
+        tcp_quickack(pcb);
 #if TCP_QUEUE_OOSEQ
         /* We queue the segment on the ->ooseq queue. */
         if (pcb->ooseq == NULL) {
@@ -78,6 +78,11 @@
 /* Forward declarations.*/
 static void tcp_output_segment(struct tcp_seg *seg, struct tcp_pcb *pcb);
 
+#if TCP_COALESCE_DEADLINE
+/** Set while tcp_coalesce_tmr() sends the data that was held back */
+static u8_t tcp_coalesce_flushing;
+#endif /* TCP_COALESCE_DEADLINE */
+
 /** Allocate a pbuf and create a tcphdr at p->payload, used for output
  * functions other than the default tcp_output -> tcp_output_segment
  * (e.g. tcp_send_empty_ack, etc.)
@@ -881,6 +886,52 @@ tcp_send_empty_ack(struct tcp_pcb *pcb)
   return ERR_OK;
 }
 
+#if TCP_COALESCE_DEADLINE
+/**
+ * Send-side coalescing: decide whether tcp_output() should hold back seg, the
+ * next unsent segment, so that further tcp_write() calls can still extend it.
+ * Only a lone data segment shorter than the MSS is held back, and never if
+ * - the Nagle algorithm is disabled (TF_NODELAY), or in fast recovery, or
+ * - an ACK is due now (it is cheaper to send it together with the data), or
+ * - the connection is being closed (TF_FIN), or a memerr needs to be recovered, or
+ * - the deadline passed (tcp_coalesce_tmr() is running)
+ *
+ * @param pcb Protocol control block for the TCP connection
+ * @param seg the first segment on pcb->unsent
+ * @return 1 if seg should be held back, 0 if it may be sent
+ */
+static u8_t
+tcp_coalesce_hold(struct tcp_pcb *pcb, struct tcp_seg *seg)
+{
+  if (tcp_coalesce_flushing ||
+      (seg->next != NULL) || (seg->len == 0) || (seg->len >= pcb->mss) ||
+      (pcb->flags & (TF_NODELAY | TF_INFR | TF_ACK_NOW | TF_FIN | TF_NAGLEMEMERR)) ||
+      (TCPH_FLAGS(seg->tcphdr) & (TCP_SYN | TCP_FIN))) {
+    return 0;
+  }
+  return 1;
+}
+
+/**
+ * Sends the data that tcp_output() held back for coalescing. Called
+ * TCP_COALESCE_DEADLINE ms after data was first held back.
+ */
+void
+tcp_coalesce_tmr(void)
+{
+  struct tcp_pcb *pcb;
+
+  tcp_coalesce_flushing = 1;
+  for (pcb = tcp_active_pcbs; pcb != NULL; pcb = pcb->next) {
+    if (pcb->unsent != NULL) {
+      LWIP_DEBUGF(TCP_OUTPUT_DEBUG, ("tcp_coalesce_tmr: flushing %p\n", (void *)pcb));
+      tcp_output(pcb);
+    }
+  }
+  tcp_coalesce_flushing = 0;
+}
+#endif /* TCP_COALESCE_DEADLINE */
+
 /**
  * Find out what we can send and send it
  *
@@ -964,6 +1015,13 @@ tcp_output(struct tcp_pcb *pcb)
       ((pcb->flags & (TF_NAGLEMEMERR | TF_FIN)) == 0)){
       break;
     }
+#if TCP_COALESCE_DEADLINE
+    /* Hold back a small segment until it fills up or the deadline passes */
+    if (tcp_coalesce_hold(pcb, seg)) {
+      tcp_coalesce_timer_needed();
+      break;
+    }
+#endif /* TCP_COALESCE_DEADLINE */
 #if TCP_CWND_DEBUG
     LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_output: snd_wnd %"U16_F", cwnd %"U16_F", wnd %"U32_F", effwnd %"U32_F", seq %"U32_F", ack %"U32_F", i %"S16_F"\n",
                             pcb->snd_wnd, pcb->cwnd, wnd,
@@ -68,6 +68,46 @@
 /* exported in udp.h (was static) */
 struct udp_pcb *udp_pcbs;
 
+#if LWIP_PCB_HASH_SIZE
+/** udp_pcbs hashed by local port, chained through hash_next */
+static struct udp_pcb *udp_pcb_hash[LWIP_PCB_HASH_SIZE];
+
+/**
+ * Add a pcb to the hash chain of its local port.
+ */
+static void
+udp_pcb_hash_add(struct udp_pcb *pcb)
+{
+  struct udp_pcb **chain = &udp_pcb_hash[LWIP_PCB_HASH(pcb->local_port)];
+
+  pcb->hash_next = *chain;
+  *chain = pcb;
+}
+
+/**
+ * Remove a pcb from the hash chain of its local port (if it is on it).
+ */
+static void
+udp_pcb_hash_remove(struct udp_pcb *pcb)
+{
+  struct udp_pcb **chain;
+
+  for (chain = &udp_pcb_hash[LWIP_PCB_HASH(pcb->local_port)]; *chain != NULL;
+       chain = &(*chain)->hash_next) {
+    if (*chain == pcb) {
+      *chain = pcb->hash_next;
+      break;
+    }
+  }
+  pcb->hash_next = NULL;
+}
+#define UDP_HASH_REG(pcb) udp_pcb_hash_add(pcb)
+#define UDP_HASH_RMV(pcb) udp_pcb_hash_remove(pcb)
+#else /* LWIP_PCB_HASH_SIZE */
+#define UDP_HASH_REG(pcb)
+#define UDP_HASH_RMV(pcb)
+#endif /* LWIP_PCB_HASH_SIZE */
+
 /**
  * Process an incoming UDP datagram.
  *
@@ -84,7 +124,10 @@ void
 udp_input(struct pbuf *p, struct netif *inp)
 {
   struct udp_hdr *udphdr;
-  struct udp_pcb *pcb, *prev;
+  struct udp_pcb *pcb;
+#if !LWIP_PCB_HASH_SIZE
+  struct udp_pcb *prev;
+#endif /* !LWIP_PCB_HASH_SIZE */
   struct udp_pcb *uncon_pcb;
   struct ip_hdr *iphdr;
   u16_t src, dest;
@@ -152,14 +195,20 @@ udp_input(struct pbuf *p, struct netif *inp)
   } else
 #endif /* LWIP_DHCP */
   {
+#if !LWIP_PCB_HASH_SIZE
     prev = NULL;
+#endif /* !LWIP_PCB_HASH_SIZE */
     local_match = 0;
     uncon_pcb = NULL;
     /* Iterate through the UDP pcb list for a matching pcb.
      * 'Perfect match' pcbs (connected to the remote port & ip address) are
      * preferred. If no perfect match is found, the first unconnected pcb that
      * matches the local port and ip address gets the datagram. */
+#if LWIP_PCB_HASH_SIZE
+    for (pcb = udp_pcb_hash[LWIP_PCB_HASH(dest)]; pcb != NULL; pcb = pcb->hash_next) {
+#else /* LWIP_PCB_HASH_SIZE */
     for (pcb = udp_pcbs; pcb != NULL; pcb = pcb->next) {
+#endif /* LWIP_PCB_HASH_SIZE */
       local_match = 0;
       /* print the PCB local and remote address */
       LWIP_DEBUGF(UDP_DEBUG,
@@ -195,6 +244,7 @@ udp_input(struct pbuf *p, struct netif *inp)
           (ip_addr_isany(&pcb->remote_ip) ||
            ip_addr_cmp(&(pcb->remote_ip), &current_iphdr_src))) {
         /* the first fully matching PCB */
+#if !LWIP_PCB_HASH_SIZE
         if (prev != NULL) {
           /* move the pcb to the front of udp_pcbs so that is
              found faster next time */
@@ -204,9 +254,12 @@ udp_input(struct pbuf *p, struct netif *inp)
         } else {
           UDP_STATS_INC(udp.cachehit);
         }
+#endif /* !LWIP_PCB_HASH_SIZE */
         break;
       }
+#if !LWIP_PCB_HASH_SIZE
       prev = pcb;
+#endif /* !LWIP_PCB_HASH_SIZE */
     }
     /* no fully matching pcb found? then look for an unconnected pcb */
     if (pcb == NULL) {
@@ -770,7 +823,12 @@ udp_bind(struct udp_pcb *pcb, ip_addr_t *ipaddr, u16_t port)
       return ERR_USE;
     }
   }
+  if (rebind != 0) {
+    /* the hash chain depends on the port */
+    UDP_HASH_RMV(pcb);
+  }
   pcb->local_port = port;
+  UDP_HASH_REG(pcb);
   snmp_insert_udpidx_tree(pcb);
   /* pcb not active yet? */
   if (rebind == 0) {
@@ -852,6 +910,7 @@ udp_connect(struct udp_pcb *pcb, ip_addr_t *ipaddr, u16_t port)
   /* PCB not yet on the list, add PCB now */
   pcb->next = udp_pcbs;
   udp_pcbs = pcb;
+  UDP_HASH_REG(pcb);
   return ERR_OK;
 }
 
@@ -901,6 +960,7 @@ udp_remove(struct udp_pcb *pcb)
   struct udp_pcb *pcb2;
 
   snmp_delete_udpidx_tree(pcb);
+  UDP_HASH_RMV(pcb);
   /* pcb to be removed is first in list? */
   if (udp_pcbs == pcb) {
     /* make list start at 2nd pcb */
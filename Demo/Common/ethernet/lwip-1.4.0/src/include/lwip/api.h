@@ -130,6 +130,21 @@ struct api_msg_msg;
 /** A callback prototype to inform about events for a netconn */
 typedef void (* netconn_callback)(struct netconn *, enum netconn_evt, u16_t len);
 
+#if LWIP_SOCKET_ZEROCOPY
+/** A callback prototype to tell that the data of a zero-copy send is no
+ *  longer referenced by the stack: err is ERR_OK once it has been sent (and,
+ *  for TCP, acknowledged), or the error that discarded it */
+typedef void (* netconn_zc_done_fn)(void *arg, err_t err);
+
+/** A zero-copy TCP write waiting for its acknowledgement */
+struct netconn_zc {
+  /** sequence number following the last byte of the write */
+  u32_t end;
+  netconn_zc_done_fn done;
+  void *arg;
+};
+#endif /* LWIP_SOCKET_ZEROCOPY */
+
 /** A netconn descriptor */
 struct netconn {
   /** type of the netconn (TCP, UDP or RAW) */
@@ -183,6 +198,12 @@ struct netconn {
       this temporarily stores the message.
       Also used during connect and close. */
   struct api_msg_msg *current_msg;
+#if LWIP_SOCKET_ZEROCOPY
+  /** TCP: zero-copy writes waiting to be acknowledged, oldest first */
+  struct netconn_zc zc[LWIP_SOCKET_ZEROCOPY_QUEUE];
+  u8_t zc_first;
+  u8_t zc_count;
+#endif /* LWIP_SOCKET_ZEROCOPY */
 #endif /* LWIP_TCP */
   /** A callback function that is informed about events for this netconn */
   netconn_callback callback;
@@ -232,6 +253,10 @@ err_t   netconn_sendto(struct netconn *conn, struct netbuf *buf,
 err_t   netconn_send(struct netconn *conn, struct netbuf *buf);
 err_t   netconn_write(struct netconn *conn, const void *dataptr, size_t size,
                       u8_t apiflags);
+#if LWIP_SOCKET_ZEROCOPY
+err_t   netconn_write_zc(struct netconn *conn, const void *dataptr, size_t size,
+                         u8_t apiflags, netconn_zc_done_fn done, void *arg);
+#endif /* LWIP_SOCKET_ZEROCOPY */
 err_t   netconn_close(struct netconn *conn);
 err_t   netconn_shutdown(struct netconn *conn, u8_t shut_rx, u8_t shut_tx);
 
@@ -89,6 +89,10 @@ struct api_msg_msg {
       const void *dataptr;
       size_t len;
       u8_t apiflags;
+#if LWIP_SOCKET_ZEROCOPY
+      netconn_zc_done_fn done;
+      void *done_arg;
+#endif /* LWIP_SOCKET_ZEROCOPY */
     } w;
     /** used for do_recv */
     struct {
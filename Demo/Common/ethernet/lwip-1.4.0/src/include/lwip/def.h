@@ -43,6 +43,11 @@ extern "C" {
 #define LWIP_MAX(x , y)  (((x) > (y)) ? (x) : (y))
 #define LWIP_MIN(x , y)  (((x) < (y)) ? (x) : (y))
 
+/** Index of the bucket for a 32-bit key in a table of LWIP_PCB_HASH_SIZE
+ * buckets (multiplicative hashing: the middle bits of key * 2^32/phi) */
+#define LWIP_PCB_HASH(key) \
+  ((u16_t)(((u32_t)((u32_t)(key) * 2654435761UL) >> 16) & (LWIP_PCB_HASH_SIZE - 1)))
+
 #ifndef NULL
 #define NULL ((void *)0)
 #endif
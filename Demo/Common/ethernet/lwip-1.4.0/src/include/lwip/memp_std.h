@@ -60,6 +60,9 @@ LWIP_MEMPOOL(NETCONN,        MEMP_NUM_NETCONN,         sizeof(struct netconn),
 LWIP_MEMPOOL(TCPIP_MSG_API,  MEMP_NUM_TCPIP_MSG_API,   sizeof(struct tcpip_msg),      "TCPIP_MSG_API")
 #if !LWIP_TCPIP_CORE_LOCKING_INPUT
 LWIP_MEMPOOL(TCPIP_MSG_INPKT,MEMP_NUM_TCPIP_MSG_INPKT, sizeof(struct tcpip_msg),      "TCPIP_MSG_INPKT")
+#if TCPIP_INPUT_BATCH_SIZE
+LWIP_MEMPOOL(TCPIP_MSG_INBATCH,MEMP_NUM_TCPIP_MSG_INBATCH, TCPIP_MSG_INBATCH_SIZE,     "TCPIP_MSG_INBATCH")
+#endif /* TCPIP_INPUT_BATCH_SIZE */
 #endif /* !LWIP_TCPIP_CORE_LOCKING_INPUT */
 #endif /* NO_SYS==0 */
 
@@ -214,6 +214,9 @@ struct netif {
 #endif /* LWIP_IGMP */
 #if LWIP_NETIF_HWADDRHINT
   u8_t *addr_hint;
+#elif LWIP_ARP && ETHARP_HASH_SIZE
+  /** ARP table entry last used to send on this interface */
+  u8_t arp_hint;
 #endif /* LWIP_NETIF_HWADDRHINT */
 #if ENABLE_LOOPBACK
   /* List of packets to be queued for ourselves. */
@@ -162,6 +162,18 @@
 #define MEMP_SANITY_CHECK               0
 #endif
 
+/**
+ * MEMP_LOCKFREE==1: memp_malloc() and memp_free() update each pool with an
+ * atomic compare-and-swap instead of SYS_ARCH_PROTECT, so allocating a pbuf
+ * or TCP segment no longer masks interrupts. The port's arch/sys_arch.h must
+ * define SYS_ARCH_CAS32(ptr, expected, desired), returning non-zero if *ptr
+ * was expected and has been set to desired (LDREX/STREX on ARMv7-M).
+ * With MEMP_STATS==1 the statistics are still updated with SYS_ARCH_PROTECT.
+ */
+#ifndef MEMP_LOCKFREE
+#define MEMP_LOCKFREE                   0
+#endif
+
 /**
  * MEM_USE_POOLS==1: Use an alternative to malloc() by allocating from a set
  * of memory pools of various sizes. When mem_malloc is called, an element of
@@ -259,6 +271,19 @@
 #define MEMP_NUM_TCP_PCB_LISTEN         8
 #endif
 
+/**
+ * LWIP_PCB_HASH_SIZE > 0: Besides their lists, keep TCP and UDP PCBs in hash
+ * tables with this many buckets (must be a power of 2), so that tcp_input()
+ * and udp_input() find the PCB of an incoming segment without walking all
+ * PCBs. Active and TIME-WAIT TCP PCBs are hashed by remote address and both
+ * ports, listening TCP PCBs and UDP PCBs by local port. Costs one pointer per
+ * PCB and three (TCP) plus one (UDP) tables of pointers. Makes sense with
+ * more than a few dozen PCBs.
+ */
+#ifndef LWIP_PCB_HASH_SIZE
+#define LWIP_PCB_HASH_SIZE              0
+#endif
+
 /**
  * MEMP_NUM_TCP_SEG: the number of simultaneously queued TCP segments.
  * (requires the LWIP_TCP option)
@@ -348,6 +373,15 @@
 #define MEMP_NUM_TCPIP_MSG_INPKT        8
 #endif
 
+/**
+ * MEMP_NUM_TCPIP_MSG_INBATCH: the number of struct tcpip_msg, which are used
+ * for batches of incoming packets (see TCPIP_INPUT_BATCH_SIZE).
+ * (only needed if you use tcpip.c)
+ */
+#ifndef MEMP_NUM_TCPIP_MSG_INBATCH
+#define MEMP_NUM_TCPIP_MSG_INBATCH      4
+#endif
+
 /**
  * MEMP_NUM_SNMP_NODE: the number of leafs in the SNMP tree.
  */
@@ -489,6 +523,27 @@
 #define ETHARP_SUPPORT_STATIC_ENTRIES   0
 #endif
 
+/**
+ * ETHARP_HASH_SIZE: Number of hash buckets (a power of 2) used to look up
+ * ARP table entries by IP address. Set this to 0 to scan the whole table on
+ * every lookup. With hashing, the last entry used for sending is remembered
+ * per netif (unless LWIP_NETIF_HWADDRHINT remembers it per pcb).
+ */
+#ifndef ETHARP_HASH_SIZE
+#define ETHARP_HASH_SIZE                0
+#endif
+
+/**
+ * ETHARP_LOCKFREE_READ==1: enable etharp_get_ethaddr(), which looks up the
+ * hardware address of an IP address from any thread without locking the
+ * core. Writers bump a sequence counter and readers retry if it changed
+ * during the lookup. The port's arch/sys_arch.h must define
+ * SYS_ARCH_MEMORY_BARRIER().
+ */
+#ifndef ETHARP_LOCKFREE_READ
+#define ETHARP_LOCKFREE_READ            0
+#endif
+
 
 /*
    --------------------------------
@@ -1012,6 +1067,34 @@
 #define TCP_OVERSIZE                    TCP_MSS
 #endif
 
+/**
+ * TCP_COALESCE_DEADLINE > 0: tcp_output() holds back the last unsent segment
+ * while it is shorter than the MSS, so that further small tcp_write() calls
+ * are merged into it instead of each going out in a packet of its own. Held
+ * data is sent at the latest TCP_COALESCE_DEADLINE milliseconds later, or
+ * earlier if the segment fills up, an ACK is due (the data carries it), or
+ * the connection is closed. Connections with TF_NODELAY set (tcp_nagle_disable)
+ * are never held back.
+ * Unlike the Nagle algorithm, this also applies when no data is in flight.
+ * The deadline uses one more sys_timeout (see MEMP_NUM_SYS_TIMEOUT). Without
+ * LWIP_TIMERS, tcp_coalesce_tmr() must be called at least every
+ * TCP_COALESCE_DEADLINE milliseconds instead.
+ */
+#ifndef TCP_COALESCE_DEADLINE
+#define TCP_COALESCE_DEADLINE           0
+#endif
+
+/**
+ * TCP_QUICKACK_SEGS > 0: Acknowledge this many received segments immediately
+ * (instead of every second one) after a connection is established and after
+ * out-of-order or duplicate data was received, i.e. while the peer is in slow
+ * start or recovering from a loss and needs every ACK to open its congestion
+ * window. Afterwards delayed ACKs are used again.
+ */
+#ifndef TCP_QUICKACK_SEGS
+#define TCP_QUICKACK_SEGS               0
+#endif
+
 /**
  * LWIP_TCP_TIMESTAMPS==1: support the TCP timestamp option.
  */
@@ -1159,6 +1242,16 @@
 #define LWIP_NETIF_TX_SINGLE_PBUF             0
 #endif /* LWIP_NETIF_TX_SINGLE_PBUF */
 
+/**
+ * LWIP_NETIF_RX_ZEROCOPY==1: Compile netif/rxbuf.c, which lets a driver pass
+ * its receive (DMA) buffers to the stack as custom PBUF_REF pbufs instead of
+ * copying each frame into PBUF_POOL pbufs. A buffer is handed back to the
+ * driver through a callback once the stack frees the pbuf.
+ */
+#ifndef LWIP_NETIF_RX_ZEROCOPY
+#define LWIP_NETIF_RX_ZEROCOPY                0
+#endif /* LWIP_NETIF_RX_ZEROCOPY */
+
 /*
    ------------------------------------
    ---------- LOOPIF options ----------
@@ -1222,6 +1315,17 @@
 #define TCPIP_MBOX_SIZE                 0
 #endif
 
+/**
+ * TCPIP_INPUT_BATCH_SIZE > 0: Enable tcpip_input_batch(), which lets a netif
+ * driver pass up to this many received packets to the tcpip thread with a
+ * single message. The tcpip thread then processes the whole batch before it
+ * blocks on its mailbox again, so a flood of small packets costs one mailbox
+ * operation (and at most one context switch) per batch instead of per packet.
+ */
+#ifndef TCPIP_INPUT_BATCH_SIZE
+#define TCPIP_INPUT_BATCH_SIZE          0
+#endif
+
 /**
  * SLIPIF_THREAD_NAME: The name assigned to the slipif_loop thread.
  */
@@ -1443,6 +1547,27 @@
 #define SO_REUSE_RXTOALL                0
 #endif
 
+/**
+ * LWIP_SOCKET_ZEROCOPY==1: Enable lwip_recv_zc(), which hands the received
+ * pbuf chain to the application instead of copying it, and lwip_send_zc(),
+ * which sends from a buffer owned by the application and calls back once
+ * the stack no longer references it (for TCP: once the peer acknowledged
+ * the data). Closing a TCP socket waits until its zero-copy sends are
+ * acknowledged.
+ */
+#ifndef LWIP_SOCKET_ZEROCOPY
+#define LWIP_SOCKET_ZEROCOPY            0
+#endif
+
+/**
+ * LWIP_SOCKET_ZEROCOPY_QUEUE: Number of zero-copy sends a TCP netconn can
+ * have waiting for acknowledgement. Further lwip_send_zc() calls fail with
+ * ENOMEM until one of them completes.
+ */
+#ifndef LWIP_SOCKET_ZEROCOPY_QUEUE
+#define LWIP_SOCKET_ZEROCOPY_QUEUE      4
+#endif
+
 /*
    ----------------------------------------
    ---------- Statistics options ----------
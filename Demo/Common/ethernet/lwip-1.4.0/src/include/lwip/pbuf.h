@@ -40,9 +40,9 @@
 extern "C" {
 #endif
 
-/** Currently, the pbuf_custom code is only needed for one specific configuration
- * of IP_FRAG */
-#define LWIP_SUPPORT_CUSTOM_PBUF (IP_FRAG && !IP_FRAG_USES_STATIC_BUF && !LWIP_NETIF_TX_SINGLE_PBUF)
+/** The pbuf_custom code is needed for zero-copy receive and send and for one
+ * specific configuration of IP_FRAG */
+#define LWIP_SUPPORT_CUSTOM_PBUF (LWIP_NETIF_RX_ZEROCOPY || LWIP_SOCKET_ZEROCOPY || (IP_FRAG && !IP_FRAG_USES_STATIC_BUF && !LWIP_NETIF_TX_SINGLE_PBUF))
 
 #define PBUF_TRANSPORT_HLEN 20
 #define PBUF_IP_HLEN        20
@@ -113,6 +113,10 @@ struct pbuf_custom {
   struct pbuf pbuf;
   /** This function is called when pbuf_free deallocates this pbuf(_custom) */
   pbuf_free_custom_fn custom_free_function;
+  /** The start of the buffer passed to pbuf_alloced_custom(). pbuf_header()
+      can grow a PBUF_REF custom pbuf back into it, as its headers are
+      written in place. */
+  void *payload_mem;
 };
 #endif /* LWIP_SUPPORT_CUSTOM_PBUF */
 
@@ -42,6 +42,10 @@
 
 #include "lwip/ip_addr.h"
 #include "lwip/inet.h"
+#if LWIP_SOCKET_ZEROCOPY
+#include "lwip/api.h"
+#include "lwip/pbuf.h"
+#endif /* LWIP_SOCKET_ZEROCOPY */
 
 #ifdef __cplusplus
 extern "C" {
@@ -339,6 +343,12 @@ int lwip_select(int maxfdp1, fd_set *readset, fd_set *writeset, fd_set *exceptse
                 struct timeval *timeout);
 int lwip_ioctl(int s, long cmd, void *argp);
 int lwip_fcntl(int s, int cmd, int val);
+#if LWIP_SOCKET_ZEROCOPY
+int lwip_recv_zc(int s, struct pbuf **p, int flags);
+void lwip_recv_zc_release(int s, struct pbuf *p);
+int lwip_send_zc(int s, const void *dataptr, size_t size, int flags,
+                 netconn_zc_done_fn done, void *arg);
+#endif /* LWIP_SOCKET_ZEROCOPY */
 
 #if LWIP_COMPAT_SOCKETS
 #define accept(a,b,c)         lwip_accept(a,b,c)
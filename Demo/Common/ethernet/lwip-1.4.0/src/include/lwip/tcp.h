@@ -151,11 +151,18 @@ enum tcp_state {
 #define DEF_ACCEPT_CALLBACK
 #endif /* LWIP_CALLBACK_API */
 
+#if LWIP_PCB_HASH_SIZE
+#define DEF_PCB_HASH_NEXT(type)  type *hash_next; /* for the hash chain */
+#else /* LWIP_PCB_HASH_SIZE */
+#define DEF_PCB_HASH_NEXT(type)
+#endif /* LWIP_PCB_HASH_SIZE */
+
 /**
  * members common to struct tcp_pcb and struct tcp_listen_pcb
  */
 #define TCP_PCB_COMMON(type) \
   type *next; /* for the linked list */ \
+  DEF_PCB_HASH_NEXT(type) \
   enum tcp_state state; /* TCP state */ \
   u8_t prio; \
   void *callback_arg; \
@@ -184,6 +191,9 @@ struct tcp_pcb {
 #define TF_FIN         ((u8_t)0x20U)   /* Connection was closed locally (FIN segment enqueued). */
 #define TF_NODELAY     ((u8_t)0x40U)   /* Disable Nagle algorithm */
 #define TF_NAGLEMEMERR ((u8_t)0x80U)   /* nagle enabled, memerr, try to output to prevent delayed ACK to happen */
+#if TCP_QUICKACK_SEGS
+  u8_t quickack;   /* number of segments still to be ACKed without delay */
+#endif /* TCP_QUICKACK_SEGS */
 
   /* the rest of the fields are in host byte order
      as we have to do some math with them */
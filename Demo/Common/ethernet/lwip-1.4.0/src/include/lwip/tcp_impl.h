@@ -59,6 +59,10 @@ void             tcp_tmr     (void);  /* Must be called every
    intervals (instead of calling tcp_tmr()). */
 void             tcp_slowtmr (void);
 void             tcp_fasttmr (void);
+#if TCP_COALESCE_DEADLINE
+void             tcp_coalesce_tmr(void); /* Sends data held back by
+                                            TCP_COALESCE_DEADLINE. */
+#endif /* TCP_COALESCE_DEADLINE */
 
 
 /* Only used by IP to pass a TCP segment to TCP: */
@@ -322,6 +326,27 @@ extern struct tcp_pcb *tcp_active_pcbs;  /* List of all TCP PCBs that are in a
               data. */
 extern struct tcp_pcb *tcp_tw_pcbs;      /* List of all TCP PCBs in TIME-WAIT. */
 
+#if LWIP_PCB_HASH_SIZE
+/* The same PCBs in hash tables, chained through hash_next. */
+extern struct tcp_pcb *tcp_active_hash[LWIP_PCB_HASH_SIZE];
+extern struct tcp_pcb *tcp_tw_hash[LWIP_PCB_HASH_SIZE];
+extern union tcp_listen_pcbs_t tcp_listen_hash[LWIP_PCB_HASH_SIZE];
+
+/** Bucket of a connection in tcp_active_hash and tcp_tw_hash */
+#define TCP_PCB_HASH(rip, rport, lport) \
+  LWIP_PCB_HASH(ip4_addr_get_u32(rip) ^ ((u32_t)(rport) << 16) ^ (u32_t)(lport))
+/** Bucket of a listening pcb in tcp_listen_hash */
+#define TCP_LISTEN_HASH(lport) LWIP_PCB_HASH(lport)
+
+void tcp_pcb_hash_add(struct tcp_pcb **pcbs, struct tcp_pcb *pcb);
+void tcp_pcb_hash_remove(struct tcp_pcb **pcbs, struct tcp_pcb *pcb);
+#define TCP_HASH_REG(pcbs, npcb) tcp_pcb_hash_add((pcbs), (npcb))
+#define TCP_HASH_RMV(pcbs, npcb) tcp_pcb_hash_remove((pcbs), (npcb))
+#else /* LWIP_PCB_HASH_SIZE */
+#define TCP_HASH_REG(pcbs, npcb)
+#define TCP_HASH_RMV(pcbs, npcb)
+#endif /* LWIP_PCB_HASH_SIZE */
+
 extern struct tcp_pcb *tcp_tmp_pcb;      /* Only used for temporary storage. */
 
 /* Axioms about the above lists:   
@@ -347,6 +372,7 @@ extern struct tcp_pcb *tcp_tmp_pcb;      /* Only used for temporary storage. */
                             (npcb)->next = *(pcbs); \
                             LWIP_ASSERT("TCP_REG: npcb->next != npcb", (npcb)->next != (npcb)); \
                             *(pcbs) = (npcb); \
+                            TCP_HASH_REG(pcbs, npcb); \
                             LWIP_ASSERT("TCP_RMV: tcp_pcbs sane", tcp_pcbs_sane()); \
               tcp_timer_needed(); \
                             } while(0)
@@ -362,6 +388,7 @@ extern struct tcp_pcb *tcp_tmp_pcb;      /* Only used for temporary storage. */
                                } \
                             } \
                             (npcb)->next = NULL; \
+                            TCP_HASH_RMV(pcbs, npcb); \
                             LWIP_ASSERT("TCP_RMV: tcp_pcbs sane", tcp_pcbs_sane()); \
                             LWIP_DEBUGF(TCP_DEBUG, ("TCP_RMV: removed %p from %p\n", (npcb), *(pcbs))); \
                             } while(0)
@@ -372,6 +399,7 @@ extern struct tcp_pcb *tcp_tmp_pcb;      /* Only used for temporary storage. */
   do {                                             \
     (npcb)->next = *pcbs;                          \
     *(pcbs) = (npcb);                              \
+    TCP_HASH_REG(pcbs, npcb);                      \
     tcp_timer_needed();                            \
   } while (0)
 
@@ -391,6 +419,7 @@ extern struct tcp_pcb *tcp_tmp_pcb;      /* Only used for temporary storage. */
       }                                            \
     }                                              \
     (npcb)->next = NULL;                           \
+    TCP_HASH_RMV(pcbs, npcb);                      \
   } while(0)
 
 #endif /* LWIP_DEBUG */
@@ -405,6 +434,25 @@ void tcp_segs_free(struct tcp_seg *seg);
 void tcp_seg_free(struct tcp_seg *seg);
 struct tcp_seg *tcp_seg_copy(struct tcp_seg *seg);
 
+#if TCP_QUICKACK_SEGS
+/** ACK the next TCP_QUICKACK_SEGS segments without delay */
+#define tcp_quickack(pcb)  ((pcb)->quickack = TCP_QUICKACK_SEGS)
+#define tcp_ack(pcb)                               \
+  do {                                             \
+    if(((pcb)->flags & TF_ACK_DELAY) ||            \
+       ((pcb)->quickack > 0)) {                    \
+      if((pcb)->quickack > 0) {                    \
+        (pcb)->quickack--;                         \
+      }                                            \
+      (pcb)->flags &= ~TF_ACK_DELAY;               \
+      (pcb)->flags |= TF_ACK_NOW;                  \
+    }                                              \
+    else {                                         \
+      (pcb)->flags |= TF_ACK_DELAY;                \
+    }                                              \
+  } while (0)
+#else /* TCP_QUICKACK_SEGS */
+#define tcp_quickack(pcb)
 #define tcp_ack(pcb)                               \
   do {                                             \
     if((pcb)->flags & TF_ACK_DELAY) {              \
@@ -415,6 +463,7 @@ struct tcp_seg *tcp_seg_copy(struct tcp_seg *seg);
       (pcb)->flags |= TF_ACK_DELAY;                \
     }                                              \
   } while (0)
+#endif /* TCP_QUICKACK_SEGS */
 
 #define tcp_ack_now(pcb)                           \
   do {                                             \
@@ -461,6 +510,12 @@ s16_t tcp_pcbs_sane(void);
  * that a timer is needed (i.e. active- or time-wait-pcb found). */
 void tcp_timer_needed(void);
 
+#if TCP_COALESCE_DEADLINE
+/** External function (implemented in timers.c), called when tcp_output()
+ * holds back data: calls tcp_coalesce_tmr() TCP_COALESCE_DEADLINE ms later. */
+void tcp_coalesce_timer_needed(void);
+#endif /* TCP_COALESCE_DEADLINE */
+
 
 #ifdef __cplusplus
 }
@@ -87,6 +87,9 @@ err_t tcpip_apimsg_lock(struct api_msg *apimsg);
 #endif /* LWIP_NETCONN */
 
 err_t tcpip_input(struct pbuf *p, struct netif *inp);
+#if TCPIP_INPUT_BATCH_SIZE
+err_t tcpip_input_batch(struct pbuf **p, u16_t num, struct netif *inp);
+#endif /* TCPIP_INPUT_BATCH_SIZE */
 
 #if LWIP_NETIF_API
 err_t tcpip_netifapi(struct netifapi_msg *netifapimsg);
@@ -112,6 +115,9 @@ enum tcpip_msg_type {
   TCPIP_MSG_API,
 #endif /* LWIP_NETCONN */
   TCPIP_MSG_INPKT,
+#if TCPIP_INPUT_BATCH_SIZE
+  TCPIP_MSG_INBATCH,
+#endif /* TCPIP_INPUT_BATCH_SIZE */
 #if LWIP_NETIF_API
   TCPIP_MSG_NETIFAPI,
 #endif /* LWIP_NETIF_API */
@@ -136,6 +142,14 @@ struct tcpip_msg {
       struct pbuf *p;
       struct netif *netif;
     } inp;
+#if TCPIP_INPUT_BATCH_SIZE
+    struct {
+      /** points to the packet array that follows the message */
+      struct pbuf **p;
+      u16_t num;
+      struct netif *netif;
+    } inbatch;
+#endif /* TCPIP_INPUT_BATCH_SIZE */
     struct {
       tcpip_callback_fn function;
       void *ctx;
@@ -150,6 +164,13 @@ struct tcpip_msg {
   } msg;
 };
 
+#if TCPIP_INPUT_BATCH_SIZE
+/** Size of a TCPIP_MSG_INBATCH message: the tcpip_msg followed by the array
+ * of packets */
+#define TCPIP_MSG_INBATCH_SIZE (sizeof(struct tcpip_msg) + \
+                                TCPIP_INPUT_BATCH_SIZE * sizeof(struct pbuf *))
+#endif /* TCPIP_INPUT_BATCH_SIZE */
+
 #ifdef __cplusplus
 }
 #endif
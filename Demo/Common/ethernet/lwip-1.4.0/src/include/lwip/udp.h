@@ -95,6 +95,10 @@ struct udp_pcb {
 /* Protocol specific PCB members */
 
   struct udp_pcb *next;
+#if LWIP_PCB_HASH_SIZE
+  /** for the hash chain of pcbs with the same local port hash */
+  struct udp_pcb *hash_next;
+#endif /* LWIP_PCB_HASH_SIZE */
 
   u8_t flags;
   /** ports are in host byte order */
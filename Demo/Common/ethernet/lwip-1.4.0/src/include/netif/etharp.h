@@ -182,6 +182,9 @@ struct etharp_q_entry {
 void etharp_tmr(void);
 s8_t etharp_find_addr(struct netif *netif, ip_addr_t *ipaddr,
          struct eth_addr **eth_ret, ip_addr_t **ip_ret);
+#if ETHARP_LOCKFREE_READ
+err_t etharp_get_ethaddr(ip_addr_t *ipaddr, struct eth_addr *ethaddr);
+#endif /* ETHARP_LOCKFREE_READ */
 err_t etharp_output(struct netif *netif, struct pbuf *q, ip_addr_t *ipaddr);
 err_t etharp_query(struct netif *netif, ip_addr_t *ipaddr, struct pbuf *q);
 err_t etharp_request(struct netif *netif, ip_addr_t *ipaddr);
@@ -0,0 +1,101 @@
+/**
+ * @file
+ * Zero-copy receive buffers for netif drivers
+ *
+ */
+
+/*
+ * Copyright (c) 2001-2004 Swedish Institute of Computer Science.
+ * All rights reserved. 
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT 
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING 
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ * 
+ * Author: Adam Dunkels <adam@sics.se>
+ *
+ */
+#ifndef __NETIF_RXBUF_H__
+#define __NETIF_RXBUF_H__
+
+#include "lwip/opt.h"
+
+#if LWIP_NETIF_RX_ZEROCOPY /* don't build if not configured for use in lwipopts.h */
+
+#include "lwip/pbuf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct rxbuf;
+
+/** Called when the stack has freed the pbuf wrapping a receive buffer (or at
+ * once if the frame was copied), so the driver can give the buffer back to
+ * its DMA ring. Called from whichever thread frees the pbuf, so it must be
+ * safe against the driver's receive path. */
+typedef void (*rxbuf_release_fn)(struct rxbuf *buf);
+
+/** One of a driver's receive buffers. */
+struct rxbuf {
+  /** The pbuf lent to the stack: must be the first member */
+  struct pbuf_custom pc;
+  /** The pool this buffer belongs to */
+  struct rxbuf_pool *pool;
+  /** The buffer memory. The frame starts ETH_PAD_SIZE bytes into it. */
+  void *mem;
+  /** Size of 'mem' in bytes */
+  u16_t mem_len;
+  /** For the driver, e.g. the index of the ring descriptor */
+  void *arg;
+};
+
+/** The receive buffers of one driver. */
+struct rxbuf_pool {
+  /** Gives a freed buffer back to the driver */
+  rxbuf_release_fn release;
+  /** Number of buffers currently lent to the stack */
+  u16_t lent;
+  /** When this many buffers are lent, frames are copied into PBUF_POOL
+   * pbufs and the buffer is released at once. This stops a stack that holds
+   * on to frames (e.g. TCP out-of-sequence queues) from emptying the ring. */
+  u16_t copy_threshold;
+  /** Frames passed without copying */
+  u32_t zerocopy;
+  /** Frames copied because copy_threshold was reached */
+  u32_t copied;
+};
+
+void rxbuf_pool_init(struct rxbuf_pool *pool, rxbuf_release_fn release,
+                     u16_t copy_threshold);
+void rxbuf_init(struct rxbuf_pool *pool, struct rxbuf *buf, void *mem,
+                u16_t mem_len, void *arg);
+struct pbuf *rxbuf_pbuf(struct rxbuf *buf, u16_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LWIP_NETIF_RX_ZEROCOPY */
+
+#endif /* __NETIF_RXBUF_H__ */
@@ -52,6 +52,7 @@
 #include "lwip/ip.h"
 #include "lwip/stats.h"
 #include "lwip/snmp.h"
+#include "lwip/sys.h"
 #include "lwip/dhcp.h"
 #include "lwip/autoip.h"
 #include "netif/etharp.h"
@@ -107,13 +108,43 @@ struct etharp_entry {
 #if ETHARP_SUPPORT_STATIC_ENTRIES
   u8_t static_entry;
 #endif /* ETHARP_SUPPORT_STATIC_ENTRIES */
+#if ETHARP_HASH_SIZE
+  /** index + 1 of the next entry in the same hash chain, 0 ends the chain */
+  u8_t hash_next;
+#endif /* ETHARP_HASH_SIZE */
 };
 
 static struct etharp_entry arp_table[ARP_TABLE_SIZE];
 
-#if !LWIP_NETIF_HWADDRHINT
+#if ETHARP_HASH_SIZE
+/** index + 1 of the first entry of each hash chain, 0 for an empty chain.
+ *  Every entry that find_entry() gave an IP address is on the chain of that
+ *  address until free_entry() recycles it. */
+static u8_t arp_hash[ETHARP_HASH_SIZE];
+#endif /* ETHARP_HASH_SIZE */
+
+#if !LWIP_NETIF_HWADDRHINT && !ETHARP_HASH_SIZE
 static u8_t etharp_cached_entry;
-#endif /* !LWIP_NETIF_HWADDRHINT */
+#endif /* !LWIP_NETIF_HWADDRHINT && !ETHARP_HASH_SIZE */
+
+#if ETHARP_LOCKFREE_READ
+#if NO_SYS && !defined(SYS_ARCH_MEMORY_BARRIER)
+#define SYS_ARCH_MEMORY_BARRIER()
+#endif /* NO_SYS && !defined(SYS_ARCH_MEMORY_BARRIER) */
+/** Incremented before and after every change that etharp_get_ethaddr() could
+ *  see, so it is odd while the table is being changed. Changes are made with
+ *  SYS_ARCH_PROTECT held: on a single core, a reader never finds it odd. */
+static volatile u32_t arp_table_seq;
+#define ETHARP_WRITE_DECL()   SYS_ARCH_DECL_PROTECT(lev)
+#define ETHARP_WRITE_BEGIN()  do { SYS_ARCH_PROTECT(lev); arp_table_seq++; \
+                                   SYS_ARCH_MEMORY_BARRIER(); } while(0)
+#define ETHARP_WRITE_END()    do { SYS_ARCH_MEMORY_BARRIER(); arp_table_seq++; \
+                                   SYS_ARCH_UNPROTECT(lev); } while(0)
+#else /* ETHARP_LOCKFREE_READ */
+#define ETHARP_WRITE_DECL()
+#define ETHARP_WRITE_BEGIN()
+#define ETHARP_WRITE_END()
+#endif /* ETHARP_LOCKFREE_READ */
 
 /** Try hard to create a new entry - we want the IP address to appear in
     the cache (even if this means removing an active entry or so). */
@@ -124,6 +155,8 @@ static u8_t etharp_cached_entry;
 #if LWIP_NETIF_HWADDRHINT
 #define ETHARP_SET_HINT(netif, hint)  if (((netif) != NULL) && ((netif)->addr_hint != NULL))  \
                                       *((netif)->addr_hint) = (hint);
+#elif ETHARP_HASH_SIZE
+#define ETHARP_SET_HINT(netif, hint)  ((netif)->arp_hint = (hint))
 #else /* LWIP_NETIF_HWADDRHINT */
 #define ETHARP_SET_HINT(netif, hint)  (etharp_cached_entry = (hint))
 #endif /* LWIP_NETIF_HWADDRHINT */
@@ -164,10 +197,69 @@ free_etharp_q(struct etharp_q_entry *q)
 
 #endif /* ARP_QUEUEING */
 
+#if ETHARP_HASH_SIZE
+/**
+ * Hash an IP address to its arp_hash chain. All four bytes are folded
+ * together, so that neighbours on the same subnet land on different chains.
+ */
+static u16_t
+etharp_hash(ip_addr_t *ipaddr)
+{
+  u32_t h = ip4_addr_get_u32(ipaddr);
+  h ^= h >> 16;
+  h ^= h >> 8;
+  return (u16_t)(h & (ETHARP_HASH_SIZE - 1));
+}
+
+/** Put ARP table entry i on the hash chain of its IP address */
+static void
+etharp_hash_add(u8_t i)
+{
+  u16_t bucket = etharp_hash(&arp_table[i].ipaddr);
+  arp_table[i].hash_next = arp_hash[bucket];
+  arp_hash[bucket] = (u8_t)(i + 1);
+}
+
+/** Take ARP table entry i off the hash chain of its IP address (if it is on it) */
+static void
+etharp_hash_remove(u8_t i)
+{
+  u8_t *link = &arp_hash[etharp_hash(&arp_table[i].ipaddr)];
+  while (*link != 0) {
+    if (*link == i + 1) {
+      *link = arp_table[i].hash_next;
+      return;
+    }
+    link = &arp_table[*link - 1].hash_next;
+  }
+}
+
+/**
+ * Find the ARP table entry of an IP address on its hash chain.
+ *
+ * @return the entry index, -1 if there is no entry for ipaddr
+ */
+static s8_t
+etharp_hash_find(ip_addr_t *ipaddr)
+{
+  u8_t n;
+  u8_t i = arp_hash[etharp_hash(ipaddr)];
+  /* bounded, since a lock-free reader may see a chain that is being changed */
+  for (n = 0; (i != 0) && (n < ARP_TABLE_SIZE); n++) {
+    if (ip_addr_cmp(ipaddr, &arp_table[i - 1].ipaddr)) {
+      return (s8_t)(i - 1);
+    }
+    i = arp_table[i - 1].hash_next;
+  }
+  return -1;
+}
+#endif /* ETHARP_HASH_SIZE */
+
 /** Clean up ARP table entries */
 static void
 free_entry(int i)
 {
+  ETHARP_WRITE_DECL();
   /* remove from SNMP ARP index tree */
   snmp_delete_arpidx_tree(arp_table[i].netif, &arp_table[i].ipaddr);
   /* and empty packet queue */
@@ -177,6 +269,10 @@ free_entry(int i)
     free_etharp_q(arp_table[i].q);
     arp_table[i].q = NULL;
   }
+  ETHARP_WRITE_BEGIN();
+#if ETHARP_HASH_SIZE
+  etharp_hash_remove((u8_t)i);
+#endif /* ETHARP_HASH_SIZE */
   /* recycle entry for re-use */      
   arp_table[i].state = ETHARP_STATE_EMPTY;
 #if ETHARP_SUPPORT_STATIC_ENTRIES
@@ -191,6 +287,7 @@ free_entry(int i)
   ip_addr_set_zero(&arp_table[i].ipaddr);
   arp_table[i].ethaddr = ethzero;
 #endif /* LWIP_DEBUG */
+  ETHARP_WRITE_END();
 }
 
 /**
@@ -264,6 +361,22 @@ find_entry(ip_addr_t *ipaddr, u8_t flags)
   s8_t old_queue = ARP_TABLE_SIZE;
   /* its age */
   u8_t age_queue = 0;
+  ETHARP_WRITE_DECL();
+
+#if ETHARP_HASH_SIZE
+  /* entries are hashed by IP address, so a match is found on its chain and
+   * the sweep below is only needed to create a new entry */
+  if (ipaddr != NULL) {
+    s8_t match = etharp_hash_find(ipaddr);
+    if (match >= 0) {
+      LWIP_DEBUGF(ETHARP_DEBUG | LWIP_DBG_TRACE, ("find_entry: found matching entry %"U16_F"\n", (u16_t)match));
+      return match;
+    }
+    if ((flags & ETHARP_FLAG_FIND_ONLY) != 0) {
+      return (s8_t)ERR_MEM;
+    }
+  }
+#endif /* ETHARP_HASH_SIZE */
 
   /**
    * a) do a search through the cache, remember candidates
@@ -386,8 +499,13 @@ find_entry(ip_addr_t *ipaddr, u8_t flags)
 
   /* IP address given? */
   if (ipaddr != NULL) {
+    ETHARP_WRITE_BEGIN();
     /* set IP address */
     ip_addr_copy(arp_table[i].ipaddr, *ipaddr);
+#if ETHARP_HASH_SIZE
+    etharp_hash_add(i);
+#endif /* ETHARP_HASH_SIZE */
+    ETHARP_WRITE_END();
   }
   arp_table[i].ctime = 0;
 #if ETHARP_SUPPORT_STATIC_ENTRIES
@@ -443,6 +561,7 @@ static err_t
 update_arp_entry(struct netif *netif, ip_addr_t *ipaddr, struct eth_addr *ethaddr, u8_t flags)
 {
   s8_t i;
+  ETHARP_WRITE_DECL();
   LWIP_ASSERT("netif->hwaddr_len == ETHARP_HWADDR_LEN", netif->hwaddr_len == ETHARP_HWADDR_LEN);
   LWIP_DEBUGF(ETHARP_DEBUG | LWIP_DBG_TRACE, ("update_arp_entry: %"U16_F".%"U16_F".%"U16_F".%"U16_F" - %02"X16_F":%02"X16_F":%02"X16_F":%02"X16_F":%02"X16_F":%02"X16_F"\n",
     ip4_addr1_16(ipaddr), ip4_addr2_16(ipaddr), ip4_addr3_16(ipaddr), ip4_addr4_16(ipaddr),
@@ -469,6 +588,7 @@ update_arp_entry(struct netif *netif, ip_addr_t *ipaddr, struct eth_addr *ethadd
   }
 #endif /* ETHARP_SUPPORT_STATIC_ENTRIES */
 
+  ETHARP_WRITE_BEGIN();
   /* mark it stable */
   arp_table[i].state = ETHARP_STATE_STABLE;
 
@@ -482,6 +602,7 @@ update_arp_entry(struct netif *netif, ip_addr_t *ipaddr, struct eth_addr *ethadd
   LWIP_DEBUGF(ETHARP_DEBUG | LWIP_DBG_TRACE, ("update_arp_entry: updating stable entry %"S16_F"\n", (s16_t)i));
   /* update address */
   ETHADDR32_COPY(&arp_table[i].ethaddr, ethaddr);
+  ETHARP_WRITE_END();
   /* reset time stamp */
   arp_table[i].ctime = 0;
   /* this is where we will send out queued packets! */
@@ -599,6 +720,50 @@ etharp_find_addr(struct netif *netif, ip_addr_t *ipaddr,
   return -1;
 }
 
+#if ETHARP_LOCKFREE_READ
+/**
+ * Finds the ethernet address of a stable ARP table entry. Unlike
+ * etharp_find_addr(), this may be called from any thread or from an ISR
+ * without locking the stack: if the tcpip thread changes the table during
+ * the lookup, the lookup is repeated.
+ *
+ * @param ipaddr IP address to look up
+ * @param ethaddr where to copy the ethernet address
+ * @return ERR_OK if ipaddr has a stable entry, ERR_VAL otherwise
+ */
+err_t
+etharp_get_ethaddr(ip_addr_t *ipaddr, struct eth_addr *ethaddr)
+{
+  u32_t seq;
+  s8_t i;
+  err_t err;
+
+  do {
+    seq = arp_table_seq;
+    SYS_ARCH_MEMORY_BARRIER();
+    err = ERR_VAL;
+    if ((seq & 1) == 0) {
+#if ETHARP_HASH_SIZE
+      i = etharp_hash_find(ipaddr);
+#else /* ETHARP_HASH_SIZE */
+      for (i = ARP_TABLE_SIZE - 1; i >= 0; i--) {
+        if ((arp_table[i].state != ETHARP_STATE_EMPTY) &&
+            ip_addr_cmp(ipaddr, &arp_table[i].ipaddr)) {
+          break;
+        }
+      }
+#endif /* ETHARP_HASH_SIZE */
+      if ((i >= 0) && (arp_table[i].state == ETHARP_STATE_STABLE)) {
+        SMEMCPY(ethaddr, &arp_table[i].ethaddr, ETHARP_HWADDR_LEN);
+        err = ERR_OK;
+      }
+    }
+    SYS_ARCH_MEMORY_BARRIER();
+  } while (((seq & 1) != 0) || (seq != arp_table_seq));
+  return err;
+}
+#endif /* ETHARP_LOCKFREE_READ */
+
 #if ETHARP_TRUST_IP_MAC
 /**
  * Updates the ARP table using the given IP packet.
@@ -898,6 +1063,11 @@ etharp_output(struct netif *netif, struct pbuf *q, ip_addr_t *ipaddr)
       /* per-pcb cached entry was given */
       u8_t etharp_cached_entry = *(netif->addr_hint);
       if (etharp_cached_entry < ARP_TABLE_SIZE) {
+#elif ETHARP_HASH_SIZE
+    {
+      /* entry last used on this netif */
+      u8_t etharp_cached_entry = netif->arp_hint;
+      {
 #endif /* LWIP_NETIF_HWADDRHINT */
         if ((arp_table[etharp_cached_entry].state == ETHARP_STATE_STABLE) &&
             (ip_addr_cmp(ipaddr, &arp_table[etharp_cached_entry].ipaddr))) {
@@ -906,10 +1076,10 @@ etharp_output(struct netif *netif, struct pbuf *q, ip_addr_t *ipaddr)
           return etharp_send_ip(netif, q, (struct eth_addr*)(netif->hwaddr),
             &arp_table[etharp_cached_entry].ethaddr);
         }
-#if LWIP_NETIF_HWADDRHINT
+#if LWIP_NETIF_HWADDRHINT || ETHARP_HASH_SIZE
       }
     }
-#endif /* LWIP_NETIF_HWADDRHINT */
+#endif /* LWIP_NETIF_HWADDRHINT || ETHARP_HASH_SIZE */
     /* queue on destination Ethernet address belonging to ipaddr */
     return etharp_query(netif, ipaddr, q);
   }
@@ -55,6 +55,8 @@
 #include <lwip/snmp.h>
 #include "netif/etharp.h"
 #include "netif/ppp_oe.h"
+#include "netif/rxbuf.h"
+#include "lwip/tcpip.h"
 
 /* Define those to better describe your network interface. */
 #define IFNAME0 'e'
@@ -69,10 +71,17 @@
 struct ethernetif {
   struct eth_addr *ethaddr;
   /* Add whatever per-interface state that is needed here. */
+#if LWIP_NETIF_RX_ZEROCOPY
+  struct rxbuf_pool rx_pool;
+  struct rxbuf rx_bufs[RX_RING_SIZE];
+#endif /* LWIP_NETIF_RX_ZEROCOPY */
 };
 
 /* Forward declarations. */
 static void  ethernetif_input(struct netif *netif);
+#if TCPIP_INPUT_BATCH_SIZE
+static void  ethernetif_input_batch(struct netif *netif);
+#endif /* TCPIP_INPUT_BATCH_SIZE */
 
 /**
  * In this function, the hardware should be initialized.
@@ -85,6 +94,9 @@ static void
 low_level_init(struct netif *netif)
 {
   struct ethernetif *ethernetif = netif->state;
+#if LWIP_NETIF_RX_ZEROCOPY
+  int i;
+#endif /* LWIP_NETIF_RX_ZEROCOPY */
   
   /* set MAC hardware address length */
   netif->hwaddr_len = ETHARP_HWADDR_LEN;
@@ -102,6 +114,16 @@ low_level_init(struct netif *netif)
   netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_LINK_UP;
  
   /* Do whatever else is needed to initialize interface. */  
+
+#if LWIP_NETIF_RX_ZEROCOPY
+  /* Keep two descriptors for the MAC however long the stack holds on to
+     packets: beyond that, packets are copied. */
+  rxbuf_pool_init(&ethernetif->rx_pool, low_level_rx_release, RX_RING_SIZE - 2);
+  for (i = 0; i < RX_RING_SIZE; i++) {
+    rxbuf_init(&ethernetif->rx_pool, &ethernetif->rx_bufs[i], memory of descriptor i,
+               size of that memory, descriptor i);
+  }
+#endif /* LWIP_NETIF_RX_ZEROCOPY */
 }
 
 /**
@@ -150,6 +172,49 @@ low_level_output(struct netif *netif, struct pbuf *p)
   return ERR_OK;
 }
 
+#if LWIP_NETIF_RX_ZEROCOPY
+/**
+ * Called by the stack when it has finished with a receive buffer.
+ *
+ * @param buf the buffer to hand back to the MAC
+ */
+static void
+low_level_rx_release(struct rxbuf *buf)
+{
+  give buf->mem back to the descriptor buf->arg();
+}
+
+/**
+ * Zero-copy alternative to the low_level_input() below: the buffer the MAC
+ * received the packet into is passed to the stack, and is given back to the
+ * MAC by low_level_rx_release() once the stack has freed the pbuf.
+ *
+ * @param netif the lwip network interface structure for this ethernetif
+ * @return a pbuf referring to the received packet (including MAC header)
+ *         NULL on memory error
+ */
+static struct pbuf *
+low_level_input(struct netif *netif)
+{
+  struct ethernetif *ethernetif = netif->state;
+  struct pbuf *p;
+  u16_t len;
+  int i;
+
+  /* Obtain the index of the ring descriptor that holds the next packet and
+     the size of the packet (excluding ETH_PAD_SIZE). */
+  i = ;
+  len = ;
+
+  p = rxbuf_pbuf(&ethernetif->rx_bufs[i], len);
+
+  if (p != NULL) {
+    LINK_STATS_INC(link.recv);
+  }
+
+  return p;  
+}
+#else /* LWIP_NETIF_RX_ZEROCOPY */
 /**
  * Should allocate a pbuf and transfer the bytes of the incoming
  * packet from the interface into the pbuf.
@@ -210,6 +275,7 @@ low_level_input(struct netif *netif)
 
   return p;  
 }
+#endif /* LWIP_NETIF_RX_ZEROCOPY */
 
 /**
  * This function should be called when a packet is ready to be read
@@ -218,6 +284,9 @@ low_level_input(struct netif *netif)
  * interface. Then the type of the received packet is determined and
  * the appropriate input function is called.
  *
+ * If the interface was added with tcpip_input as input function, every
+ * packet it holds is read and passed on at once by ethernetif_input_batch().
+ *
  * @param netif the lwip network interface structure for this ethernetif
  */
 static void
@@ -227,6 +296,13 @@ ethernetif_input(struct netif *netif)
   struct eth_hdr *ethhdr;
   struct pbuf *p;
 
+#if TCPIP_INPUT_BATCH_SIZE
+  if (netif->input == tcpip_input) {
+    ethernetif_input_batch(netif);
+    return;
+  }
+#endif /* TCPIP_INPUT_BATCH_SIZE */
+
   ethernetif = netif->state;
 
   /* move received packet into a new pbuf */
@@ -260,6 +336,59 @@ ethernetif_input(struct netif *netif)
   }
 }
 
+#if TCPIP_INPUT_BATCH_SIZE
+/**
+ * Used by ethernetif_input() for a driver that is registered with
+ * tcpip_input as input function: reads every packet the interface holds (up
+ * to TCPIP_INPUT_BATCH_SIZE) and passes them to tcpip_thread with a single
+ * message. Under a flood of small packets this saves a mailbox operation and
+ * possibly a context switch per packet.
+ *
+ * @param netif the lwip network interface structure for this ethernetif
+ */
+static void
+ethernetif_input_batch(struct netif *netif)
+{
+  struct eth_hdr *ethhdr;
+  struct pbuf *p[TCPIP_INPUT_BATCH_SIZE];
+  u16_t num = 0, i;
+
+  while (num < TCPIP_INPUT_BATCH_SIZE) {
+    /* move received packet into a new pbuf */
+    p[num] = low_level_input(netif);
+    /* no more packets */
+    if (p[num] == NULL) break;
+    /* points to packet payload, which starts with an Ethernet header */
+    ethhdr = p[num]->payload;
+
+    switch (htons(ethhdr->type)) {
+    /* IP or ARP packet? */
+    case ETHTYPE_IP:
+    case ETHTYPE_ARP:
+#if PPPOE_SUPPORT
+    /* PPPoE packet? */
+    case ETHTYPE_PPPOEDISC:
+    case ETHTYPE_PPPOE:
+#endif /* PPPOE_SUPPORT */
+      num++;
+      break;
+
+    default:
+      pbuf_free(p[num]);
+      break;
+    }
+  }
+
+  /* all packets send to tcpip_thread to process */
+  if ((num > 0) && (tcpip_input_batch(p, num, netif) != ERR_OK)) {
+    LWIP_DEBUGF(NETIF_DEBUG, ("ethernetif_input_batch: IP input error\n"));
+    for (i = 0; i < num; i++) {
+      pbuf_free(p[i]);
+    }
+  }
+}
+#endif /* TCPIP_INPUT_BATCH_SIZE */
+
 /**
  * Should be called at the beginning of the program to set up the
  * network interface. It calls the function low_level_init() to do the
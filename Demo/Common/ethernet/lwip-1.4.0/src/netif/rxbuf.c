@@ -0,0 +1,180 @@
+/**
+ * @file
+ * Zero-copy receive buffers for netif drivers
+ *
+ * A driver whose MAC receives into a ring of buffers can pass each filled
+ * buffer to the stack as a PBUF_REF custom pbuf, instead of allocating a
+ * PBUF_POOL chain and copying the frame into it:
+ *
+ *   rxbuf_pool_init(&pool, release_to_ring, RX_RING_SIZE - 2);
+ *   for (i = 0; i < RX_RING_SIZE; i++) {
+ *     rxbuf_init(&pool, &bufs[i], ring_mem[i], sizeof(ring_mem[i]), &desc[i]);
+ *   }
+ *
+ *   // on receive, len excludes ETH_PAD_SIZE
+ *   p = rxbuf_pbuf(&bufs[i], len);
+ *   if ((p != NULL) && (netif->input(p, netif) != ERR_OK)) {
+ *     pbuf_free(p);
+ *   }
+ *
+ * When the stack frees the pbuf, release_to_ring() is called and the driver
+ * re-arms the descriptor. The buffer must not be reused before then.
+ *
+ */
+
+/*
+ * Copyright (c) 2001-2004 Swedish Institute of Computer Science.
+ * All rights reserved. 
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT 
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING 
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ * 
+ * Author: Adam Dunkels <adam@sics.se>
+ *
+ */
+
+#include "lwip/opt.h"
+
+#if LWIP_NETIF_RX_ZEROCOPY /* don't build if not configured for use in lwipopts.h */
+
+#include "lwip/pbuf.h"
+#include "lwip/sys.h"
+#include "lwip/stats.h"
+#include "netif/rxbuf.h"
+
+#include <string.h>
+
+/**
+ * Free-callback of the custom pbufs: return the buffer to its driver.
+ *
+ * @param p the pbuf (first member of a struct rxbuf) being freed
+ */
+static void
+rxbuf_free_custom(struct pbuf *p)
+{
+  struct rxbuf *buf = (struct rxbuf *)p;
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  SYS_ARCH_PROTECT(lev);
+  LWIP_ASSERT("rxbuf_free_custom: no buffer lent", buf->pool->lent > 0);
+  buf->pool->lent--;
+  SYS_ARCH_UNPROTECT(lev);
+
+  buf->pool->release(buf);
+}
+
+/**
+ * Initialize a driver's pool of receive buffers.
+ *
+ * @param pool the pool to initialize
+ * @param release called to give each buffer back to the driver
+ * @param copy_threshold number of buffers that may be lent to the stack at
+ *        once before frames are copied instead
+ */
+void
+rxbuf_pool_init(struct rxbuf_pool *pool, rxbuf_release_fn release,
+                u16_t copy_threshold)
+{
+  LWIP_ASSERT("rxbuf_pool_init: release != NULL", release != NULL);
+
+  pool->release = release;
+  pool->lent = 0;
+  pool->copy_threshold = copy_threshold;
+  pool->zerocopy = 0;
+  pool->copied = 0;
+}
+
+/**
+ * Initialize one receive buffer of a pool.
+ *
+ * @param pool the pool the buffer belongs to
+ * @param buf the buffer to initialize
+ * @param mem the memory the MAC receives into, aligned to MEM_ALIGNMENT
+ * @param mem_len size of 'mem' in bytes, including ETH_PAD_SIZE
+ * @param arg for the driver, e.g. the ring descriptor of the buffer
+ */
+void
+rxbuf_init(struct rxbuf_pool *pool, struct rxbuf *buf, void *mem,
+           u16_t mem_len, void *arg)
+{
+  LWIP_ASSERT("rxbuf_init: mem not aligned", mem == LWIP_MEM_ALIGN(mem));
+
+  buf->pool = pool;
+  buf->mem = mem;
+  buf->mem_len = mem_len;
+  buf->arg = arg;
+}
+
+/**
+ * Get a pbuf holding a frame the MAC has received into a buffer.
+ *
+ * Normally the pbuf refers to the buffer itself, and the buffer is released
+ * when the pbuf is freed. Once the pool's copy_threshold is reached the frame
+ * is copied into a PBUF_POOL pbuf and the buffer is released before this
+ * function returns.
+ *
+ * @param buf the buffer holding the frame, ETH_PAD_SIZE bytes into it
+ * @param len length of the frame, excluding ETH_PAD_SIZE
+ * @return a pbuf to pass to netif->input(), or NULL (the frame is dropped and
+ *         the buffer released) if a PBUF_POOL pbuf was needed but none was free
+ */
+struct pbuf *
+rxbuf_pbuf(struct rxbuf *buf, u16_t len)
+{
+  struct rxbuf_pool *pool = buf->pool;
+  struct pbuf *p;
+  u8_t lend;
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  LWIP_ASSERT("rxbuf_pbuf: frame larger than buffer", len + ETH_PAD_SIZE <= buf->mem_len);
+
+  SYS_ARCH_PROTECT(lev);
+  lend = (pool->lent < pool->copy_threshold);
+  if (lend) {
+    pool->lent++;
+  }
+  SYS_ARCH_UNPROTECT(lev);
+
+  if (lend) {
+    p = pbuf_alloced_custom(PBUF_RAW, len + ETH_PAD_SIZE, PBUF_REF, &buf->pc,
+                            buf->mem, buf->mem_len);
+    LWIP_ASSERT("rxbuf_pbuf: pbuf_alloced_custom failed", p != NULL);
+    buf->pc.custom_free_function = rxbuf_free_custom;
+    pool->zerocopy++;
+  } else {
+    p = pbuf_alloc(PBUF_RAW, len + ETH_PAD_SIZE, PBUF_POOL);
+    if (p != NULL) {
+      pbuf_take(p, buf->mem, len + ETH_PAD_SIZE);
+      pool->copied++;
+    } else {
+      LINK_STATS_INC(link.memerr);
+      LINK_STATS_INC(link.drop);
+    }
+    pool->release(buf);
+  }
+
+  return p;
+}
+
+#endif /* LWIP_NETIF_RX_ZEROCOPY */
@@ -0,0 +1,112 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+ * Application specific definitions.
+ *
+ * These definitions should be adjusted for your particular hardware and
+ * application requirements.
+ *
+ * THESE PARAMETERS ARE DESCRIBED WITHIN THE 'CONFIGURATION' SECTION OF THE
+ * FreeRTOS API DOCUMENTATION AVAILABLE ON THE FreeRTOS.org WEB SITE.
+ *
+ * See http://www.freertos.org/a00110.html
+ *----------------------------------------------------------*/
+
+/* The number of cores, and whether each core has its own ready lists, can be
+ * set on the make command line (make CORES=2 PER_CORE_READY_LISTS=1). */
+#ifndef configNUMBER_OF_CORES
+#define configNUMBER_OF_CORES			4
+#endif
+#ifndef configUSE_PER_CORE_READY_LISTS
+#define configUSE_PER_CORE_READY_LISTS	0
+#endif
+#if ( configNUMBER_OF_CORES > 1 )
+#define configUSE_CORE_AFFINITY			1
+#else
+#define configUSE_CORE_AFFINITY			0
+#endif
+#define configUSE_PASSIVE_IDLE_HOOK		0
+
+#define configUSE_PREEMPTION			1
+#define configUSE_IDLE_HOOK				0
+#define configUSE_TICK_HOOK				0
+#define configTICK_RATE_HZ				( ( TickType_t ) 1000 )
+/* Each task's pthread runs on its FreeRTOS stack, which must be at least
+ * PTHREAD_STACK_MIN bytes. */
+#define configMINIMAL_STACK_SIZE		( ( unsigned short ) 4096 )
+#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 2 * 1024 * 1024 ) )
+#define configMAX_TASK_NAME_LEN			( 10 )
+#define configUSE_TRACE_FACILITY		1
+#define configUSE_16_BIT_TICKS			0
+#define configIDLE_SHOULD_YIELD			1
+#define configMAX_PRIORITIES			( 5 )
+#define configCHECK_FOR_STACK_OVERFLOW	0
+#define configUSE_MUTEXES				1
+#define configUSE_RECURSIVE_MUTEXES		1
+#define configUSE_COUNTING_SEMAPHORES	1
+#define configSUPPORT_DYNAMIC_ALLOCATION	1
+
+/* Software timer definitions. */
+#define configUSE_TIMERS				1
+#define configTIMER_TASK_PRIORITY		( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH		10
+#define configTIMER_TASK_STACK_DEPTH	configMINIMAL_STACK_SIZE
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+
+#define INCLUDE_vTaskPrioritySet			1
+#define INCLUDE_uxTaskPriorityGet			1
+#define INCLUDE_vTaskDelete					1
+#define INCLUDE_vTaskSuspend				1
+#define INCLUDE_vTaskDelayUntil				1
+#define INCLUDE_vTaskDelay					1
+#define INCLUDE_xTaskGetIdleTaskHandle		1
+#define INCLUDE_xTaskGetSchedulerState		1
+#define INCLUDE_xTaskGetCurrentTaskHandle	1
+
+/* make SELECTION_TIMING=1 times each selection of the next task to run, from
+ * just before the ready lists are searched until the chosen task is switched
+ * in, and the test prints the average and the worst case per core. */
+#ifndef mainSELECTION_TIMING
+#define mainSELECTION_TIMING			0
+#endif
+#if ( mainSELECTION_TIMING == 1 )
+extern void vSelectionTimingStart( void );
+extern void vSelectionTimingEnd( void );
+#define traceTASK_SWITCHED_OUT()		vSelectionTimingStart()
+#define traceTASK_SWITCHED_IN()			vSelectionTimingEnd()
+#endif
+
+/* Stop the test at the first failed assertion, naming the file and line. */
+extern void vAssertCalled( const char * pcFile, unsigned long ulLine );
+#define configASSERT( x ) if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ )
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,461 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Stress test for the symmetric multiprocessing scheduler, run on the POSIX
+ * port with each core simulated by a thread.
+ *
+ * mainNUM_WORKERS worker tasks at three priorities contend for a mutex (and
+ * yield while holding it), send to a queue, enter critical sections, notify a
+ * task, set bits in an event group and delay.  A control task meanwhile
+ * creates tasks that delete themselves, suspends and resumes the workers, and
+ * changes their priorities and core affinities, and a software timer runs.
+ *
+ * With mainSELECTION_TIMING set to 1 (make SELECTION_TIMING=1) the kernel's
+ * trace macros time each selection of the next task to run, and the control
+ * task prints the number of selections, their average and their worst case on
+ * each core.
+ *
+ * After mainTEST_DURATION_MS the control task checks that no increment made
+ * under the mutex was lost, that every kind of activity made progress and,
+ * with more than one core, that two workers were seen running on different
+ * cores at the same time, then exits with status 0 on success and 1 on
+ * failure.  A failed configASSERT()
+ * aborts the test.  A hang has to be caught by the caller (make test runs each
+ * test with a timeout).
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "timers.h"
+#include "event_groups.h"
+
+/* Test parameters. */
+#define mainNUM_WORKERS			( 6 )
+#define mainTEST_DURATION_MS	( 3000 )
+#define mainWORKER_SPIN_COUNT	( 2000 )
+#define mainOVERLAP_CHECK_INTERVAL	( 250 )
+
+/* Task priorities. */
+#define mainWORKER_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define mainRECEIVER_PRIORITY	( tskIDLE_PRIORITY + 2 )
+#define mainNOTIFIED_PRIORITY	( tskIDLE_PRIORITY + 3 )
+#define mainCONTROL_PRIORITY	( tskIDLE_PRIORITY + 4 )
+
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void *pvParameters );
+static void prvReceiverTask( void *pvParameters );
+static void prvNotifiedTask( void *pvParameters );
+static void prvEventGroupTask( void *pvParameters );
+static void prvTransientTask( void *pvParameters );
+static void prvControlTask( void *pvParameters );
+static void prvTimerCallback( TimerHandle_t xTimer );
+#if ( mainSELECTION_TIMING == 1 )
+	static void prvPrintSelectionTiming( void );
+#endif
+
+/*-----------------------------------------------------------*/
+
+static SemaphoreHandle_t xMutex;
+static QueueHandle_t xQueue;
+static EventGroupHandle_t xEventGroup;
+static TaskHandle_t xWorkers[ mainNUM_WORKERS ];
+static TaskHandle_t xNotifiedTask;
+
+/* ulShared is only updated with xMutex held, and must end up equal to the sum
+of the increments each worker counted. */
+static volatile unsigned long ulShared = 0;
+static volatile unsigned long ulWorkerCounts[ mainNUM_WORKERS ];
+
+static volatile unsigned long ulCritical = 0, ulReceived = 0, ulNotified = 0;
+static volatile unsigned long ulEventGroupWaits = 0, ulTransients = 0, ulTimerCalls = 0;
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+	/* While a worker does its busy work it keeps its entry set to the core it
+	last found itself running on, and -1 otherwise.  A worker that finds another
+	worker in its busy work on another core, and the kernel running that worker
+	on that core, counts an overlap and records the two cores.  A worker that was
+	preempted in its busy work is not running on any core, so is not counted. */
+	static volatile BaseType_t xSpinningCore[ mainNUM_WORKERS ];
+	static volatile unsigned long ulOverlaps = 0, ulOverlapCores = 0;
+
+#endif
+
+#if ( mainSELECTION_TIMING == 1 )
+
+	#if ( configNUMBER_OF_CORES > 1 )
+		#define mainCORE_ID()	portGET_CORE_ID()
+	#else
+		#define mainCORE_ID()	0
+	#endif
+
+	/* Written by each core only, with the kernel's locks held. */
+	static unsigned long long ullSelectionStartNs[ configNUMBER_OF_CORES ];
+	static unsigned long long ullSelectionTotalNs[ configNUMBER_OF_CORES ];
+	static unsigned long long ullSelectionMaxNs[ configNUMBER_OF_CORES ];
+	static unsigned long ulSelections[ configNUMBER_OF_CORES ];
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	long lWorker;
+
+	xMutex = xSemaphoreCreateMutex();
+	xQueue = xQueueCreate( 4, sizeof( unsigned long ) );
+	xEventGroup = xEventGroupCreate();
+	configASSERT( ( xMutex != NULL ) && ( xQueue != NULL ) && ( xEventGroup != NULL ) );
+
+	for( lWorker = 0; lWorker < mainNUM_WORKERS; lWorker++ )
+	{
+		#if ( configNUMBER_OF_CORES > 1 )
+		{
+			xSpinningCore[ lWorker ] = -1;
+		}
+		#endif
+		xTaskCreate( prvWorkerTask, "Worker", configMINIMAL_STACK_SIZE, ( void * ) lWorker, mainWORKER_PRIORITY + ( lWorker % 3 ), &( xWorkers[ lWorker ] ) );
+	}
+
+	xTaskCreate( prvReceiverTask, "Receiver", configMINIMAL_STACK_SIZE, NULL, mainRECEIVER_PRIORITY, NULL );
+	xTaskCreate( prvNotifiedTask, "Notified", configMINIMAL_STACK_SIZE, NULL, mainNOTIFIED_PRIORITY, &xNotifiedTask );
+	xTaskCreate( prvEventGroupTask, "Events", configMINIMAL_STACK_SIZE, NULL, mainRECEIVER_PRIORITY, NULL );
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, mainCONTROL_PRIORITY, NULL );
+	xTimerStart( xTimerCreate( "Timer", pdMS_TO_TICKS( 3 ), pdTRUE, NULL, prvTimerCallback ), 0 );
+
+	vTaskStartScheduler();
+
+	/* Only reached if there was not enough heap to start the scheduler. */
+	return 1;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+	static void prvCheckOverlap( long lWorker )
+	{
+	BaseType_t xCore, xOtherCore;
+	TaskHandle_t xOtherTask;
+	long lOther;
+
+		xCore = portGET_CORE_ID();
+		xSpinningCore[ lWorker ] = xCore;
+
+		for( xOtherCore = 0; xOtherCore < configNUMBER_OF_CORES; xOtherCore++ )
+		{
+			if( xOtherCore == xCore )
+			{
+				continue;
+			}
+
+			xOtherTask = xTaskGetCurrentTaskHandleForCore( xOtherCore );
+
+			for( lOther = 0; lOther < mainNUM_WORKERS; lOther++ )
+			{
+				if( ( xWorkers[ lOther ] == xOtherTask ) && ( xSpinningCore[ lOther ] == xOtherCore ) )
+				{
+					__atomic_add_fetch( &ulOverlaps, 1UL, __ATOMIC_RELAXED );
+					__atomic_or_fetch( &ulOverlapCores, ( 1UL << xCore ) | ( 1UL << xOtherCore ), __ATOMIC_RELAXED );
+				}
+			}
+		}
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void *pvParameters )
+{
+long lWorker = ( long ) pvParameters;
+unsigned long ulValue;
+volatile unsigned long ulSpin;
+
+	for( ;; )
+	{
+		/* Busy work, so the workers overlap on the cores. */
+		#if ( configNUMBER_OF_CORES > 1 )
+		{
+			xSpinningCore[ lWorker ] = portGET_CORE_ID();
+		}
+		#endif
+		for( ulSpin = 0; ulSpin < mainWORKER_SPIN_COUNT; ulSpin++ )
+		{
+			#if ( configNUMBER_OF_CORES > 1 )
+			{
+				if( ( ulSpin % mainOVERLAP_CHECK_INTERVAL ) == 0 )
+				{
+					prvCheckOverlap( lWorker );
+				}
+			}
+			#endif
+		}
+		#if ( configNUMBER_OF_CORES > 1 )
+		{
+			xSpinningCore[ lWorker ] = -1;
+		}
+		#endif
+
+		/* Yield while holding the mutex, so another task would see the
+		increment lost if the mutex did not exclude it. */
+		xSemaphoreTake( xMutex, portMAX_DELAY );
+		ulValue = ulShared;
+		taskYIELD();
+		ulShared = ulValue + 1;
+		ulWorkerCounts[ lWorker ]++;
+		xSemaphoreGive( xMutex );
+
+		ulValue = ( unsigned long ) lWorker;
+		xQueueSend( xQueue, &ulValue, portMAX_DELAY );
+
+		taskENTER_CRITICAL();
+		ulCritical++;
+		taskEXIT_CRITICAL();
+
+		if( ( ulWorkerCounts[ lWorker ] & 7 ) == 0 )
+		{
+			xTaskNotifyGive( xNotifiedTask );
+		}
+
+		if( ( ulWorkerCounts[ lWorker ] & 15 ) == 0 )
+		{
+			vTaskDelay( 1 );
+		}
+
+		xEventGroupSetBits( xEventGroup, ( EventBits_t ) ( 1 << lWorker ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceiverTask( void *pvParameters )
+{
+unsigned long ulValue;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xQueueReceive( xQueue, &ulValue, portMAX_DELAY ) == pdPASS )
+		{
+			ulReceived++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifiedTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		ulNotified += ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventGroupTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		xEventGroupWaitBits( xEventGroup, ( 1 << mainNUM_WORKERS ) - 1, pdTRUE, pdTRUE, portMAX_DELAY );
+		ulEventGroupWaits++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTransientTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	vTaskDelay( 1 );
+	taskENTER_CRITICAL();
+	ulTransients++;
+	taskEXIT_CRITICAL();
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+
+	ulTimerCalls++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+TickType_t xStart = xTaskGetTickCount();
+unsigned long ulIteration = 0, ulSum = 0;
+#if ( configUSE_CORE_AFFINITY == 1 )
+	UBaseType_t uxAffinity;
+#endif
+long lWorker;
+BaseType_t xPass;
+
+	( void ) pvParameters;
+
+	while( ( xTaskGetTickCount() - xStart ) < pdMS_TO_TICKS( mainTEST_DURATION_MS ) )
+	{
+		vTaskDelay( pdMS_TO_TICKS( 5 ) );
+		ulIteration++;
+
+		xTaskCreate( prvTransientTask, "Transient", configMINIMAL_STACK_SIZE, NULL, mainWORKER_PRIORITY + ( ulIteration % 3 ), NULL );
+
+		vTaskSuspend( xWorkers[ ulIteration % mainNUM_WORKERS ] );
+		vTaskDelay( 1 );
+		vTaskResume( xWorkers[ ulIteration % mainNUM_WORKERS ] );
+
+		vTaskPrioritySet( xWorkers[ ( ulIteration + 1 ) % mainNUM_WORKERS ], mainWORKER_PRIORITY + ( ulIteration % 3 ) );
+
+		#if ( configUSE_CORE_AFFINITY == 1 )
+		{
+			/* Pin a worker to one core, and now and then let it run anywhere
+			again. */
+			uxAffinity = ( UBaseType_t ) 1 << ( ulIteration % configNUMBER_OF_CORES );
+			vTaskCoreAffinitySet( xWorkers[ ( ulIteration + 2 ) % mainNUM_WORKERS ], uxAffinity );
+			configASSERT( uxTaskCoreAffinityGet( xWorkers[ ( ulIteration + 2 ) % mainNUM_WORKERS ] ) == uxAffinity );
+
+			if( ( ulIteration % 7 ) == 0 )
+			{
+				vTaskCoreAffinitySet( xWorkers[ ( ulIteration + 2 ) % mainNUM_WORKERS ], tskNO_AFFINITY );
+			}
+		}
+		#endif
+	}
+
+	vTaskSuspendAll();
+	{
+		for( lWorker = 0; lWorker < mainNUM_WORKERS; lWorker++ )
+		{
+			ulSum += ulWorkerCounts[ lWorker ];
+		}
+	}
+	xTaskResumeAll();
+
+	xPass = ( ulSum == ulShared ) && ( ulReceived > 0 ) && ( ulCritical > 0 ) && ( ulNotified > 0 ) &&
+			( ulEventGroupWaits > 0 ) && ( ulTransients > 0 ) && ( ulTimerCalls > 0 );
+
+	printf( "cores=%d shared=%lu sum=%lu received=%lu critical=%lu notified=%lu events=%lu transients=%lu timer=%lu\n",
+			configNUMBER_OF_CORES, ulShared, ulSum, ulReceived, ulCritical, ulNotified, ulEventGroupWaits, ulTransients, ulTimerCalls );
+	#if ( configNUMBER_OF_CORES > 1 )
+	{
+		/* The scheduler must have run workers on at least two cores at once. */
+		xPass = xPass && ( ulOverlaps > 0 ) && ( ( ulOverlapCores & ( ulOverlapCores - 1UL ) ) != 0 );
+		printf( "overlaps=%lu overlapcores=0x%lx\n", ulOverlaps, ulOverlapCores );
+	}
+	#endif
+	#if ( mainSELECTION_TIMING == 1 )
+	{
+		prvPrintSelectionTiming();
+	}
+	#endif
+	printf( "%s\n", ( xPass != pdFALSE ) ? "PASS" : "FAIL" );
+	fflush( stdout );
+
+	exit( ( xPass != pdFALSE ) ? 0 : 1 );
+}
+/*-----------------------------------------------------------*/
+
+#if ( mainSELECTION_TIMING == 1 )
+
+	static unsigned long long prvGetTimeNs( void )
+	{
+	struct timespec xNow;
+
+		clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+		return ( ( unsigned long long ) xNow.tv_sec * 1000000000ULL ) + ( unsigned long long ) xNow.tv_nsec;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vSelectionTimingStart( void )
+	{
+		ullSelectionStartNs[ mainCORE_ID() ] = prvGetTimeNs();
+	}
+	/*-----------------------------------------------------------*/
+
+	void vSelectionTimingEnd( void )
+	{
+	BaseType_t xCore = mainCORE_ID();
+	unsigned long long ullElapsedNs;
+
+		/* The first task on each core is switched in without a selection
+		being timed. */
+		if( ullSelectionStartNs[ xCore ] != 0ULL )
+		{
+			ullElapsedNs = prvGetTimeNs() - ullSelectionStartNs[ xCore ];
+			ullSelectionStartNs[ xCore ] = 0ULL;
+			ullSelectionTotalNs[ xCore ] += ullElapsedNs;
+			ulSelections[ xCore ]++;
+
+			if( ullElapsedNs > ullSelectionMaxNs[ xCore ] )
+			{
+				ullSelectionMaxNs[ xCore ] = ullElapsedNs;
+			}
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvPrintSelectionTiming( void )
+	{
+	BaseType_t xCore;
+	unsigned long long ullTotalNs = 0ULL;
+	unsigned long ulTotal = 0UL;
+
+		for( xCore = 0; xCore < configNUMBER_OF_CORES; xCore++ )
+		{
+			printf( "core %d: selections=%lu average=%lluns max=%lluns\n", ( int ) xCore, ulSelections[ xCore ],
+					( ulSelections[ xCore ] != 0UL ) ? ( ullSelectionTotalNs[ xCore ] / ulSelections[ xCore ] ) : 0ULL, ullSelectionMaxNs[ xCore ] );
+			ullTotalNs += ullSelectionTotalNs[ xCore ];
+			ulTotal += ulSelections[ xCore ];
+		}
+
+		printf( "all cores: selections=%lu average=%lluns\n", ulTotal, ( ulTotal != 0UL ) ? ( ullTotalNs / ulTotal ) : 0ULL );
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* mainSELECTION_TIMING */
+
+void vAssertCalled( const char * pcFile, unsigned long ulLine )
+{
+	fprintf( stderr, "ASSERT %s:%lu\n", pcFile, ulLine );
+	fflush( stderr );
+	abort();
+}
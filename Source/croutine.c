@@ -266,7 +266,7 @@
                     ( void ) uxListRemove( &( pxCRCB->xGenericListItem ) );
 
                     /* Is the co-routine waiting on an event also? */
-                    if( pxCRCB->xEventListItem.pxContainer )
+                    if( listLIST_ITEM_CONTAINER( &( pxCRCB->xEventListItem ) ) != NULL )
                     {
                         ( void ) uxListRemove( &( pxCRCB->xEventListItem ) );
                     }
@@ -61,6 +61,12 @@
 /* Basic FreeRTOS definitions. */
 #include "projdefs.h"
 
+/* Must be defaulted before the port layer is included, as a port can support
+ * more than one core. */
+#ifndef configNUMBER_OF_CORES
+    #define configNUMBER_OF_CORES    1
+#endif
+
 /* Definitions specific to the port being used. */
 #include "portable.h"
 
@@ -363,6 +369,95 @@
     #define portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedStatusValue )    ( void ) ( uxSavedStatusValue )
 #endif
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* A port that supports symmetric multiprocessing must provide a way of
+ * identifying the calling core, of interrupting another core, and two
+ * recursive spinlocks.  The task lock is held while a core has the scheduler
+ * suspended or is in a critical section.  The ISR lock is held while a core is
+ * in a critical section, including one entered from an interrupt. */
+    #ifndef portGET_CORE_ID
+        #error configNUMBER_OF_CORES is greater than 1 but portGET_CORE_ID() is not defined.  The port in use does not support symmetric multiprocessing.
+    #endif
+
+    #ifndef portYIELD_CORE
+        #error configNUMBER_OF_CORES is greater than 1 but portYIELD_CORE() is not defined.  The port in use does not support symmetric multiprocessing.
+    #endif
+
+    #if !defined( portGET_TASK_LOCK ) || !defined( portRELEASE_TASK_LOCK ) || !defined( portGET_ISR_LOCK ) || !defined( portRELEASE_ISR_LOCK )
+        #error configNUMBER_OF_CORES is greater than 1 but the port does not define the portGET_TASK_LOCK(), portRELEASE_TASK_LOCK(), portGET_ISR_LOCK() and portRELEASE_ISR_LOCK() spinlock macros.
+    #endif
+
+    #if !defined( portENTER_CRITICAL_FROM_ISR ) || !defined( portEXIT_CRITICAL_FROM_ISR )
+        #error configNUMBER_OF_CORES is greater than 1 but the port does not define portENTER_CRITICAL_FROM_ISR() and portEXIT_CRITICAL_FROM_ISR().  They should call uxTaskEnterCriticalFromISR() and vTaskExitCriticalFromISR().
+    #endif
+
+    #if ( portCRITICAL_NESTING_IN_TCB != 1 )
+        #error configNUMBER_OF_CORES is greater than 1 so the critical section nesting count must be held in the TCB.  Set portCRITICAL_NESTING_IN_TCB to 1 in portmacro.h.
+    #endif
+
+    #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+        #error configUSE_PORT_OPTIMISED_TASK_SELECTION cannot be used when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+        #error configUSE_TICKLESS_IDLE cannot be used when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( defined( configUSE_PRIORITY_BITMAP_TASK_SELECTION ) && ( configUSE_PRIORITY_BITMAP_TASK_SELECTION == 1 ) )
+        #error configUSE_PRIORITY_BITMAP_TASK_SELECTION cannot be used when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( configUSE_CO_ROUTINES != 0 )
+        #error Co-routines cannot be used when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( portUSING_MPU_WRAPPERS == 1 )
+        #error The MPU wrappers cannot be used when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( configUSE_POSIX_ERRNO == 1 )
+        #error configUSE_POSIX_ERRNO cannot be used when configNUMBER_OF_CORES is greater than 1 as FreeRTOS_errno is shared by all cores.
+    #endif
+
+#else /* configNUMBER_OF_CORES */
+
+    #ifndef portGET_CORE_ID
+        #define portGET_CORE_ID()    0
+    #endif
+
+#endif /* configNUMBER_OF_CORES */
+
+/* Critical sections entered from an interrupt only need to mask interrupts on a
+ * single core build. */
+#ifndef portENTER_CRITICAL_FROM_ISR
+    #define portENTER_CRITICAL_FROM_ISR()    portSET_INTERRUPT_MASK_FROM_ISR()
+#endif
+
+#ifndef portEXIT_CRITICAL_FROM_ISR
+    #define portEXIT_CRITICAL_FROM_ISR( uxSavedStatusValue )    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedStatusValue )
+#endif
+
+#ifndef configUSE_CORE_AFFINITY
+    #define configUSE_CORE_AFFINITY    0
+#endif
+
+#if ( ( configUSE_CORE_AFFINITY == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
+    #error configUSE_CORE_AFFINITY can only be set to 1 when configNUMBER_OF_CORES is greater than 1.
+#endif
+
+#ifndef configUSE_PASSIVE_IDLE_HOOK
+    #define configUSE_PASSIVE_IDLE_HOOK    0
+#endif
+
+#ifndef configUSE_PER_CORE_READY_LISTS
+    #define configUSE_PER_CORE_READY_LISTS    0
+#endif
+
+#if ( ( configUSE_PER_CORE_READY_LISTS == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
+    #error configUSE_PER_CORE_READY_LISTS can only be set to 1 when configNUMBER_OF_CORES is greater than 1.
+#endif
+
 #ifndef portCLEAN_UP_TCB
     #define portCLEAN_UP_TCB( pxTCB )    ( void ) ( pxTCB )
 #endif
@@ -389,6 +484,26 @@
     #define configUSE_MINI_LIST_ITEM    1
 #endif
 
+/* Set configUSE_COMPACT_LIST_ITEMS to 1 to hold the links between list items,
+ * lists and their owners as 16-bit indexes into the region of RAM that starts
+ * at configLIST_ARENA_BASE, rather than as pointers.  This saves 16 bytes per
+ * task and 16 bytes per queue on a 32-bit part, but every task, queue, timer,
+ * event group and kernel list must then lie within 256KB of
+ * configLIST_ARENA_BASE - see list.h. */
+#ifndef configUSE_COMPACT_LIST_ITEMS
+    #define configUSE_COMPACT_LIST_ITEMS    0
+#endif
+
+#if ( configUSE_COMPACT_LIST_ITEMS == 1 )
+    #ifndef configLIST_ARENA_BASE
+        #error configLIST_ARENA_BASE must be defined to the start address of the RAM that holds the kernel objects when configUSE_COMPACT_LIST_ITEMS is 1.
+    #endif
+
+    #if ( configUSE_16_BIT_TICKS == 1 )
+        #error configUSE_COMPACT_LIST_ITEMS requires list items to be word aligned, so cannot be used when configUSE_16_BIT_TICKS is 1.
+    #endif
+#endif
+
 #ifndef portPOINTER_SIZE_TYPE
     #define portPOINTER_SIZE_TYPE    uint32_t
 #endif
@@ -489,10 +604,25 @@
     #define configCHECK_FOR_STACK_OVERFLOW    0
 #endif
 
+#if ( ( configCHECK_FOR_STACK_OVERFLOW == 3 ) && ( portHAS_STACK_OVERFLOW_CHECKING != 1 ) )
+    #error configCHECK_FOR_STACK_OVERFLOW can only be set to 3 when the port checks for stack overflow in hardware.
+#endif
+
 #ifndef configRECORD_STACK_HIGH_ADDRESS
     #define configRECORD_STACK_HIGH_ADDRESS    0
 #endif
 
+/* Set configSTACK_HIGH_WATER_MARK_BINARY_SEARCH to 1 to find a task's stack high
+ * water mark with a binary search rather than by counting every unused word, and
+ * to remember the mark in the TCB so each search only covers the words that were
+ * unused last time.  The search assumes the words a task has used are contiguous,
+ * so it can report too much free stack if the task has left words it used
+ * untouched (for example part of a local array) - but never more than it
+ * reported before. */
+#ifndef configSTACK_HIGH_WATER_MARK_BINARY_SEARCH
+    #define configSTACK_HIGH_WATER_MARK_BINARY_SEARCH    0
+#endif
+
 #ifndef configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H
     #define configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H    0
 #endif
@@ -829,6 +959,41 @@
     #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #endif
 
+#ifndef configGENERATE_CRITICAL_SECTION_STATS
+    #define configGENERATE_CRITICAL_SECTION_STATS    0
+#endif
+
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+    #ifndef portGET_CRITICAL_SECTION_TIMESTAMP
+        #error If configGENERATE_CRITICAL_SECTION_STATS is defined then portGET_CRITICAL_SECTION_TIMESTAMP must also be defined.  portGET_CRITICAL_SECTION_TIMESTAMP should return the value of a free running, up counting 32-bit timer/counter - ideally one that increments at the core clock rate.
+    #endif
+
+    #if ( portUSING_MPU_WRAPPERS == 1 )
+        #error configGENERATE_CRITICAL_SECTION_STATS cannot be used when the MPU wrappers are in use.
+    #endif
+
+    #ifndef configCRITICAL_SECTION_STATS_MAX_SITES
+
+/* The number of distinct call sites that can be recorded.  Regions entered
+ * from further call sites once the table is full are counted as dropped. */
+        #define configCRITICAL_SECTION_STATS_MAX_SITES    16
+    #endif
+
+    #ifndef configCRITICAL_SECTION_STATS_HISTOGRAM_BUCKETS
+        #define configCRITICAL_SECTION_STATS_HISTOGRAM_BUCKETS    8
+    #endif
+
+    #ifndef configCRITICAL_SECTION_STATS_HISTOGRAM_SHIFT
+
+/* Durations are shifted right by this many bits before being placed into the
+ * power of two histogram buckets, so the first bucket covers durations below
+ * ( 2 << configCRITICAL_SECTION_STATS_HISTOGRAM_SHIFT ) timestamp counts. */
+        #define configCRITICAL_SECTION_STATS_HISTOGRAM_SHIFT    0
+    #endif
+
+#endif /* configGENERATE_CRITICAL_SECTION_STATS */
+
 #ifndef configUSE_MALLOC_FAILED_HOOK
     #define configUSE_MALLOC_FAILED_HOOK    0
 #endif
@@ -838,7 +1003,14 @@
 #endif
 
 #ifndef portYIELD_WITHIN_API
-    #define portYIELD_WITHIN_API    portYIELD
+    #if ( configNUMBER_OF_CORES == 1 )
+        #define portYIELD_WITHIN_API    portYIELD
+    #else
+
+/* The kernel spinlocks are held for the duration of a critical section, so a
+ * yield requested from within one is held pending until it is exited. */
+        #define portYIELD_WITHIN_API    vTaskYieldWithinAPI
+    #endif
 #endif
 
 #ifndef portSUPPRESS_TICKS_AND_SLEEP
@@ -921,6 +1093,42 @@
     #define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
 #endif
 
+#ifndef configUSE_PRIORITY_BITMAP_TASK_SELECTION
+    #define configUSE_PRIORITY_BITMAP_TASK_SELECTION    0
+#endif
+
+#if ( configUSE_PRIORITY_BITMAP_TASK_SELECTION == 1 )
+    #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+        #error configUSE_PRIORITY_BITMAP_TASK_SELECTION and configUSE_PORT_OPTIMISED_TASK_SELECTION cannot both be set to 1.  Set configUSE_PORT_OPTIMISED_TASK_SELECTION to 0 in FreeRTOSConfig.h.
+    #endif
+
+    #if ( configMAX_PRIORITIES > 1024 )
+        #error configUSE_PRIORITY_BITMAP_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 1024.
+    #endif
+#endif
+
+/* Set configUSE_WOKEN_TASK_SELECTION to 1 to have the kernel remember the task
+ * most recently made ready with a priority above the running task, so the
+ * context switch that follows (typically the one requested by an interrupt that
+ * gave the task a queue, semaphore or notification) can switch straight to it
+ * without searching the ready lists.  This works with any of the task selection
+ * methods, adds a test to each move of a task to a ready list, and is only
+ * worthwhile where the search itself is slow - see the configuration
+ * documentation in README.md. */
+#ifndef configUSE_WOKEN_TASK_SELECTION
+    #define configUSE_WOKEN_TASK_SELECTION    0
+#endif
+
+#if ( configUSE_WOKEN_TASK_SELECTION == 1 )
+    #if ( configNUMBER_OF_CORES > 1 )
+        #error configUSE_WOKEN_TASK_SELECTION cannot be used when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( configUSE_PREEMPTION == 0 )
+        #error configUSE_WOKEN_TASK_SELECTION can only be used when configUSE_PREEMPTION is 1.
+    #endif
+#endif
+
 #ifndef configAPPLICATION_ALLOCATED_HEAP
     #define configAPPLICATION_ALLOCATED_HEAP    0
 #endif
@@ -1204,7 +1412,11 @@ struct xSTATIC_LIST_ITEM
         TickType_t xDummy1;
     #endif
     TickType_t xDummy2;
-    void * pvDummy3[ 4 ];
+    #if ( configUSE_COMPACT_LIST_ITEMS == 1 )
+        uint16_t usDummy3[ 4 ];
+    #else
+        void * pvDummy3[ 4 ];
+    #endif
     #if ( configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES == 1 )
         TickType_t xDummy4;
     #endif
@@ -1219,7 +1431,11 @@ typedef struct xSTATIC_LIST_ITEM StaticListItem_t;
             TickType_t xDummy1;
         #endif
         TickType_t xDummy2;
-        void * pvDummy3[ 2 ];
+        #if ( configUSE_COMPACT_LIST_ITEMS == 1 )
+            uint16_t usDummy3[ 2 ];
+        #else
+            void * pvDummy3[ 2 ];
+        #endif
     };
     typedef struct xSTATIC_MINI_LIST_ITEM StaticMiniListItem_t;
 #else /* if ( configUSE_MINI_LIST_ITEM == 1 ) */
@@ -1232,8 +1448,12 @@ typedef struct xSTATIC_LIST
     #if ( configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES == 1 )
         TickType_t xDummy1;
     #endif
-    UBaseType_t uxDummy2;
-    void * pvDummy3;
+    #if ( configUSE_COMPACT_LIST_ITEMS == 1 )
+        uint16_t usDummy2[ 2 ];
+    #else
+        UBaseType_t uxDummy2;
+        void * pvDummy3;
+    #endif
     StaticMiniListItem_t xDummy4;
     #if ( configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES == 1 )
         TickType_t xDummy5;
@@ -1263,9 +1483,22 @@ typedef struct xSTATIC_TCB
     UBaseType_t uxDummy5;
     void * pxDummy6;
     uint8_t ucDummy7[ configMAX_TASK_NAME_LEN ];
+    #if ( configNUMBER_OF_CORES > 1 )
+        BaseType_t xDummy23;
+        UBaseType_t uxDummy24;
+    #endif
+    #if ( configUSE_CORE_AFFINITY == 1 )
+        UBaseType_t uxDummy25;
+    #endif
+    #if ( configUSE_PER_CORE_READY_LISTS == 1 )
+        BaseType_t xDummy26;
+    #endif
     #if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
         void * pxDummy8;
     #endif
+    #if ( configSTACK_HIGH_WATER_MARK_BINARY_SEARCH == 1 )
+        configSTACK_DEPTH_TYPE uxDummy27;
+    #endif
     #if ( portCRITICAL_NESTING_IN_TCB == 1 )
         UBaseType_t uxDummy9;
     #endif
@@ -1284,6 +1517,11 @@ typedef struct xSTATIC_TCB
     #if ( configGENERATE_RUN_TIME_STATS == 1 )
         configRUN_TIME_COUNTER_TYPE ulDummy16;
     #endif
+    #if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+        void * pxDummy28;
+        uint32_t ulDummy29;
+        UBaseType_t uxDummy30;
+    #endif
     #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
         configTLS_BLOCK_TYPE xDummy17;
     #endif
@@ -59,7 +59,17 @@
  * ATOMIC_ENTER_CRITICAL().
  *
  */
-#if defined( portSET_INTERRUPT_MASK_FROM_ISR )
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* Masking interrupts does not stop the other cores, so the kernel's
+ * interrupt safe critical section is used. */
+    #define ATOMIC_ENTER_CRITICAL() \
+    UBaseType_t uxCriticalSectionType = portENTER_CRITICAL_FROM_ISR()
+
+    #define ATOMIC_EXIT_CRITICAL() \
+    portEXIT_CRITICAL_FROM_ISR( uxCriticalSectionType )
+
+#elif defined( portSET_INTERRUPT_MASK_FROM_ISR )
 
 /* Nested interrupt scheme is supported in this port. */
     #define ATOMIC_ENTER_CRITICAL() \
@@ -74,7 +84,7 @@
     #define ATOMIC_ENTER_CRITICAL()    portENTER_CRITICAL()
     #define ATOMIC_EXIT_CRITICAL()     portEXIT_CRITICAL()
 
-#endif /* portSET_INTERRUPT_MASK_FROM_ISR() */
+#endif /* configNUMBER_OF_CORES */
 
 /*
  * Port specific definition -- "always inline".
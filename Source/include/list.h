@@ -137,29 +137,71 @@
 #endif /* configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES */
 
 
+/*
+ * When configUSE_COMPACT_LIST_ITEMS is set to 1 the links held in the list
+ * structures are not pointers but 16-bit indexes into the list arena - the
+ * region of RAM that starts at configLIST_ARENA_BASE.  An index counts 32-bit
+ * words from one word below configLIST_ARENA_BASE, so the arena is 256KB long
+ * and index 0 can be used to mean NULL.  Every list, list item and list item
+ * owner must therefore be placed within the arena, which on a small
+ * microcontroller is normally all of its RAM.  Each list item is then 8 bytes
+ * smaller, and each list 8 bytes smaller, than when 32-bit pointers are used.
+ */
+#if ( configUSE_COMPACT_LIST_ITEMS == 1 )
+    typedef uint16_t ListIndex_t;
+
+    #define listARENA_ORIGIN                   ( ( portPOINTER_SIZE_TYPE ) ( configLIST_ARENA_BASE ) - ( portPOINTER_SIZE_TYPE ) 4 )
+    #define listPOINTER_TO_INDEX( pv )         ( ( ListIndex_t ) ( ( ( portPOINTER_SIZE_TYPE ) ( pv ) - listARENA_ORIGIN ) >> 2 ) )
+    #define listINDEX_TO_POINTER( type, us )   ( ( type * ) ( listARENA_ORIGIN + ( ( portPOINTER_SIZE_TYPE ) ( us ) << 2 ) ) )
+
+/* Evaluates to pdTRUE if pv is word aligned and can be reached by an index. */
+    #define listIS_IN_ARENA( pv )                                                                                         \
+    ( ( ( ( portPOINTER_SIZE_TYPE ) ( pv ) > listARENA_ORIGIN ) &&                                                        \
+        ( ( ( portPOINTER_SIZE_TYPE ) ( pv ) - listARENA_ORIGIN ) <= ( ( portPOINTER_SIZE_TYPE ) 0xffffU << 2 ) ) && \
+        ( ( ( portPOINTER_SIZE_TYPE ) ( pv ) & ( portPOINTER_SIZE_TYPE ) 0x03 ) == 0 ) ) ? pdTRUE : pdFALSE )
+#endif /* configUSE_COMPACT_LIST_ITEMS */
+
 /*
  * Definition of the only type of object that a list can contain.
  */
 struct xLIST;
-struct xLIST_ITEM
-{
-    listFIRST_LIST_ITEM_INTEGRITY_CHECK_VALUE           /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
-    configLIST_VOLATILE TickType_t xItemValue;          /*< The value being listed.  In most cases this is used to sort the list in ascending order. */
-    struct xLIST_ITEM * configLIST_VOLATILE pxNext;     /*< Pointer to the next ListItem_t in the list. */
-    struct xLIST_ITEM * configLIST_VOLATILE pxPrevious; /*< Pointer to the previous ListItem_t in the list. */
-    void * pvOwner;                                     /*< Pointer to the object (normally a TCB) that contains the list item.  There is therefore a two way link between the object containing the list item and the list item itself. */
-    struct xLIST * configLIST_VOLATILE pxContainer;     /*< Pointer to the list in which this list item is placed (if any). */
-    listSECOND_LIST_ITEM_INTEGRITY_CHECK_VALUE          /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
-};
-typedef struct xLIST_ITEM ListItem_t;                   /* For some reason lint wants this as two separate definitions. */
+#if ( configUSE_COMPACT_LIST_ITEMS == 1 )
+    struct xLIST_ITEM
+    {
+        listFIRST_LIST_ITEM_INTEGRITY_CHECK_VALUE      /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
+        configLIST_VOLATILE TickType_t xItemValue;     /*< The value being listed.  In most cases this is used to sort the list in ascending order. */
+        configLIST_VOLATILE ListIndex_t usNext;        /*< Index of the next ListItem_t in the list. */
+        configLIST_VOLATILE ListIndex_t usPrevious;    /*< Index of the previous ListItem_t in the list. */
+        ListIndex_t usOwner;                           /*< Index of the object (normally a TCB) that contains the list item. */
+        configLIST_VOLATILE ListIndex_t usContainer;   /*< Index of the list in which this list item is placed, or 0 if it is not in a list. */
+        listSECOND_LIST_ITEM_INTEGRITY_CHECK_VALUE     /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
+    };
+#else
+    struct xLIST_ITEM
+    {
+        listFIRST_LIST_ITEM_INTEGRITY_CHECK_VALUE           /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
+        configLIST_VOLATILE TickType_t xItemValue;          /*< The value being listed.  In most cases this is used to sort the list in ascending order. */
+        struct xLIST_ITEM * configLIST_VOLATILE pxNext;     /*< Pointer to the next ListItem_t in the list. */
+        struct xLIST_ITEM * configLIST_VOLATILE pxPrevious; /*< Pointer to the previous ListItem_t in the list. */
+        void * pvOwner;                                     /*< Pointer to the object (normally a TCB) that contains the list item.  There is therefore a two way link between the object containing the list item and the list item itself. */
+        struct xLIST * configLIST_VOLATILE pxContainer;     /*< Pointer to the list in which this list item is placed (if any). */
+        listSECOND_LIST_ITEM_INTEGRITY_CHECK_VALUE          /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
+    };
+#endif /* configUSE_COMPACT_LIST_ITEMS */
+typedef struct xLIST_ITEM ListItem_t;                       /* For some reason lint wants this as two separate definitions. */
 
 #if ( configUSE_MINI_LIST_ITEM == 1 )
     struct xMINI_LIST_ITEM
     {
         listFIRST_LIST_ITEM_INTEGRITY_CHECK_VALUE /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
         configLIST_VOLATILE TickType_t xItemValue;
-        struct xLIST_ITEM * configLIST_VOLATILE pxNext;
-        struct xLIST_ITEM * configLIST_VOLATILE pxPrevious;
+        #if ( configUSE_COMPACT_LIST_ITEMS == 1 )
+            configLIST_VOLATILE ListIndex_t usNext;
+            configLIST_VOLATILE ListIndex_t usPrevious;
+        #else
+            struct xLIST_ITEM * configLIST_VOLATILE pxNext;
+            struct xLIST_ITEM * configLIST_VOLATILE pxPrevious;
+        #endif
     };
     typedef struct xMINI_LIST_ITEM MiniListItem_t;
 #else
@@ -171,13 +213,47 @@ typedef struct xLIST_ITEM ListItem_t;                   /* For some reason lint
  */
 typedef struct xLIST
 {
-    listFIRST_LIST_INTEGRITY_CHECK_VALUE      /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
-    volatile UBaseType_t uxNumberOfItems;
-    ListItem_t * configLIST_VOLATILE pxIndex; /*< Used to walk through the list.  Points to the last item returned by a call to listGET_OWNER_OF_NEXT_ENTRY (). */
-    MiniListItem_t xListEnd;                  /*< List item that contains the maximum possible item value meaning it is always at the end of the list and is therefore used as a marker. */
-    listSECOND_LIST_INTEGRITY_CHECK_VALUE     /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
+    listFIRST_LIST_INTEGRITY_CHECK_VALUE          /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
+    #if ( configUSE_COMPACT_LIST_ITEMS == 1 )
+        volatile uint16_t usNumberOfItems;        /*< An index can reach fewer than 65536 list items, so 16 bits is enough. */
+        configLIST_VOLATILE ListIndex_t usIndex;  /*< Used to walk through the list.  Index of the last item returned by a call to listGET_OWNER_OF_NEXT_ENTRY (). */
+    #else
+        volatile UBaseType_t uxNumberOfItems;
+        ListItem_t * configLIST_VOLATILE pxIndex; /*< Used to walk through the list.  Points to the last item returned by a call to listGET_OWNER_OF_NEXT_ENTRY (). */
+    #endif
+    MiniListItem_t xListEnd;                      /*< List item that contains the maximum possible item value meaning it is always at the end of the list and is therefore used as a marker. */
+    listSECOND_LIST_INTEGRITY_CHECK_VALUE         /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 } List_t;
 
+/*
+ * Macros used by the list implementation to read and write the links held in
+ * the list structures, so the same code serves whether the links are pointers
+ * or indexes.  listITEM_CLEAR_CONTAINER() marks an item as not being in a list.
+ */
+#if ( configUSE_COMPACT_LIST_ITEMS == 1 )
+    #define listITEM_NEXT( pxItem )                       listINDEX_TO_POINTER( ListItem_t, ( pxItem )->usNext )
+    #define listITEM_SET_NEXT( pxItem, pxNextItem )       ( ( pxItem )->usNext = listPOINTER_TO_INDEX( pxNextItem ) )
+    #define listITEM_PREVIOUS( pxItem )                   listINDEX_TO_POINTER( ListItem_t, ( pxItem )->usPrevious )
+    #define listITEM_SET_PREVIOUS( pxItem, pxPrevItem )   ( ( pxItem )->usPrevious = listPOINTER_TO_INDEX( pxPrevItem ) )
+    #define listITEM_CONTAINER( pxItem )                  ( ( ( pxItem )->usContainer == ( ListIndex_t ) 0U ) ? NULL : listINDEX_TO_POINTER( List_t, ( pxItem )->usContainer ) )
+    #define listITEM_SET_CONTAINER( pxItem, pxList )      ( ( pxItem )->usContainer = listPOINTER_TO_INDEX( pxList ) )
+    #define listITEM_CLEAR_CONTAINER( pxItem )            ( ( pxItem )->usContainer = ( ListIndex_t ) 0U )
+    #define listLIST_INDEX( pxList )                      listINDEX_TO_POINTER( ListItem_t, ( pxList )->usIndex )
+    #define listLIST_SET_INDEX( pxList, pxItem )          ( ( pxList )->usIndex = listPOINTER_TO_INDEX( pxItem ) )
+    #define listLIST_NUMBER_OF_ITEMS( pxList )            ( ( pxList )->usNumberOfItems )
+#else
+    #define listITEM_NEXT( pxItem )                       ( ( pxItem )->pxNext )
+    #define listITEM_SET_NEXT( pxItem, pxNextItem )       ( ( pxItem )->pxNext = ( pxNextItem ) )
+    #define listITEM_PREVIOUS( pxItem )                   ( ( pxItem )->pxPrevious )
+    #define listITEM_SET_PREVIOUS( pxItem, pxPrevItem )   ( ( pxItem )->pxPrevious = ( pxPrevItem ) )
+    #define listITEM_CONTAINER( pxItem )                  ( ( pxItem )->pxContainer )
+    #define listITEM_SET_CONTAINER( pxItem, pxList )      ( ( pxItem )->pxContainer = ( pxList ) )
+    #define listITEM_CLEAR_CONTAINER( pxItem )            ( ( pxItem )->pxContainer = NULL )
+    #define listLIST_INDEX( pxList )                      ( ( pxList )->pxIndex )
+    #define listLIST_SET_INDEX( pxList, pxItem )          ( ( pxList )->pxIndex = ( pxItem ) )
+    #define listLIST_NUMBER_OF_ITEMS( pxList )            ( ( pxList )->uxNumberOfItems )
+#endif /* configUSE_COMPACT_LIST_ITEMS */
+
 /*
  * Access macro to set the owner of a list item.  The owner of a list item
  * is the object (usually a TCB) that contains the list item.
@@ -185,7 +261,11 @@ typedef struct xLIST
  * \page listSET_LIST_ITEM_OWNER listSET_LIST_ITEM_OWNER
  * \ingroup LinkedList
  */
-#define listSET_LIST_ITEM_OWNER( pxListItem, pxOwner )    ( ( pxListItem )->pvOwner = ( void * ) ( pxOwner ) )
+#if ( configUSE_COMPACT_LIST_ITEMS == 1 )
+    #define listSET_LIST_ITEM_OWNER( pxListItem, pxOwner )    ( ( pxListItem )->usOwner = listPOINTER_TO_INDEX( pxOwner ) )
+#else
+    #define listSET_LIST_ITEM_OWNER( pxListItem, pxOwner )    ( ( pxListItem )->pvOwner = ( void * ) ( pxOwner ) )
+#endif
 
 /*
  * Access macro to get the owner of a list item.  The owner of a list item
@@ -194,7 +274,11 @@ typedef struct xLIST
  * \page listGET_LIST_ITEM_OWNER listSET_LIST_ITEM_OWNER
  * \ingroup LinkedList
  */
-#define listGET_LIST_ITEM_OWNER( pxListItem )             ( ( pxListItem )->pvOwner )
+#if ( configUSE_COMPACT_LIST_ITEMS == 1 )
+    #define listGET_LIST_ITEM_OWNER( pxListItem )    listINDEX_TO_POINTER( void, ( pxListItem )->usOwner )
+#else
+    #define listGET_LIST_ITEM_OWNER( pxListItem )    ( ( pxListItem )->pvOwner )
+#endif
 
 /*
  * Access macro to set the value of the list item.  In most cases the value is
@@ -222,7 +306,7 @@ typedef struct xLIST
  * \page listGET_LIST_ITEM_VALUE listGET_LIST_ITEM_VALUE
  * \ingroup LinkedList
  */
-#define listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxList )        ( ( ( pxList )->xListEnd ).pxNext->xItemValue )
+#define listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxList )        ( listITEM_NEXT( &( ( pxList )->xListEnd ) )->xItemValue )
 
 /*
  * Return the list item at the head of the list.
@@ -230,7 +314,7 @@ typedef struct xLIST
  * \page listGET_HEAD_ENTRY listGET_HEAD_ENTRY
  * \ingroup LinkedList
  */
-#define listGET_HEAD_ENTRY( pxList )                      ( ( ( pxList )->xListEnd ).pxNext )
+#define listGET_HEAD_ENTRY( pxList )                      listITEM_NEXT( &( ( pxList )->xListEnd ) )
 
 /*
  * Return the next list item.
@@ -238,7 +322,7 @@ typedef struct xLIST
  * \page listGET_NEXT listGET_NEXT
  * \ingroup LinkedList
  */
-#define listGET_NEXT( pxListItem )                        ( ( pxListItem )->pxNext )
+#define listGET_NEXT( pxListItem )                        listITEM_NEXT( pxListItem )
 
 /*
  * Return the list item that marks the end of the list
@@ -255,12 +339,12 @@ typedef struct xLIST
  * \page listLIST_IS_EMPTY listLIST_IS_EMPTY
  * \ingroup LinkedList
  */
-#define listLIST_IS_EMPTY( pxList )                       ( ( ( pxList )->uxNumberOfItems == ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE )
+#define listLIST_IS_EMPTY( pxList )                       ( ( listLIST_NUMBER_OF_ITEMS( pxList ) == ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE )
 
 /*
  * Access macro to return the number of items in the list.
  */
-#define listCURRENT_LIST_LENGTH( pxList )                 ( ( pxList )->uxNumberOfItems )
+#define listCURRENT_LIST_LENGTH( pxList )                 listLIST_NUMBER_OF_ITEMS( pxList )
 
 /*
  * Access function to obtain the owner of the next entry in a list.
@@ -282,17 +366,17 @@ typedef struct xLIST
  * \page listGET_OWNER_OF_NEXT_ENTRY listGET_OWNER_OF_NEXT_ENTRY
  * \ingroup LinkedList
  */
-#define listGET_OWNER_OF_NEXT_ENTRY( pxTCB, pxList )                                           \
-    {                                                                                          \
-        List_t * const pxConstList = ( pxList );                                               \
-        /* Increment the index to the next item and return the item, ensuring */               \
-        /* we don't return the marker used at the end of the list.  */                         \
-        ( pxConstList )->pxIndex = ( pxConstList )->pxIndex->pxNext;                           \
-        if( ( void * ) ( pxConstList )->pxIndex == ( void * ) &( ( pxConstList )->xListEnd ) ) \
-        {                                                                                      \
-            ( pxConstList )->pxIndex = ( pxConstList )->pxIndex->pxNext;                       \
-        }                                                                                      \
-        ( pxTCB ) = ( pxConstList )->pxIndex->pvOwner;                                         \
+#define listGET_OWNER_OF_NEXT_ENTRY( pxTCB, pxList )                                                \
+    {                                                                                               \
+        List_t * const pxConstList = ( pxList );                                                    \
+        /* Increment the index to the next item and return the item, ensuring */                    \
+        /* we don't return the marker used at the end of the list.  */                              \
+        listLIST_SET_INDEX( pxConstList, listITEM_NEXT( listLIST_INDEX( pxConstList ) ) );          \
+        if( ( void * ) listLIST_INDEX( pxConstList ) == ( void * ) &( ( pxConstList )->xListEnd ) ) \
+        {                                                                                           \
+            listLIST_SET_INDEX( pxConstList, listITEM_NEXT( listLIST_INDEX( pxConstList ) ) );      \
+        }                                                                                           \
+        ( pxTCB ) = listGET_LIST_ITEM_OWNER( listLIST_INDEX( pxConstList ) );                       \
     }
 
 /*
@@ -311,22 +395,22 @@ typedef struct xLIST
  * \page listREMOVE_ITEM listREMOVE_ITEM
  * \ingroup LinkedList
  */
-#define listREMOVE_ITEM( pxItemToRemove ) \
-    {                                     \
-        /* The list item knows which list it is in.  Obtain the list from the list \
-         * item. */                                                              \
-        List_t * const pxList = ( pxItemToRemove )->pxContainer;                 \
-                                                                                 \
-        ( pxItemToRemove )->pxNext->pxPrevious = ( pxItemToRemove )->pxPrevious; \
-        ( pxItemToRemove )->pxPrevious->pxNext = ( pxItemToRemove )->pxNext;     \
-        /* Make sure the index is left pointing to a valid item. */              \
-        if( pxList->pxIndex == ( pxItemToRemove ) )                              \
-        {                                                                        \
-            pxList->pxIndex = ( pxItemToRemove )->pxPrevious;                    \
-        }                                                                        \
-                                                                                 \
-        ( pxItemToRemove )->pxContainer = NULL;                                  \
-        ( pxList->uxNumberOfItems )--;                                           \
+#define listREMOVE_ITEM( pxItemToRemove )                                                              \
+    {                                                                                                  \
+        /* The list item knows which list it is in.  Obtain the list from the list                     \
+         * item. */                                                                                    \
+        List_t * const pxList = listITEM_CONTAINER( pxItemToRemove );                                  \
+                                                                                                       \
+        listITEM_SET_PREVIOUS( listITEM_NEXT( pxItemToRemove ), listITEM_PREVIOUS( pxItemToRemove ) ); \
+        listITEM_SET_NEXT( listITEM_PREVIOUS( pxItemToRemove ), listITEM_NEXT( pxItemToRemove ) );     \
+        /* Make sure the index is left pointing to a valid item. */                                    \
+        if( listLIST_INDEX( pxList ) == ( pxItemToRemove ) )                                           \
+        {                                                                                              \
+            listLIST_SET_INDEX( pxList, listITEM_PREVIOUS( pxItemToRemove ) );                         \
+        }                                                                                              \
+                                                                                                       \
+        listITEM_CLEAR_CONTAINER( pxItemToRemove );                                                    \
+        ( listLIST_NUMBER_OF_ITEMS( pxList ) )--;                                                      \
     }
 
 /*
@@ -351,29 +435,29 @@ typedef struct xLIST
  * \page listINSERT_END listINSERT_END
  * \ingroup LinkedList
  */
-#define listINSERT_END( pxList, pxNewListItem )           \
-    {                                                     \
-        ListItem_t * const pxIndex = ( pxList )->pxIndex; \
-                                                          \
-        /* Only effective when configASSERT() is also defined, these tests may catch \
+#define listINSERT_END( pxList, pxNewListItem )                                       \
+    {                                                                                 \
+        ListItem_t * const pxIndex = listLIST_INDEX( pxList );                        \
+                                                                                      \
+        /* Only effective when configASSERT() is also defined, these tests may catch  \
          * the list data structures being overwritten in memory.  They will not catch \
-         * data errors caused by incorrect configuration or use of FreeRTOS. */ \
-        listTEST_LIST_INTEGRITY( ( pxList ) );                                  \
-        listTEST_LIST_ITEM_INTEGRITY( ( pxNewListItem ) );                      \
-                                                                                \
-        /* Insert a new list item into ( pxList ), but rather than sort the list, \
-         * makes the new list item the last item to be removed by a call to \
-         * listGET_OWNER_OF_NEXT_ENTRY(). */                 \
-        ( pxNewListItem )->pxNext = pxIndex;                 \
-        ( pxNewListItem )->pxPrevious = pxIndex->pxPrevious; \
-                                                             \
-        pxIndex->pxPrevious->pxNext = ( pxNewListItem );     \
-        pxIndex->pxPrevious = ( pxNewListItem );             \
-                                                             \
-        /* Remember which list the item is in. */            \
-        ( pxNewListItem )->pxContainer = ( pxList );         \
-                                                             \
-        ( ( pxList )->uxNumberOfItems )++;                   \
+         * data errors caused by incorrect configuration or use of FreeRTOS. */       \
+        listTEST_LIST_INTEGRITY( ( pxList ) );                                        \
+        listTEST_LIST_ITEM_INTEGRITY( ( pxNewListItem ) );                            \
+                                                                                      \
+        /* Insert a new list item into ( pxList ), but rather than sort the list,     \
+         * makes the new list item the last item to be removed by a call to           \
+         * listGET_OWNER_OF_NEXT_ENTRY(). */                                          \
+        listITEM_SET_NEXT( ( pxNewListItem ), pxIndex );                              \
+        listITEM_SET_PREVIOUS( ( pxNewListItem ), listITEM_PREVIOUS( pxIndex ) );     \
+                                                                                      \
+        listITEM_SET_NEXT( listITEM_PREVIOUS( pxIndex ), ( pxNewListItem ) );         \
+        listITEM_SET_PREVIOUS( pxIndex, ( pxNewListItem ) );                          \
+                                                                                      \
+        /* Remember which list the item is in. */                                     \
+        listITEM_SET_CONTAINER( ( pxNewListItem ), ( pxList ) );                      \
+                                                                                      \
+        ( listLIST_NUMBER_OF_ITEMS( pxList ) )++;                                     \
     }
 
 /*
@@ -392,7 +476,7 @@ typedef struct xLIST
  * \page listGET_OWNER_OF_HEAD_ENTRY listGET_OWNER_OF_HEAD_ENTRY
  * \ingroup LinkedList
  */
-#define listGET_OWNER_OF_HEAD_ENTRY( pxList )            ( ( &( ( pxList )->xListEnd ) )->pxNext->pvOwner )
+#define listGET_OWNER_OF_HEAD_ENTRY( pxList )            listGET_LIST_ITEM_OWNER( listITEM_NEXT( &( ( pxList )->xListEnd ) ) )
 
 /*
  * Check to see if a list item is within a list.  The list item maintains a
@@ -403,7 +487,7 @@ typedef struct xLIST
  * @param pxListItem The list item we want to know if is in the list.
  * @return pdTRUE if the list item is in the list, otherwise pdFALSE.
  */
-#define listIS_CONTAINED_WITHIN( pxList, pxListItem )    ( ( ( pxListItem )->pxContainer == ( pxList ) ) ? ( pdTRUE ) : ( pdFALSE ) )
+#define listIS_CONTAINED_WITHIN( pxList, pxListItem )    ( ( listITEM_CONTAINER( pxListItem ) == ( pxList ) ) ? ( pdTRUE ) : ( pdFALSE ) )
 
 /*
  * Return the list a list item is contained within (referenced from).
@@ -411,7 +495,7 @@ typedef struct xLIST
  * @param pxListItem The list item being queried.
  * @return A pointer to the List_t object that references the pxListItem
  */
-#define listLIST_ITEM_CONTAINER( pxListItem )            ( ( pxListItem )->pxContainer )
+#define listLIST_ITEM_CONTAINER( pxListItem )            listITEM_CONTAINER( pxListItem )
 
 /*
  * This provides a crude means of knowing if a list has been initialised, as
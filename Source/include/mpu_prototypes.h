@@ -99,6 +99,11 @@ BaseType_t MPU_xTaskGenericNotify( TaskHandle_t xTaskToNotify,
                                    uint32_t ulValue,
                                    eNotifyAction eAction,
                                    uint32_t * pulPreviousNotificationValue ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xTaskGenericNotifyGroup( TaskHandle_t const * pxTasksToNotify,
+                                        UBaseType_t uxNumberOfTasks,
+                                        UBaseType_t uxIndexToNotify,
+                                        uint32_t ulValue,
+                                        eNotifyAction eAction ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn,
                                        uint32_t ulBitsToClearOnEntry,
                                        uint32_t ulBitsToClearOnExit,
@@ -33,6 +33,39 @@
  * only for ports that are using the MPU. */
 #if ( portUSING_MPU_WRAPPERS == 1 )
 
+/*
+ * The kernel calls that can be made through MPU_xSystemCallBatch(), which runs
+ * several calls for an unprivileged task with a single raise and reset of the
+ * privilege level.  The arguments and return value of each call are held in
+ * the ulArgs[] and ulReturn members of a SystemCall_t, in the order, and cast
+ * to the types, of the function named in the comment.  Notification and timer
+ * calls that take a final pointer argument are made with that argument NULL.
+ */
+    typedef enum
+    {
+        eSystemCallQueueGenericSend = 0,   /* xQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition ). */
+        eSystemCallQueueReceive,           /* xQueueReceive( xQueue, pvBuffer, xTicksToWait ). */
+        eSystemCallQueuePeek,              /* xQueuePeek( xQueue, pvBuffer, xTicksToWait ). */
+        eSystemCallQueueSemaphoreTake,     /* xQueueSemaphoreTake( xQueue, xTicksToWait ). */
+        eSystemCallTaskGenericNotify,      /* xTaskGenericNotify( xTaskToNotify, uxIndexToNotify, ulValue, eAction, NULL ). */
+        eSystemCallTaskGenericNotifyWait,  /* xTaskGenericNotifyWait( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, xTicksToWait ) - the notification value is returned in ulArgs[ 0 ]. */
+        eSystemCallEventGroupSetBits,      /* xEventGroupSetBits( xEventGroup, uxBitsToSet ). */
+        eSystemCallEventGroupClearBits,    /* xEventGroupClearBits( xEventGroup, uxBitsToClear ). */
+        eSystemCallStreamBufferSend,       /* xStreamBufferSend( xStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait ). */
+        eSystemCallStreamBufferReceive,    /* xStreamBufferReceive( xStreamBuffer, pvRxData, xBufferLengthBytes, xTicksToWait ). */
+        eSystemCallTaskDelay,              /* vTaskDelay( xTicksToDelay ). */
+        eSystemCallTaskGetTickCount,       /* xTaskGetTickCount(). */
+        eSystemCallTimerGenericCommand,    /* xTimerGenericCommand( xTimer, xCommandID, xOptionalValue, NULL, ulArgs[ 3 ] ). */
+        eSystemCallNumberOfCalls
+    } eSystemCall;
+
+    typedef struct xSYSTEM_CALL
+    {
+        eSystemCall eCall;
+        uint32_t ulArgs[ 4 ]; /* The MPU ports are all 32 bit, so a uint32_t can hold any argument. */
+        uint32_t ulReturn;
+    } SystemCall_t;
+
 /* MPU_WRAPPERS_INCLUDED_FROM_API_FILE will be defined when this file is
  * included from queue.c or task.c to prevent it from having an effect within
  * those files. */
@@ -79,6 +112,7 @@
         #define ulTaskGetIdleRunTimeCounter            MPU_ulTaskGetIdleRunTimeCounter
         #define ulTaskGetIdleRunTimePercent            MPU_ulTaskGetIdleRunTimePercent
         #define xTaskGenericNotify                     MPU_xTaskGenericNotify
+        #define xTaskGenericNotifyGroup                MPU_xTaskGenericNotifyGroup
         #define xTaskGenericNotifyWait                 MPU_xTaskGenericNotifyWait
         #define ulTaskGenericNotifyTake                MPU_ulTaskGenericNotifyTake
         #define xTaskGenericNotifyStateClear           MPU_xTaskGenericNotifyStateClear
@@ -172,6 +206,27 @@
 
     #endif /* MPU_WRAPPERS_INCLUDED_FROM_API_FILE */
 
+/*
+ * Make uxNumberOfCalls of the calls listed in eSystemCall, in order, raising
+ * the privilege level once for all of them rather than once for each.  A call
+ * can block, in which case the calls after it are made when it returns.
+ *
+ * When called from an unprivileged task, no call is made unless the task
+ * could read and write the whole of pxCalls itself, and a call that passes a
+ * buffer is only made if the task could access the buffer itself (reading it
+ * for a send, writing it for a receive or peek, for the item size of the
+ * queue or the number of bytes given).  These checks use the MPU regions of
+ * the task.  Handles are passed on unchecked, as the MPU_ wrappers of the
+ * same functions pass them.
+ *
+ * Returns the number of calls made, which is less than uxNumberOfCalls only
+ * if pxCalls[ return value ] is not a valid call, is for an API function
+ * excluded from the build, or failed one of the checks above, or if pxCalls
+ * failed its check, in which case 0 is returned.
+ */
+    UBaseType_t MPU_xSystemCallBatch( SystemCall_t * const pxCalls,
+                                      const UBaseType_t uxNumberOfCalls ) FREERTOS_SYSTEM_CALL;
+
 #else /* portUSING_MPU_WRAPPERS */
 
     #define PRIVILEGED_FUNCTION
@@ -227,6 +227,16 @@ void vPortEndScheduler( void ) PRIVILEGED_FUNCTION;
                                     const struct xMEMORY_REGION * const xRegions,
                                     StackType_t * pxBottomOfStack,
                                     uint32_t ulStackDepth ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if the calling task, running unprivileged, could access the
+ * ulBufferLength bytes at pvBuffer with the access given by ulAccessRequested
+ * (tskMPU_READ_PERMISSION, tskMPU_WRITE_PERMISSION or both), and pdFALSE if
+ * it could not.  Must be called with the processor privileged.
+ */
+    BaseType_t xPortIsAuthorizedToAccessBuffer( const void * pvBuffer,
+                                                uint32_t ulBufferLength,
+                                                uint32_t ulAccessRequested ) PRIVILEGED_FUNCTION;
 #endif
 
 /* *INDENT-OFF* */
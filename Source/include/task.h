@@ -66,6 +66,10 @@
 #define tskMPU_REGION_NORMAL_MEMORY    ( 1UL << 3UL )
 #define tskMPU_REGION_DEVICE_MEMORY    ( 1UL << 4UL )
 
+/* Access requested of xPortIsAuthorizedToAccessBuffer(). */
+#define tskMPU_READ_PERMISSION         ( 1UL << 0UL )
+#define tskMPU_WRITE_PERMISSION        ( 1UL << 1UL )
+
 /* The direct to task notification feature used to have only a single notification
  * per task.  Now there is an array of notifications per task that is dimensioned by
  * configTASK_NOTIFICATION_ARRAY_ENTRIES.  For backward compatibility, any use of the
@@ -168,6 +172,33 @@ typedef struct xTASK_STATUS
     configSTACK_DEPTH_TYPE usStackHighWaterMark;  /* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
 
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+/* The kind of region a CriticalSectionStats_t structure describes. */
+    typedef enum
+    {
+        eInterruptsMasked = 0, /* A region bounded by taskENTER_CRITICAL()/taskEXIT_CRITICAL() or their FromISR equivalents. */
+        eSchedulerSuspended    /* A region bounded by vTaskSuspendAll()/xTaskResumeAll(). */
+    } eCriticalRegionType;
+
+/* Used with the uxTaskGetCriticalSectionStats() function to return the timing
+ * of the regions entered from each call site.  Durations are in units of
+ * portGET_CRITICAL_SECTION_TIMESTAMP().  Only the outermost region of a nested
+ * set is timed, so the call site is the one that first masked interrupts or
+ * suspended the scheduler. */
+    typedef struct xCRITICAL_SECTION_STATS
+    {
+        const char * pcFile;                                                        /* The source file containing the call site. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+        uint32_t ulLine;                                                            /* The line number of the call site within pcFile. */
+        eCriticalRegionType eType;                                                  /* Whether interrupts were masked or the scheduler was suspended. */
+        uint32_t ulCount;                                                           /* The number of times the region was entered and exited. */
+        uint32_t ulMaxDuration;                                                     /* The longest the region has been held - the worst case seen so far. */
+        uint64_t ullTotalDuration;                                                  /* The sum of all durations, from which the mean can be calculated. */
+        uint32_t ulHistogram[ configCRITICAL_SECTION_STATS_HISTOGRAM_BUCKETS ]; /* Bucket n counts durations that, after being shifted right by configCRITICAL_SECTION_STATS_HISTOGRAM_SHIFT, have their most significant set bit in position n.  The last bucket also counts anything longer. */
+    } CriticalSectionStats_t;
+
+#endif /* configGENERATE_CRITICAL_SECTION_STATS */
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -185,6 +216,14 @@ typedef enum
  */
 #define tskIDLE_PRIORITY    ( ( UBaseType_t ) 0U )
 
+/**
+ * Defines the affinity mask that allows a task to run on any core.  Only used
+ * when configUSE_CORE_AFFINITY is set to 1.
+ *
+ * \ingroup TaskUtils
+ */
+#define tskNO_AFFINITY      ( ( UBaseType_t ) -1 )
+
 /**
  * task. h
  *
@@ -204,11 +243,25 @@ typedef enum
  * NOTE: This may alter the stack (depending on the portable implementation)
  * so must be used with care!
  *
+ * When configGENERATE_CRITICAL_SECTION_STATS is set to 1 the time for which
+ * interrupts remain masked is also recorded against the file and line that
+ * entered the region.  See uxTaskGetCriticalSectionStats().
+ *
  * \defgroup taskENTER_CRITICAL taskENTER_CRITICAL
  * \ingroup SchedulerControl
  */
-#define taskENTER_CRITICAL()               portENTER_CRITICAL()
-#define taskENTER_CRITICAL_FROM_ISR()      portSET_INTERRUPT_MASK_FROM_ISR()
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+    #define taskENTER_CRITICAL()                                           \
+    do {                                                                   \
+        portENTER_CRITICAL();                                              \
+        vTaskCriticalSectionStatsEnter( __FILE__, ( uint32_t ) __LINE__ ); \
+    } while( 0 )
+    #define taskENTER_CRITICAL_FROM_ISR() \
+    uxTaskCriticalSectionStatsEnterFromISR( ( UBaseType_t ) portENTER_CRITICAL_FROM_ISR(), __FILE__, ( uint32_t ) __LINE__ )
+#else
+    #define taskENTER_CRITICAL()             portENTER_CRITICAL()
+    #define taskENTER_CRITICAL_FROM_ISR()    portENTER_CRITICAL_FROM_ISR()
+#endif
 
 /**
  * task. h
@@ -222,8 +275,21 @@ typedef enum
  * \defgroup taskEXIT_CRITICAL taskEXIT_CRITICAL
  * \ingroup SchedulerControl
  */
-#define taskEXIT_CRITICAL()                portEXIT_CRITICAL()
-#define taskEXIT_CRITICAL_FROM_ISR( x )    portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+    #define taskEXIT_CRITICAL()          \
+    do {                                 \
+        vTaskCriticalSectionStatsExit(); \
+        portEXIT_CRITICAL();             \
+    } while( 0 )
+    #define taskEXIT_CRITICAL_FROM_ISR( x ) \
+    do {                                    \
+        vTaskCriticalSectionStatsExit();    \
+        portEXIT_CRITICAL_FROM_ISR( x );    \
+    } while( 0 )
+#else
+    #define taskEXIT_CRITICAL()                portEXIT_CRITICAL()
+    #define taskEXIT_CRITICAL_FROM_ISR( x )    portEXIT_CRITICAL_FROM_ISR( x )
+#endif
 
 /**
  * task. h
@@ -1088,6 +1154,69 @@ void vTaskGetInfo( TaskHandle_t xTask,
 void vTaskPrioritySet( TaskHandle_t xTask,
                        UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskCoreAffinitySet( const TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask );
+ * @endcode
+ *
+ * configNUMBER_OF_CORES must be greater than 1 and configUSE_CORE_AFFINITY
+ * must be defined as 1 for this function to be available.
+ *
+ * Sets the cores on which a task may run.  If the task is running on a core
+ * that is no longer in its affinity mask it is made to yield that core.
+ *
+ * @param xTask Handle of the task whose affinity is being set.  Passing a NULL
+ * handle results in the affinity of the calling task being set.
+ *
+ * @param uxCoreAffinityMask A bitwise value in which bit n is set if the task
+ * may run on core n.  Pass tskNO_AFFINITY to allow the task to run on any core.
+ *
+ * Example usage:
+ * @code{c}
+ * void vAFunction( void )
+ * {
+ * TaskHandle_t xHandle;
+ *
+ *   // Create a task, storing the handle.
+ *   xTaskCreate( vTaskCode, "NAME", STACK_SIZE, NULL, tskIDLE_PRIORITY, &xHandle );
+ *
+ *   // ...
+ *
+ *   // Only allow the created task to run on cores 0 and 2.
+ *   vTaskCoreAffinitySet( xHandle, ( 1 << 0 ) | ( 1 << 2 ) );
+ * }
+ * @endcode
+ * \defgroup vTaskCoreAffinitySet vTaskCoreAffinitySet
+ * \ingroup TaskCtrl
+ */
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+    void vTaskCoreAffinitySet( const TaskHandle_t xTask,
+                               UBaseType_t uxCoreAffinityMask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskCoreAffinityGet( const TaskHandle_t xTask );
+ * @endcode
+ *
+ * configNUMBER_OF_CORES must be greater than 1 and configUSE_CORE_AFFINITY
+ * must be defined as 1 for this function to be available.
+ *
+ * @param xTask Handle of the task being queried.  Passing a NULL handle results
+ * in the affinity of the calling task being returned.
+ *
+ * @return The affinity mask of xTask, in which bit n is set if the task may
+ * run on core n.
+ *
+ * \defgroup uxTaskCoreAffinityGet uxTaskCoreAffinityGet
+ * \ingroup TaskCtrl
+ */
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+    UBaseType_t uxTaskCoreAffinityGet( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -1369,6 +1498,15 @@ void vTaskEndScheduler( void ) PRIVILEGED_FUNCTION;
  */
 void vTaskSuspendAll( void ) PRIVILEGED_FUNCTION;
 
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+/* Route calls through a function that also records the call site, so the time
+ * the scheduler remains suspended can be attributed to the caller. */
+    void vTaskSuspendAllFromSite( const char * pcFile,
+                                  uint32_t ulLine ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    #define vTaskSuspendAll()    vTaskSuspendAllFromSite( __FILE__, ( uint32_t ) __LINE__ )
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -1681,6 +1819,29 @@ configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) PRIVIL
     void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
                                         StackType_t ** ppxIdleTaskStackBuffer,
                                         uint32_t * pulIdleTaskStackSize ); /*lint !e526 Symbol not defined as it is an application callback. */
+
+/**
+ * task.h
+ * @code{c}
+ * void vApplicationGetPassiveIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer, StackType_t ** ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize, BaseType_t xPassiveIdleTaskIndex )
+ * @endcode
+ *
+ * When configNUMBER_OF_CORES is greater than 1 one idle task is created per
+ * core.  vApplicationGetIdleTaskMemory() provides the memory for the idle task
+ * of core 0, and this function provides the memory for the passive idle tasks
+ * of the remaining cores.
+ *
+ * @param ppxIdleTaskTCBBuffer A handle to a statically allocated TCB buffer
+ * @param ppxIdleTaskStackBuffer A handle to a statically allocated Stack buffer for the idle task
+ * @param pulIdleTaskStackSize A pointer to the number of elements that will fit in the allocated stack buffer
+ * @param xPassiveIdleTaskIndex The index of the passive idle task, from 0 to ( configNUMBER_OF_CORES - 2 )
+ */
+    #if ( configNUMBER_OF_CORES > 1 )
+        void vApplicationGetPassiveIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                                   StackType_t ** ppxIdleTaskStackBuffer,
+                                                   uint32_t * pulIdleTaskStackSize,
+                                                   BaseType_t xPassiveIdleTaskIndex ); /*lint !e526 Symbol not defined as it is an application callback. */
+    #endif
 #endif
 
 /**
@@ -1708,6 +1869,18 @@ BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
  */
 TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * xTaskGetIdleTaskHandleForCore() is only available if
+ * INCLUDE_xTaskGetIdleTaskHandle is set to 1 in FreeRTOSConfig.h and
+ * configNUMBER_OF_CORES is greater than 1.
+ *
+ * Returns the handle of the idle task of core xCoreID.
+ * xTaskGetIdleTaskHandle() returns the handle of the idle task of core 0.
+ */
+#if ( configNUMBER_OF_CORES > 1 )
+    TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * configUSE_TRACE_FACILITY must be defined as 1 in FreeRTOSConfig.h for
  * uxTaskGetSystemState() to be available.
@@ -1809,6 +1982,69 @@ UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
                                   const UBaseType_t uxArraySize,
                                   configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetCriticalSectionStats( CriticalSectionStats_t * const pxStatsArray, const UBaseType_t uxArraySize, uint32_t * const pulDropped );
+ * @endcode
+ *
+ * configGENERATE_CRITICAL_SECTION_STATS must be defined as 1 for this function
+ * to be available.  portGET_CRITICAL_SECTION_TIMESTAMP() must also be defined
+ * to return the value of a free running 32-bit counter.
+ *
+ * Each time the kernel or the application masks interrupts with
+ * taskENTER_CRITICAL() (or taskENTER_CRITICAL_FROM_ISR()), or suspends the
+ * scheduler with vTaskSuspendAll(), the time until the matching exit is
+ * measured and accumulated against the file and line that entered the region.
+ * uxTaskGetCriticalSectionStats() copies one CriticalSectionStats_t structure
+ * per recorded call site into pxStatsArray.  The ulMaxDuration members show
+ * which call sites set the worst case interrupt latency of the system.
+ *
+ * Call sites are recorded in the order in which they were first reached.  Up
+ * to configCRITICAL_SECTION_STATS_MAX_SITES call sites can be recorded.
+ *
+ * NOTE: This function is intended for debugging use only as its use results in
+ * the scheduler remaining suspended and interrupts being masked briefly for
+ * each structure that is copied.  Recording itself adds a few instructions, and
+ * a search of the call site table, to every critical section.
+ *
+ * @param pxStatsArray An array of CriticalSectionStats_t structures into which
+ * the statistics are copied.
+ *
+ * @param uxArraySize The number of structures in pxStatsArray.
+ *
+ * @param pulDropped If not NULL, set to the number of regions that were not
+ * recorded because the call site table was full.
+ *
+ * @return The number of CriticalSectionStats_t structures that were populated.
+ *
+ * \defgroup uxTaskGetCriticalSectionStats uxTaskGetCriticalSectionStats
+ * \ingroup TaskUtils
+ */
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+    UBaseType_t uxTaskGetCriticalSectionStats( CriticalSectionStats_t * const pxStatsArray,
+                                               const UBaseType_t uxArraySize,
+                                               uint32_t * const pulDropped ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskClearCriticalSectionStats( void );
+ * @endcode
+ *
+ * Zeros the counts, durations and histograms of every recorded call site, and
+ * the dropped region count, so a new measurement interval can be started.
+ * configGENERATE_CRITICAL_SECTION_STATS must be defined as 1 for this function
+ * to be available.
+ *
+ * \defgroup vTaskClearCriticalSectionStats vTaskClearCriticalSectionStats
+ * \ingroup TaskUtils
+ */
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+    void vTaskClearCriticalSectionStats( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -2448,6 +2684,68 @@ BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn,
 #define xTaskNotifyGiveIndexed( xTaskToNotify, uxIndexToNotify ) \
     xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( 0 ), eIncrement, NULL )
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskNotifyGroupIndexed( TaskHandle_t const * pxTasksToNotify, UBaseType_t uxNumberOfTasks, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction );
+ * BaseType_t xTaskNotifyGroup( TaskHandle_t const * pxTasksToNotify, UBaseType_t uxNumberOfTasks, uint32_t ulValue, eNotifyAction eAction );
+ * BaseType_t xTaskNotifyGiveGroup( TaskHandle_t const * pxTasksToNotify, UBaseType_t uxNumberOfTasks );
+ * @endcode
+ *
+ * Sends the same direct to task notification to each task in an array of task
+ * handles, as if xTaskNotifyIndexed() was called once for each task.
+ *
+ * See https://www.FreeRTOS.org/RTOS-task-notifications.html for more details.
+ *
+ * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for these
+ * functions to be available.
+ *
+ * All the tasks are notified from within a single critical section, and the
+ * calling task yields at most once - and then only if the highest priority task
+ * that was unblocked has a priority above its own - so signalling a group of
+ * tasks costs much less than notifying each task in turn.  The critical
+ * section lasts for as long as it takes to notify every task in the array, so
+ * very large arrays will add to interrupt latency.
+ *
+ * xTaskNotifyGroup() always sends notifications to index 0 of each task's
+ * notification array, and xTaskNotifyGiveGroup() is the group equivalent of
+ * xTaskNotifyGive().
+ *
+ * @param pxTasksToNotify An array holding the handles of the tasks being
+ * notified.  Each handle must be valid.
+ *
+ * @param uxNumberOfTasks The number of handles in pxTasksToNotify.
+ *
+ * @param uxIndexToNotify The index within each target task's array of
+ * notification values to which the notification is to be sent.
+ * uxIndexToNotify must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.
+ *
+ * @param ulValue Data that can be sent with the notification.  How the data is
+ * used depends on the value of the eAction parameter.
+ *
+ * @param eAction Specifies how the notification updates each task's
+ * notification value, exactly as for xTaskNotifyIndexed().
+ *
+ * @return If eAction is set to eSetValueWithoutOverwrite and the notification
+ * value of any of the tasks could not be written because that task already had
+ * a notification pending then pdFAIL is returned - the other tasks are still
+ * notified.  In all other cases pdPASS is returned.
+ *
+ * \defgroup xTaskNotifyGroupIndexed xTaskNotifyGroupIndexed
+ * \ingroup TaskNotifications
+ */
+BaseType_t xTaskGenericNotifyGroup( TaskHandle_t const * pxTasksToNotify,
+                                    UBaseType_t uxNumberOfTasks,
+                                    UBaseType_t uxIndexToNotify,
+                                    uint32_t ulValue,
+                                    eNotifyAction eAction ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyGroup( pxTasksToNotify, uxNumberOfTasks, ulValue, eAction ) \
+    xTaskGenericNotifyGroup( ( pxTasksToNotify ), ( uxNumberOfTasks ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ) )
+#define xTaskNotifyGroupIndexed( pxTasksToNotify, uxNumberOfTasks, uxIndexToNotify, ulValue, eAction ) \
+    xTaskGenericNotifyGroup( ( pxTasksToNotify ), ( uxNumberOfTasks ), ( uxIndexToNotify ), ( ulValue ), ( eAction ) )
+#define xTaskNotifyGiveGroup( pxTasksToNotify, uxNumberOfTasks ) \
+    xTaskGenericNotifyGroup( ( pxTasksToNotify ), ( uxNumberOfTasks ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( 0 ), eIncrement )
+
 /**
  * task. h
  * @code{c}
@@ -3024,12 +3322,42 @@ TickType_t uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t xTaskGetCurrentTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Return the handle of the task running on core xCoreID.
+ */
+#if ( configNUMBER_OF_CORES > 1 )
+    TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Shortcut used by the queue implementation to prevent unnecessary call to
  * taskYIELD();
  */
 void vTaskMissedYield( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE ONLY
+ * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER THAT HOLDS THE
+ * CRITICAL NESTING COUNT IN THE TCB.
+ *
+ * When configNUMBER_OF_CORES is greater than 1 vTaskEnterCritical() and
+ * vTaskExitCritical() also take and release the kernel spinlocks, and
+ * uxTaskEnterCriticalFromISR() and vTaskExitCriticalFromISR() are the
+ * equivalents for use from an interrupt.  vTaskYieldWithinAPI() yields the
+ * calling core, or holds the yield pending if the caller is in a critical
+ * section.
+ */
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+    void vTaskEnterCritical( void ) PRIVILEGED_FUNCTION;
+    void vTaskExitCritical( void ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configNUMBER_OF_CORES > 1 )
+    UBaseType_t uxTaskEnterCriticalFromISR( void ) PRIVILEGED_FUNCTION;
+    void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus ) PRIVILEGED_FUNCTION;
+    void vTaskYieldWithinAPI( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Returns the scheduler state as taskSCHEDULER_RUNNING,
  * taskSCHEDULER_NOT_STARTED or taskSCHEDULER_SUSPENDED.
@@ -3109,6 +3437,22 @@ TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
  */
 void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Called by taskENTER_CRITICAL() and
+ * taskEXIT_CRITICAL() when configGENERATE_CRITICAL_SECTION_STATS is 1 to time
+ * the region between them.  MUST BE CALLED WITH INTERRUPTS MASKED.  The FromISR
+ * version returns uxSavedInterruptStatus unchanged so it can be used within
+ * taskENTER_CRITICAL_FROM_ISR().
+ */
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+    void vTaskCriticalSectionStatsEnter( const char * pcFile,
+                                         uint32_t ulLine ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    UBaseType_t uxTaskCriticalSectionStatsEnterFromISR( UBaseType_t uxSavedInterruptStatus,
+                                                        const char * pcFile,
+                                                        uint32_t ulLine ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    void vTaskCriticalSectionStatsExit( void ) PRIVILEGED_FUNCTION;
+#endif
+
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
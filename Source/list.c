@@ -52,7 +52,15 @@ void vListInitialise( List_t * const pxList )
     /* The list structure contains a list item which is used to mark the
      * end of the list.  To initialise the list the list end is inserted
      * as the only list entry. */
-    pxList->pxIndex = ( ListItem_t * ) &( pxList->xListEnd ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+    #if ( configUSE_COMPACT_LIST_ITEMS == 1 )
+    {
+        /* The list, and the items placed in it, must lie within the list arena
+         * for the links between them to be held as indexes. */
+        configASSERT( listIS_IN_ARENA( pxList ) );
+    }
+    #endif
+
+    listLIST_SET_INDEX( pxList, ( ListItem_t * ) &( pxList->xListEnd ) ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
 
     listSET_FIRST_LIST_ITEM_INTEGRITY_CHECK_VALUE( &( pxList->xListEnd ) );
 
@@ -62,19 +70,23 @@ void vListInitialise( List_t * const pxList )
 
     /* The list end next and previous pointers point to itself so we know
      * when the list is empty. */
-    pxList->xListEnd.pxNext = ( ListItem_t * ) &( pxList->xListEnd );     /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
-    pxList->xListEnd.pxPrevious = ( ListItem_t * ) &( pxList->xListEnd ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+    listITEM_SET_NEXT( &( pxList->xListEnd ), ( ListItem_t * ) &( pxList->xListEnd ) );     /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+    listITEM_SET_PREVIOUS( &( pxList->xListEnd ), ( ListItem_t * ) &( pxList->xListEnd ) ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
 
     /* Initialize the remaining fields of xListEnd when it is a proper ListItem_t */
     #if ( configUSE_MINI_LIST_ITEM == 0 )
     {
-        pxList->xListEnd.pvOwner = NULL;
-        pxList->xListEnd.pxContainer = NULL;
+        #if ( configUSE_COMPACT_LIST_ITEMS == 1 )
+            pxList->xListEnd.usOwner = ( ListIndex_t ) 0U;
+        #else
+            pxList->xListEnd.pvOwner = NULL;
+        #endif
+        listITEM_CLEAR_CONTAINER( &( pxList->xListEnd ) );
         listSET_SECOND_LIST_ITEM_INTEGRITY_CHECK_VALUE( &( pxList->xListEnd ) );
     }
     #endif
 
-    pxList->uxNumberOfItems = ( UBaseType_t ) 0U;
+    listLIST_NUMBER_OF_ITEMS( pxList ) = ( UBaseType_t ) 0U;
 
     /* Write known values into the list if
      * configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
@@ -85,8 +97,17 @@ void vListInitialise( List_t * const pxList )
 
 void vListInitialiseItem( ListItem_t * const pxItem )
 {
+    #if ( configUSE_COMPACT_LIST_ITEMS == 1 )
+    {
+        /* The item is linked to other items, and to its owner, by index, so
+         * must lie within the list arena.  Its owner is normally the object
+         * that contains it. */
+        configASSERT( listIS_IN_ARENA( pxItem ) );
+    }
+    #endif
+
     /* Make sure the list item is not recorded as being on a list. */
-    pxItem->pxContainer = NULL;
+    listITEM_CLEAR_CONTAINER( pxItem );
 
     /* Write known values into the list item if
      * configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
@@ -98,7 +119,7 @@ void vListInitialiseItem( ListItem_t * const pxItem )
 void vListInsertEnd( List_t * const pxList,
                      ListItem_t * const pxNewListItem )
 {
-    ListItem_t * const pxIndex = pxList->pxIndex;
+    ListItem_t * const pxIndex = listLIST_INDEX( pxList );
 
     /* Only effective when configASSERT() is also defined, these tests may catch
      * the list data structures being overwritten in memory.  They will not catch
@@ -109,19 +130,19 @@ void vListInsertEnd( List_t * const pxList,
     /* Insert a new list item into pxList, but rather than sort the list,
      * makes the new list item the last item to be removed by a call to
      * listGET_OWNER_OF_NEXT_ENTRY(). */
-    pxNewListItem->pxNext = pxIndex;
-    pxNewListItem->pxPrevious = pxIndex->pxPrevious;
+    listITEM_SET_NEXT( pxNewListItem, pxIndex );
+    listITEM_SET_PREVIOUS( pxNewListItem, listITEM_PREVIOUS( pxIndex ) );
 
     /* Only used during decision coverage testing. */
     mtCOVERAGE_TEST_DELAY();
 
-    pxIndex->pxPrevious->pxNext = pxNewListItem;
-    pxIndex->pxPrevious = pxNewListItem;
+    listITEM_SET_NEXT( listITEM_PREVIOUS( pxIndex ), pxNewListItem );
+    listITEM_SET_PREVIOUS( pxIndex, pxNewListItem );
 
     /* Remember which list the item is in. */
-    pxNewListItem->pxContainer = pxList;
+    listITEM_SET_CONTAINER( pxNewListItem, pxList );
 
-    ( pxList->uxNumberOfItems )++;
+    ( listLIST_NUMBER_OF_ITEMS( pxList ) )++;
 }
 /*-----------------------------------------------------------*/
 
@@ -147,7 +168,7 @@ void vListInsert( List_t * const pxList,
      * first, and the algorithm slightly modified if necessary. */
     if( xValueOfInsertion == portMAX_DELAY )
     {
-        pxIterator = pxList->xListEnd.pxPrevious;
+        pxIterator = listITEM_PREVIOUS( &( pxList->xListEnd ) );
     }
     else
     {
@@ -176,23 +197,23 @@ void vListInsert( List_t * const pxList,
         *      configMAX_SYSCALL_INTERRUPT_PRIORITY.
         **********************************************************************/
 
-        for( pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); pxIterator->pxNext->xItemValue <= xValueOfInsertion; pxIterator = pxIterator->pxNext ) /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. *//*lint !e440 The iterator moves to a different value, not xValueOfInsertion. */
+        for( pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); listITEM_NEXT( pxIterator )->xItemValue <= xValueOfInsertion; pxIterator = listITEM_NEXT( pxIterator ) ) /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. *//*lint !e440 The iterator moves to a different value, not xValueOfInsertion. */
         {
             /* There is nothing to do here, just iterating to the wanted
              * insertion position. */
         }
     }
 
-    pxNewListItem->pxNext = pxIterator->pxNext;
-    pxNewListItem->pxNext->pxPrevious = pxNewListItem;
-    pxNewListItem->pxPrevious = pxIterator;
-    pxIterator->pxNext = pxNewListItem;
+    listITEM_SET_NEXT( pxNewListItem, listITEM_NEXT( pxIterator ) );
+    listITEM_SET_PREVIOUS( listITEM_NEXT( pxNewListItem ), pxNewListItem );
+    listITEM_SET_PREVIOUS( pxNewListItem, pxIterator );
+    listITEM_SET_NEXT( pxIterator, pxNewListItem );
 
     /* Remember which list the item is in.  This allows fast removal of the
      * item later. */
-    pxNewListItem->pxContainer = pxList;
+    listITEM_SET_CONTAINER( pxNewListItem, pxList );
 
-    ( pxList->uxNumberOfItems )++;
+    ( listLIST_NUMBER_OF_ITEMS( pxList ) )++;
 }
 /*-----------------------------------------------------------*/
 
@@ -200,27 +221,27 @@ UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove )
 {
 /* The list item knows which list it is in.  Obtain the list from the list
  * item. */
-    List_t * const pxList = pxItemToRemove->pxContainer;
+    List_t * const pxList = listITEM_CONTAINER( pxItemToRemove );
 
-    pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
-    pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
+    listITEM_SET_PREVIOUS( listITEM_NEXT( pxItemToRemove ), listITEM_PREVIOUS( pxItemToRemove ) );
+    listITEM_SET_NEXT( listITEM_PREVIOUS( pxItemToRemove ), listITEM_NEXT( pxItemToRemove ) );
 
     /* Only used during decision coverage testing. */
     mtCOVERAGE_TEST_DELAY();
 
     /* Make sure the index is left pointing to a valid item. */
-    if( pxList->pxIndex == pxItemToRemove )
+    if( listLIST_INDEX( pxList ) == pxItemToRemove )
     {
-        pxList->pxIndex = pxItemToRemove->pxPrevious;
+        listLIST_SET_INDEX( pxList, listITEM_PREVIOUS( pxItemToRemove ) );
     }
     else
     {
         mtCOVERAGE_TEST_MARKER();
     }
 
-    pxItemToRemove->pxContainer = NULL;
-    ( pxList->uxNumberOfItems )--;
+    listITEM_CLEAR_CONTAINER( pxItemToRemove );
+    ( listLIST_NUMBER_OF_ITEMS( pxList ) )--;
 
-    return pxList->uxNumberOfItems;
+    return listLIST_NUMBER_OF_ITEMS( pxList );
 }
 /*-----------------------------------------------------------*/
@@ -980,6 +980,36 @@
     #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+        BaseType_t MPU_xTaskGenericNotifyGroup( TaskHandle_t const * pxTasksToNotify,
+                                                UBaseType_t uxNumberOfTasks,
+                                                UBaseType_t uxIndexToNotify,
+                                                uint32_t ulValue,
+                                                eNotifyAction eAction ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xTaskGenericNotifyGroup( pxTasksToNotify, uxNumberOfTasks, uxIndexToNotify, ulValue, eAction );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xTaskGenericNotifyGroup( pxTasksToNotify, uxNumberOfTasks, uxIndexToNotify, ulValue, eAction );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+/*-----------------------------------------------------------*/
+
     #if ( configUSE_TASK_NOTIFICATIONS == 1 )
         BaseType_t MPU_xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn,
                                                uint32_t ulBitsToClearOnEntry,
@@ -2505,6 +2535,283 @@
     #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+/* The system call table used by MPU_xSystemCallBatch().  Each entry makes the
+ * call with the arguments held in a SystemCall_t, and is only called once the
+ * privilege level has been raised.  The entries for API functions excluded
+ * from the build are NULL.
+ *
+ * The table is indexed here, in privileged thread mode, and not by the SVC
+ * handler.  The SVC handler still only raises the privilege level.  A call
+ * that blocks pends PendSV and must then return to thread mode for the switch
+ * to happen, which it cannot do from inside the SVC handler (PendSV has the
+ * lowest priority), and dispatching from the handler would also need every
+ * task to have a privileged stack of its own to run the kernel function on.
+ * Batching the calls gives the saving the dispatch table was for - one SVC
+ * for several calls - without either. */
+    typedef uint32_t ( * SystemCallFunction_t )( uint32_t * pulArgs );
+
+    static BaseType_t prvSystemCallBuffersAccessible( const SystemCall_t * pxCall ) PRIVILEGED_FUNCTION;
+
+    static uint32_t prvSystemCallQueueGenericSend( uint32_t * pulArgs ) PRIVILEGED_FUNCTION;
+    static uint32_t prvSystemCallQueueReceive( uint32_t * pulArgs ) PRIVILEGED_FUNCTION;
+    static uint32_t prvSystemCallQueuePeek( uint32_t * pulArgs ) PRIVILEGED_FUNCTION;
+    static uint32_t prvSystemCallQueueSemaphoreTake( uint32_t * pulArgs ) PRIVILEGED_FUNCTION;
+    static uint32_t prvSystemCallEventGroupSetBits( uint32_t * pulArgs ) PRIVILEGED_FUNCTION;
+    static uint32_t prvSystemCallEventGroupClearBits( uint32_t * pulArgs ) PRIVILEGED_FUNCTION;
+    static uint32_t prvSystemCallStreamBufferSend( uint32_t * pulArgs ) PRIVILEGED_FUNCTION;
+    static uint32_t prvSystemCallStreamBufferReceive( uint32_t * pulArgs ) PRIVILEGED_FUNCTION;
+    static uint32_t prvSystemCallTaskGetTickCount( uint32_t * pulArgs ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+        static uint32_t prvSystemCallTaskGenericNotify( uint32_t * pulArgs ) PRIVILEGED_FUNCTION;
+        static uint32_t prvSystemCallTaskGenericNotifyWait( uint32_t * pulArgs ) PRIVILEGED_FUNCTION;
+    #endif
+
+    #if ( INCLUDE_vTaskDelay == 1 )
+        static uint32_t prvSystemCallTaskDelay( uint32_t * pulArgs ) PRIVILEGED_FUNCTION;
+    #endif
+
+    #if ( configUSE_TIMERS == 1 )
+        static uint32_t prvSystemCallTimerGenericCommand( uint32_t * pulArgs ) PRIVILEGED_FUNCTION;
+    #endif
+
+    static const SystemCallFunction_t pxSystemCallTable[ eSystemCallNumberOfCalls ] =
+    {
+        prvSystemCallQueueGenericSend,      /* eSystemCallQueueGenericSend. */
+        prvSystemCallQueueReceive,          /* eSystemCallQueueReceive. */
+        prvSystemCallQueuePeek,             /* eSystemCallQueuePeek. */
+        prvSystemCallQueueSemaphoreTake,    /* eSystemCallQueueSemaphoreTake. */
+        #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+            prvSystemCallTaskGenericNotify,     /* eSystemCallTaskGenericNotify. */
+            prvSystemCallTaskGenericNotifyWait, /* eSystemCallTaskGenericNotifyWait. */
+        #else
+            NULL,
+            NULL,
+        #endif
+        prvSystemCallEventGroupSetBits,     /* eSystemCallEventGroupSetBits. */
+        prvSystemCallEventGroupClearBits,   /* eSystemCallEventGroupClearBits. */
+        prvSystemCallStreamBufferSend,      /* eSystemCallStreamBufferSend. */
+        prvSystemCallStreamBufferReceive,   /* eSystemCallStreamBufferReceive. */
+        #if ( INCLUDE_vTaskDelay == 1 )
+            prvSystemCallTaskDelay,         /* eSystemCallTaskDelay. */
+        #else
+            NULL,
+        #endif
+        prvSystemCallTaskGetTickCount,      /* eSystemCallTaskGetTickCount. */
+        #if ( configUSE_TIMERS == 1 )
+            prvSystemCallTimerGenericCommand /* eSystemCallTimerGenericCommand. */
+        #else
+            NULL
+        #endif
+    };
+/*-----------------------------------------------------------*/
+
+    UBaseType_t MPU_xSystemCallBatch( SystemCall_t * const pxCalls,
+                                      const UBaseType_t uxNumberOfCalls ) /* FREERTOS_SYSTEM_CALL */
+    {
+        UBaseType_t uxCall = 0;
+        BaseType_t xRunningPrivileged, xCallsAccessible;
+        SystemCall_t xCall;
+
+        if( pxCalls != NULL )
+        {
+            xRunningPrivileged = portIS_PRIVILEGED();
+
+            if( xRunningPrivileged == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                /* The calls are written back once made, so the task must be
+                 * able to write the whole array itself.  The check reads the
+                 * MPU, so it can only be made once privileged, but it is made
+                 * before any call is. */
+                xCallsAccessible = pdFALSE;
+
+                if( ( ( uxNumberOfCalls * sizeof( SystemCall_t ) ) / sizeof( SystemCall_t ) ) == uxNumberOfCalls )
+                {
+                    xCallsAccessible = xPortIsAuthorizedToAccessBuffer( pxCalls,
+                                                                        ( uint32_t ) ( uxNumberOfCalls * sizeof( SystemCall_t ) ),
+                                                                        tskMPU_READ_PERMISSION | tskMPU_WRITE_PERMISSION );
+                }
+            }
+            else
+            {
+                xCallsAccessible = pdTRUE;
+            }
+
+            /* Each call is copied before it is checked, so it cannot be changed
+             * between the check and the call.  A bad call number stops the
+             * batch rather than calling through an address taken from outside
+             * the table, and for an unprivileged task so does a buffer it could
+             * not have accessed itself. */
+            while( ( xCallsAccessible != pdFALSE ) && ( uxCall < uxNumberOfCalls ) )
+            {
+                xCall = pxCalls[ uxCall ];
+
+                if( ( ( uint32_t ) xCall.eCall >= ( uint32_t ) eSystemCallNumberOfCalls ) ||
+                    ( pxSystemCallTable[ xCall.eCall ] == NULL ) ||
+                    ( ( xRunningPrivileged == pdFALSE ) && ( prvSystemCallBuffersAccessible( &xCall ) == pdFALSE ) ) )
+                {
+                    break;
+                }
+
+                xCall.ulReturn = pxSystemCallTable[ xCall.eCall ]( xCall.ulArgs );
+                pxCalls[ uxCall ] = xCall;
+                uxCall++;
+            }
+
+            portMEMORY_BARRIER();
+
+            if( xRunningPrivileged == pdFALSE )
+            {
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+        }
+
+        return uxCall;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvSystemCallBuffersAccessible( const SystemCall_t * pxCall ) /* PRIVILEGED_FUNCTION */
+    {
+        BaseType_t xReturn = pdTRUE;
+
+        switch( pxCall->eCall )
+        {
+            case eSystemCallQueueGenericSend:
+            case eSystemCallQueueReceive:
+            case eSystemCallQueuePeek:
+
+                /* The length of the buffer is the item size of the queue, which
+                 * cannot be read through a NULL handle. */
+                if( pxCall->ulArgs[ 0 ] == 0UL )
+                {
+                    xReturn = pdFALSE;
+                }
+                else
+                {
+                    xReturn = xPortIsAuthorizedToAccessBuffer( ( const void * ) pxCall->ulArgs[ 1 ],
+                                                               ( uint32_t ) uxQueueGetQueueItemSize( ( QueueHandle_t ) pxCall->ulArgs[ 0 ] ),
+                                                               ( pxCall->eCall == eSystemCallQueueGenericSend ) ? tskMPU_READ_PERMISSION : tskMPU_WRITE_PERMISSION );
+                }
+
+                break;
+
+            case eSystemCallStreamBufferSend:
+                xReturn = xPortIsAuthorizedToAccessBuffer( ( const void * ) pxCall->ulArgs[ 1 ], pxCall->ulArgs[ 2 ], tskMPU_READ_PERMISSION );
+                break;
+
+            case eSystemCallStreamBufferReceive:
+                xReturn = xPortIsAuthorizedToAccessBuffer( ( const void * ) pxCall->ulArgs[ 1 ], pxCall->ulArgs[ 2 ], tskMPU_WRITE_PERMISSION );
+                break;
+
+            default:
+                /* The other calls are not passed a buffer. */
+                break;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static uint32_t prvSystemCallQueueGenericSend( uint32_t * pulArgs ) /* PRIVILEGED_FUNCTION */
+    {
+        return ( uint32_t ) xQueueGenericSend( ( QueueHandle_t ) pulArgs[ 0 ], ( const void * ) pulArgs[ 1 ], ( TickType_t ) pulArgs[ 2 ], ( BaseType_t ) pulArgs[ 3 ] );
+    }
+/*-----------------------------------------------------------*/
+
+    static uint32_t prvSystemCallQueueReceive( uint32_t * pulArgs ) /* PRIVILEGED_FUNCTION */
+    {
+        return ( uint32_t ) xQueueReceive( ( QueueHandle_t ) pulArgs[ 0 ], ( void * ) pulArgs[ 1 ], ( TickType_t ) pulArgs[ 2 ] );
+    }
+/*-----------------------------------------------------------*/
+
+    static uint32_t prvSystemCallQueuePeek( uint32_t * pulArgs ) /* PRIVILEGED_FUNCTION */
+    {
+        return ( uint32_t ) xQueuePeek( ( QueueHandle_t ) pulArgs[ 0 ], ( void * ) pulArgs[ 1 ], ( TickType_t ) pulArgs[ 2 ] );
+    }
+/*-----------------------------------------------------------*/
+
+    static uint32_t prvSystemCallQueueSemaphoreTake( uint32_t * pulArgs ) /* PRIVILEGED_FUNCTION */
+    {
+        return ( uint32_t ) xQueueSemaphoreTake( ( QueueHandle_t ) pulArgs[ 0 ], ( TickType_t ) pulArgs[ 1 ] );
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+        static uint32_t prvSystemCallTaskGenericNotify( uint32_t * pulArgs ) /* PRIVILEGED_FUNCTION */
+        {
+            return ( uint32_t ) xTaskGenericNotify( ( TaskHandle_t ) pulArgs[ 0 ], ( UBaseType_t ) pulArgs[ 1 ], pulArgs[ 2 ], ( eNotifyAction ) pulArgs[ 3 ], NULL );
+        }
+    #endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+        static uint32_t prvSystemCallTaskGenericNotifyWait( uint32_t * pulArgs ) /* PRIVILEGED_FUNCTION */
+        {
+            uint32_t ulNotificationValue = 0;
+            BaseType_t xReturn;
+
+            xReturn = xTaskGenericNotifyWait( ( UBaseType_t ) pulArgs[ 0 ], pulArgs[ 1 ], pulArgs[ 2 ], &ulNotificationValue, ( TickType_t ) pulArgs[ 3 ] );
+            pulArgs[ 0 ] = ulNotificationValue;
+
+            return ( uint32_t ) xReturn;
+        }
+    #endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+    static uint32_t prvSystemCallEventGroupSetBits( uint32_t * pulArgs ) /* PRIVILEGED_FUNCTION */
+    {
+        return ( uint32_t ) xEventGroupSetBits( ( EventGroupHandle_t ) pulArgs[ 0 ], ( EventBits_t ) pulArgs[ 1 ] );
+    }
+/*-----------------------------------------------------------*/
+
+    static uint32_t prvSystemCallEventGroupClearBits( uint32_t * pulArgs ) /* PRIVILEGED_FUNCTION */
+    {
+        return ( uint32_t ) xEventGroupClearBits( ( EventGroupHandle_t ) pulArgs[ 0 ], ( EventBits_t ) pulArgs[ 1 ] );
+    }
+/*-----------------------------------------------------------*/
+
+    static uint32_t prvSystemCallStreamBufferSend( uint32_t * pulArgs ) /* PRIVILEGED_FUNCTION */
+    {
+        return ( uint32_t ) xStreamBufferSend( ( StreamBufferHandle_t ) pulArgs[ 0 ], ( const void * ) pulArgs[ 1 ], ( size_t ) pulArgs[ 2 ], ( TickType_t ) pulArgs[ 3 ] );
+    }
+/*-----------------------------------------------------------*/
+
+    static uint32_t prvSystemCallStreamBufferReceive( uint32_t * pulArgs ) /* PRIVILEGED_FUNCTION */
+    {
+        return ( uint32_t ) xStreamBufferReceive( ( StreamBufferHandle_t ) pulArgs[ 0 ], ( void * ) pulArgs[ 1 ], ( size_t ) pulArgs[ 2 ], ( TickType_t ) pulArgs[ 3 ] );
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( INCLUDE_vTaskDelay == 1 )
+        static uint32_t prvSystemCallTaskDelay( uint32_t * pulArgs ) /* PRIVILEGED_FUNCTION */
+        {
+            vTaskDelay( ( TickType_t ) pulArgs[ 0 ] );
+
+            return ( uint32_t ) pdPASS;
+        }
+    #endif /* INCLUDE_vTaskDelay */
+/*-----------------------------------------------------------*/
+
+    static uint32_t prvSystemCallTaskGetTickCount( uint32_t * pulArgs ) /* PRIVILEGED_FUNCTION */
+    {
+        ( void ) pulArgs;
+
+        return ( uint32_t ) xTaskGetTickCount();
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMERS == 1 )
+        static uint32_t prvSystemCallTimerGenericCommand( uint32_t * pulArgs ) /* PRIVILEGED_FUNCTION */
+        {
+            return ( uint32_t ) xTimerGenericCommand( ( TimerHandle_t ) pulArgs[ 0 ], ( BaseType_t ) pulArgs[ 1 ], ( TickType_t ) pulArgs[ 2 ], NULL, ( TickType_t ) pulArgs[ 3 ] );
+        }
+    #endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
 
 /* Functions that the application writer wants to execute in privileged mode
  * can be defined in application_defined_privileged_functions.h.  The functions
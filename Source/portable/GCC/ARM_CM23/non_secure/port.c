@@ -135,6 +135,8 @@
 #define portMPU_RBAR_ADDRESS_MASK             ( 0xffffffe0 ) /* Must be 32-byte aligned. */
 #define portMPU_RLAR_ADDRESS_MASK             ( 0xffffffe0 ) /* Must be 32-byte aligned. */
 
+#define portMPU_RBAR_ACCESS_PERMISSIONS_MASK  ( 3UL << 1UL )
+
 #define portMPU_MAIR_ATTR0_POS                ( 0UL )
 #define portMPU_MAIR_ATTR0_MASK               ( 0x000000ff )
 
@@ -1237,6 +1239,88 @@ void vPortEndScheduler( void ) /* PRIVILEGED_FUNCTION */
 #endif /* configENABLE_MPU */
 /*-----------------------------------------------------------*/
 
+#if ( configENABLE_MPU == 1 )
+    BaseType_t xPortIsAuthorizedToAccessBuffer( const void * pvBuffer,
+                                                uint32_t ulBufferLength,
+                                                uint32_t ulAccessRequested ) /* PRIVILEGED_FUNCTION */
+    {
+        uint32_t ulBufferStartAddress, ulBufferEndAddress;
+        uint32_t ulRegionStartAddress, ulRegionEndAddress, ulRegionLimit, ulRegionPermissions;
+        uint32_t ulRegionNumber;
+        BaseType_t xAccessGranted = pdFALSE, xSearchComplete = pdFALSE;
+
+        ulBufferStartAddress = ( uint32_t ) pvBuffer;
+        ulBufferEndAddress = ulBufferStartAddress + ulBufferLength - 1UL;
+
+        if( ulBufferLength == 0UL )
+        {
+            /* Nothing will be accessed. */
+            xAccessGranted = pdTRUE;
+        }
+        else if( ulBufferEndAddress >= ulBufferStartAddress )
+        {
+            /* The regions are read back from the MPU, which holds those of the
+             * calling task, so the regions set up by prvSetupMPU() are checked
+             * too.  An access to an address in more than one region faults, so
+             * the buffer must be in a region that grants the access and no other
+             * region may cover any of it.  A context switch also writes the
+             * region number register, hence the critical section. */
+            portENTER_CRITICAL();
+            {
+                for( ulRegionNumber = 0UL; ( ulRegionNumber < configTOTAL_MPU_REGIONS ) && ( xSearchComplete == pdFALSE ); ulRegionNumber++ )
+                {
+                    portMPU_RNR_REG = ulRegionNumber;
+                    ulRegionLimit = portMPU_RLAR_REG;
+
+                    if( ( ulRegionLimit & portMPU_RLAR_REGION_ENABLE ) != 0UL )
+                    {
+                        ulRegionStartAddress = portMPU_RBAR_REG & portMPU_RBAR_ADDRESS_MASK;
+                        ulRegionEndAddress = ( ulRegionLimit & portMPU_RLAR_ADDRESS_MASK ) | ~portMPU_RLAR_ADDRESS_MASK;
+                        ulRegionPermissions = portMPU_RBAR_REG & portMPU_RBAR_ACCESS_PERMISSIONS_MASK;
+
+                        if( ulRegionPermissions == portMPU_REGION_READ_WRITE )
+                        {
+                            ulRegionPermissions = tskMPU_READ_PERMISSION | tskMPU_WRITE_PERMISSION;
+                        }
+                        else if( ulRegionPermissions == portMPU_REGION_READ_ONLY )
+                        {
+                            ulRegionPermissions = tskMPU_READ_PERMISSION;
+                        }
+                        else
+                        {
+                            ulRegionPermissions = 0UL;
+                        }
+
+                        if( ( ulBufferStartAddress <= ulRegionEndAddress ) && ( ulBufferEndAddress >= ulRegionStartAddress ) )
+                        {
+                            if( ( xAccessGranted != pdFALSE ) ||
+                                ( ( ulRegionPermissions & ulAccessRequested ) != ulAccessRequested ) ||
+                                ( ulBufferStartAddress < ulRegionStartAddress ) ||
+                                ( ulBufferEndAddress > ulRegionEndAddress ) )
+                            {
+                                xAccessGranted = pdFALSE;
+                                xSearchComplete = pdTRUE;
+                            }
+                            else
+                            {
+                                xAccessGranted = pdTRUE;
+                            }
+                        }
+                    }
+                }
+            }
+            portEXIT_CRITICAL();
+        }
+        else
+        {
+            /* The buffer wraps around the end of the address space. */
+        }
+
+        return xAccessGranted;
+    }
+#endif /* configENABLE_MPU */
+/*-----------------------------------------------------------*/
+
 BaseType_t xPortIsInsideInterrupt( void )
 {
     uint32_t ulCurrentInterrupt;
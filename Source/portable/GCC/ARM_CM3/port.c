@@ -74,6 +74,33 @@
 /* Constants required to set up the initial stack. */
 #define portINITIAL_XPSR                      ( 0x01000000UL )
 
+/* Constants required to guard the end of each task's stack with the MPU when
+ * configCHECK_FOR_STACK_OVERFLOW is set to 3. */
+#define portNVIC_SYS_CTRL_STATE_REG           ( *( ( volatile uint32_t * ) 0xe000ed24 ) )
+#define portNVIC_MEM_FAULT_STATUS_REG         ( *( ( volatile uint8_t * ) 0xe000ed28 ) )
+#define portNVIC_MEM_FAULT_ADDRESS_REG        ( *( ( volatile uint32_t * ) 0xe000ed34 ) )
+#define portMPU_TYPE_REG                      ( *( ( volatile uint32_t * ) 0xe000ed90 ) )
+#define portMPU_CTRL_REG                      ( *( ( volatile uint32_t * ) 0xe000ed94 ) )
+#define portMPU_REGION_NUMBER_REG             ( *( ( volatile uint32_t * ) 0xe000ed98 ) )
+#define portMPU_REGION_BASE_ADDRESS_REG       ( *( ( volatile uint32_t * ) 0xe000ed9c ) )
+#define portMPU_REGION_ATTRIBUTE_REG          ( *( ( volatile uint32_t * ) 0xe000eda0 ) )
+#define portNVIC_MEM_FAULT_ENABLE             ( 1UL << 16UL )
+#define portNVIC_MEM_FAULT_STACKING_ERROR     ( ( uint8_t ) 0x10 )
+#define portNVIC_MEM_FAULT_ADDRESS_VALID      ( ( uint8_t ) 0x80 )
+#define portMPU_TYPE_DREGION_MASK             ( 0xffUL << 8UL )
+#define portMPU_TYPE_DREGION_SHIFT            ( 8UL )
+#define portMPU_ENABLE                        ( 0x01UL )
+#define portMPU_BACKGROUND_ENABLE             ( 1UL << 2UL )
+#define portMPU_REGION_BASE_ADDRESS_MASK      ( 0xffffffe0UL )
+#define portMPU_REGION_ENABLE                 ( 0x01UL )
+#define portMPU_REGION_PRIVILEGED_READ_ONLY   ( 0x05UL << 24UL )
+#define portMPU_REGION_EXECUTE_NEVER          ( 0x01UL << 28UL )
+
+/* The guard is the smallest region the MPU supports, 32 bytes, which must be
+ * aligned to its size. */
+#define portSTACK_GUARD_SIZE                  ( 32UL )
+#define portSTACK_GUARD_REGION_SIZE           ( 4UL << 1UL ) /* 2^( 4 + 1 ) bytes. */
+
 /* The systick is a 24-bit counter. */
 #define portMAX_24_BIT_NUMBER                 ( 0xffffffUL )
 
@@ -131,6 +158,21 @@ static void prvPortStartFirstTask( void ) __attribute__( ( naked ) );
  */
 static void prvTaskExitError( void );
 
+/*
+ * Setup the MPU region that guards the end of the running task's stack.
+ */
+#if ( configCHECK_FOR_STACK_OVERFLOW == 3 )
+    static void prvSetupStackGuard( void );
+#endif
+
+/*
+ * Calls the stack overflow hook if the fault was a write to the guard at the
+ * end of the running task's stack.
+ */
+#if ( configCHECK_FOR_STACK_OVERFLOW == 3 )
+    void vPortMemManageHandler( void );
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* Each task maintains its own interrupt status in the critical nesting
@@ -176,9 +218,16 @@ static UBaseType_t uxCriticalNesting = 0xaaaaaaaa;
 /*
  * See header file for description.
  */
+#if ( configCHECK_FOR_STACK_OVERFLOW == 3 )
 StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
+                                     StackType_t * pxEndOfStack,
                                      TaskFunction_t pxCode,
                                      void * pvParameters )
+#else
+StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
+                                     TaskFunction_t pxCode,
+                                     void * pvParameters )
+#endif
 {
     /* Simulate the stack frame as it would be created by a context switch
      * interrupt. */
@@ -192,6 +241,23 @@ StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
     *pxTopOfStack = ( StackType_t ) pvParameters;                        /* R0 */
     pxTopOfStack -= 8;                                                   /* R11, R10, R9, R8, R7, R6, R5 and R4. */
 
+    #if ( configCHECK_FOR_STACK_OVERFLOW == 3 )
+    {
+        uint32_t ulGuard;
+
+        /* The guard is the first 32 byte aligned block of the stack.  The
+         * context switch loads its address into the MPU along with the other
+         * registers. */
+        ulGuard = ( ( uint32_t ) pxEndOfStack + portSTACK_GUARD_SIZE - 1UL ) & portMPU_REGION_BASE_ADDRESS_MASK;
+        pxTopOfStack--;
+        *pxTopOfStack = ( StackType_t ) ulGuard;
+
+        /* The stack must be big enough to hold the initial context above the
+         * guard. */
+        configASSERT( ( uint32_t ) pxTopOfStack >= ( ulGuard + portSTACK_GUARD_SIZE ) );
+    }
+    #endif /* configCHECK_FOR_STACK_OVERFLOW */
+
     return pxTopOfStack;
 }
 /*-----------------------------------------------------------*/
@@ -228,7 +294,14 @@ void vPortSVCHandler( void )
         "	ldr	r3, pxCurrentTCBConst2		\n"/* Restore the context. */
         "	ldr r1, [r3]					\n"/* Use pxCurrentTCBConst to get the pxCurrentTCB address. */
         "	ldr r0, [r1]					\n"/* The first item in pxCurrentTCB is the task top of stack. */
-        "	ldmia r0!, {r4-r11}				\n"/* Pop the registers that are not automatically saved on exception entry and the critical nesting count. */
+        #if ( configCHECK_FOR_STACK_OVERFLOW == 3 )
+            "	ldmia r0!, {r2, r4-r11}			\n"/* Pop the stack guard address and the registers that are not automatically saved on exception entry. */
+            "	ldr r1, =0xe000ed9c				\n"/* Region Base Address register. */
+            "	str r2, [r1]					\n"/* Move the guard to the end of the task's stack. */
+            "	dsb								\n"
+        #else
+            "	ldmia r0!, {r4-r11}				\n"/* Pop the registers that are not automatically saved on exception entry and the critical nesting count. */
+        #endif
         "	msr psp, r0						\n"/* Restore the task stack pointer. */
         "	isb								\n"
         "	mov r0, #0 						\n"
@@ -236,6 +309,7 @@ void vPortSVCHandler( void )
         "	orr r14, #0xd					\n"
         "	bx r14							\n"
         "									\n"
+        "	.ltorg							\n"
         "	.align 4						\n"
         "pxCurrentTCBConst2: .word pxCurrentTCB				\n"
         );
@@ -340,6 +414,13 @@ BaseType_t xPortStartScheduler( void )
      * here already. */
     vPortSetupTimerInterrupt();
 
+    #if ( configCHECK_FOR_STACK_OVERFLOW == 3 )
+    {
+        /* Guard the end of each task's stack in hardware. */
+        prvSetupStackGuard();
+    }
+    #endif
+
     /* Initialise the critical nesting count ready for the first task. */
     uxCriticalNesting = 0;
 
@@ -409,7 +490,13 @@ void xPortPendSVHandler( void )
         "	ldr	r3, pxCurrentTCBConst			\n"/* Get the location of the current TCB. */
         "	ldr	r2, [r3]						\n"
         "										\n"
-        "	stmdb r0!, {r4-r11}					\n"/* Save the remaining registers. */
+        #if ( configCHECK_FOR_STACK_OVERFLOW == 3 )
+            "	ldr r1, =0xe000ed9c					\n"/* Region Base Address register. */
+            "	ldr r1, [r1]						\n"/* The guard at the end of this task's stack. */
+            "	stmdb r0!, {r1, r4-r11}				\n"/* Save the guard address and the remaining registers. */
+        #else
+            "	stmdb r0!, {r4-r11}					\n"/* Save the remaining registers. */
+        #endif
         "	str r0, [r2]						\n"/* Save the new top of stack into the first member of the TCB. */
         "										\n"
         "	stmdb sp!, {r3, r14}				\n"
@@ -422,11 +509,19 @@ void xPortPendSVHandler( void )
         "										\n"/* Restore the context, including the critical nesting count. */
         "	ldr r1, [r3]						\n"
         "	ldr r0, [r1]						\n"/* The first item in pxCurrentTCB is the task top of stack. */
-        "	ldmia r0!, {r4-r11}					\n"/* Pop the registers. */
+        #if ( configCHECK_FOR_STACK_OVERFLOW == 3 )
+            "	ldmia r0!, {r2, r4-r11}				\n"/* Pop the guard address and the registers. */
+            "	ldr r1, =0xe000ed9c					\n"/* Region Base Address register. */
+            "	str r2, [r1]						\n"/* Move the guard to the end of the new task's stack. */
+            "	dsb									\n"
+        #else
+            "	ldmia r0!, {r4-r11}					\n"/* Pop the registers. */
+        #endif
         "	msr psp, r0							\n"
         "	isb									\n"
         "	bx r14								\n"
         "										\n"
+        "	.ltorg								\n"
         "	.align 4							\n"
         "pxCurrentTCBConst: .word pxCurrentTCB	\n"
         ::"i" ( configMAX_SYSCALL_INTERRUPT_PRIORITY )
@@ -700,6 +795,72 @@ __attribute__( ( weak ) ) void vPortSetupTimerInterrupt( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configCHECK_FOR_STACK_OVERFLOW == 3 )
+
+    static void prvSetupStackGuard( void )
+    {
+        uint32_t ulRegions;
+
+        /* The MPU is optional on the Cortex-M3. */
+        ulRegions = ( portMPU_TYPE_REG & portMPU_TYPE_DREGION_MASK ) >> portMPU_TYPE_DREGION_SHIFT;
+        configASSERT( ulRegions != 0UL );
+
+        /* Use the highest numbered region, as it takes priority over any other
+         * region it overlaps.  The region number register is left selecting it,
+         * so the context switch only has to write the base address.  The guard
+         * covers the vector table until the first task starts. */
+        portMPU_REGION_NUMBER_REG = ulRegions - 1UL;
+        portMPU_REGION_BASE_ADDRESS_REG = 0UL;
+
+        /* Tasks run privileged, so a privileged read only region makes any
+         * write to the guard fault while still letting the kernel read the
+         * stack to find its high water mark. */
+        portMPU_REGION_ATTRIBUTE_REG = ( portMPU_REGION_PRIVILEGED_READ_ONLY ) |
+                                       ( portMPU_REGION_EXECUTE_NEVER ) |
+                                       ( portSTACK_GUARD_REGION_SIZE ) |
+                                       ( portMPU_REGION_ENABLE );
+
+        /* The background region gives privileged code the default memory map
+         * everywhere else. */
+        portNVIC_SYS_CTRL_STATE_REG |= portNVIC_MEM_FAULT_ENABLE;
+        portMPU_CTRL_REG = ( portMPU_ENABLE | portMPU_BACKGROUND_ENABLE );
+        __asm volatile ( "dsb" ::: "memory" );
+        __asm volatile ( "isb" );
+    }
+
+#endif /* configCHECK_FOR_STACK_OVERFLOW */
+/*-----------------------------------------------------------*/
+
+#if ( configCHECK_FOR_STACK_OVERFLOW == 3 )
+
+    void vPortMemManageHandler( void )
+    {
+        uint8_t ucStatus = portNVIC_MEM_FAULT_STATUS_REG;
+        uint32_t ulGuard = portMPU_REGION_BASE_ADDRESS_REG & portMPU_REGION_BASE_ADDRESS_MASK;
+
+        /* Exception entry faults while stacking when the task's stack has run
+         * into the guard, and does not record the address.  Otherwise the fault
+         * is an overflow if the address written was inside the guard. */
+        if( ( ( ucStatus & portNVIC_MEM_FAULT_STACKING_ERROR ) != 0 ) ||
+            ( ( ( ucStatus & portNVIC_MEM_FAULT_ADDRESS_VALID ) != 0 ) &&
+              ( ( portNVIC_MEM_FAULT_ADDRESS_REG - ulGuard ) < portSTACK_GUARD_SIZE ) ) )
+        {
+            vApplicationStackOverflowHook( xTaskGetCurrentTaskHandle(), pcTaskGetName( NULL ) );
+        }
+
+        /* Some other access violation, or the hook returned.  The task cannot
+         * continue, so stop here where the fault can be examined with a
+         * debugger. */
+        portDISABLE_INTERRUPTS();
+
+        for( ; ; )
+        {
+        }
+    }
+
+#endif /* configCHECK_FOR_STACK_OVERFLOW */
+/*-----------------------------------------------------------*/
+
 #if ( configASSERT_DEFINED == 1 )
 
     void vPortValidateInterruptPriority( void )
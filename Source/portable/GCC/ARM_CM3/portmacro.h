@@ -75,6 +75,13 @@
     #define portTICK_PERIOD_MS    ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
     #define portBYTE_ALIGNMENT    8
     #define portDONT_DISCARD      __attribute__( ( used ) )
+
+/* configCHECK_FOR_STACK_OVERFLOW 3 moves an MPU region to the end of each
+ * task's stack as it is switched in, in place of the checks in software.  The
+ * application must install vPortMemManageHandler() as the MemManage handler. */
+    #if ( configCHECK_FOR_STACK_OVERFLOW == 3 )
+        #define portHAS_STACK_OVERFLOW_CHECKING    1
+    #endif
 /*-----------------------------------------------------------*/
 
 /* Scheduler utilities. */
@@ -114,6 +121,15 @@
     #define portTASK_FUNCTION( vFunction, pvParameters )          void vFunction( void * pvParameters )
 /*-----------------------------------------------------------*/
 
+/* Task context profiles.  The Cortex-M3 has no optional register sets - the
+ * context switch saves r4 to r11 for every task as compiled code can use any of
+ * them - so the integer profile is the only one and
+ * portTASK_SET_CONTEXT_PROFILE() does nothing.  Defined so code shared with the
+ * Cortex-M4F port builds. */
+    #define portCONTEXT_PROFILE_INTEGER                  ( 0UL )
+    #define portTASK_SET_CONTEXT_PROFILE( uxProfile )    ( void ) ( uxProfile )
+/*-----------------------------------------------------------*/
+
 /* Tickless idle/low power functionality. */
     #ifndef portSUPPRESS_TICKS_AND_SLEEP
         extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
@@ -123,24 +139,31 @@
 
 /* Architecture specific optimisations. */
     #ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
-        #define configUSE_PORT_OPTIMISED_TASK_SELECTION    1
+        #if ( defined( configUSE_PRIORITY_BITMAP_TASK_SELECTION ) && ( configUSE_PRIORITY_BITMAP_TASK_SELECTION == 1 ) )
+            #define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
+        #else
+            #define configUSE_PORT_OPTIMISED_TASK_SELECTION    1
+        #endif
     #endif
 
-    #if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
-
 /* Generic helper function. */
-        __attribute__( ( always_inline ) ) static inline uint8_t ucPortCountLeadingZeros( uint32_t ulBitmap )
-        {
-            uint8_t ucReturn;
+    __attribute__( ( always_inline ) ) static inline uint8_t ucPortCountLeadingZeros( uint32_t ulBitmap )
+    {
+        uint8_t ucReturn;
 
-            __asm volatile ( "clz %0, %1" : "=r" ( ucReturn ) : "r" ( ulBitmap ) : "memory" );
+        __asm volatile ( "clz %0, %1" : "=r" ( ucReturn ) : "r" ( ulBitmap ) : "memory" );
 
-            return ucReturn;
-        }
+        return ucReturn;
+    }
+
+/* Used by the kernel's two level priority bit map. */
+    #define portCOUNT_LEADING_ZEROS( ulBitmap )    ucPortCountLeadingZeros( ulBitmap )
+
+    #if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
 
 /* Check the configuration. */
         #if ( configMAX_PRIORITIES > 32 )
-            #error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+            #error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  Set configUSE_PRIORITY_BITMAP_TASK_SELECTION to 1 instead to use up to 1024 priorities.
         #endif
 
 /* Store/clear the ready priorities in a bit map. */
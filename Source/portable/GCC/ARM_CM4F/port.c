@@ -778,6 +778,36 @@ static void vPortEnableVFP( void )
 }
 /*-----------------------------------------------------------*/
 
+void vPortSetContextProfile( UBaseType_t uxProfile )
+{
+    /* Only a task can change its own context. */
+    configASSERT( ( portNVIC_INT_CTRL_REG & portVECTACTIVE_MASK ) == 0 );
+
+    if( uxProfile == portCONTEXT_PROFILE_INTEGER )
+    {
+        /* Clearing CONTROL.FPCA tells the processor the task has no floating
+         * point context, so exception entry stacks a basic frame again and
+         * xPortPendSVHandler() skips s16-s31.  An interrupt between the read
+         * and the write returns with the same CONTROL value, so there is no
+         * need for a critical section. */
+        __asm volatile
+        (
+            "	mrs r0, control		\n"
+            "	bic r0, r0, #4		\n"
+            "	msr control, r0		\n"
+            "	isb					\n"
+            ::: "r0", "memory"
+        );
+    }
+    else
+    {
+        /* The processor adds the floating point context itself when the task
+         * next uses the FPU. */
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
 #if ( configASSERT_DEFINED == 1 )
 
     void vPortValidateInterruptPriority( void )
@@ -114,6 +114,22 @@
     #define portTASK_FUNCTION( vFunction, pvParameters )          void vFunction( void * pvParameters )
 /*-----------------------------------------------------------*/
 
+/* Task context profiles.  The FPU registers become part of a task's context
+ * when it executes its first floating point instruction, and then stay part of
+ * it, so every context switch out of a task that has used the FPU once saves and
+ * restores them.  A task that has finished with the FPU can call
+ * portTASK_SET_CONTEXT_PROFILE( portCONTEXT_PROFILE_INTEGER ) to drop them
+ * again.  It must do so at a point where it holds no floating point values -
+ * for example just before it blocks at the top of its loop - as their registers
+ * are no longer preserved.  Its next floating point instruction brings them
+ * back.  The DSP instructions only use the core registers, which are always
+ * saved. */
+    #define portCONTEXT_PROFILE_INTEGER                  ( 0UL )
+    #define portCONTEXT_PROFILE_FPU                      ( 1UL )
+    extern void vPortSetContextProfile( UBaseType_t uxProfile );
+    #define portTASK_SET_CONTEXT_PROFILE( uxProfile )    vPortSetContextProfile( uxProfile )
+/*-----------------------------------------------------------*/
+
 /* Tickless idle/low power functionality. */
     #ifndef portSUPPRESS_TICKS_AND_SLEEP
         extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
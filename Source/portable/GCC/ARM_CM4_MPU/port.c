@@ -87,6 +87,12 @@
 #define portPRIVILEGED_EXECUTION_START_ADDRESS    ( 0UL )
 #define portMPU_REGION_VALID                      ( 0x10UL )
 #define portMPU_REGION_ENABLE                     ( 0x01UL )
+#define portMPU_REGION_NUMBER_REG                 ( *( ( volatile uint32_t * ) 0xe000ed98 ) )
+#define portMPU_REGION_ADDRESS_MASK               ( 0xffffffe0UL )
+#define portMPU_REGION_SIZE_MASK                  ( 0x3eUL )
+#define portMPU_REGION_SUBREGION_DISABLE_MASK     ( 0xff00UL )
+#define portMPU_REGION_ACCESS_PERMISSION_MASK     ( 0x07UL << 24UL )
+#define portMPU_REGION_READ_ONLY_ALIAS            ( 0x07UL << 24UL ) /* The same access as portMPU_REGION_READ_ONLY. */
 #define portPERIPHERALS_START_ADDRESS             0x40000000UL
 #define portPERIPHERALS_END_ADDRESS               0x5FFFFFFFUL
 
@@ -982,6 +988,97 @@ void vPortStoreTaskMPUSettings( xMPU_SETTINGS * xMPUSettings,
 }
 /*-----------------------------------------------------------*/
 
+BaseType_t xPortIsAuthorizedToAccessBuffer( const void * pvBuffer,
+                                            uint32_t ulBufferLength,
+                                            uint32_t ulAccessRequested ) /* PRIVILEGED_FUNCTION */
+{
+    uint32_t ulBufferStartAddress, ulBufferEndAddress;
+    uint32_t ulRegionStartAddress, ulRegionEndAddress, ulRegionAttribute, ulRegionPermissions;
+    int32_t lRegion;
+    BaseType_t xAccessGranted = pdFALSE, xSearchComplete = pdFALSE;
+
+    ulBufferStartAddress = ( uint32_t ) pvBuffer;
+    ulBufferEndAddress = ulBufferStartAddress + ulBufferLength - 1UL;
+
+    if( ulBufferLength == 0UL )
+    {
+        /* Nothing will be accessed. */
+        xAccessGranted = pdTRUE;
+    }
+    else if( ulBufferEndAddress >= ulBufferStartAddress )
+    {
+        /* The regions are read back from the MPU, which holds those of the
+         * calling task, so the regions set up by prvSetupMPU() are checked too.
+         * Where regions overlap the one with the highest number takes
+         * precedence, so they are searched from the highest number down until
+         * one covers part of the buffer without granting the access, or covers
+         * all of it and grants the access.  A context switch also writes the
+         * region number register, hence the critical section. */
+        portENTER_CRITICAL();
+        {
+            for( lRegion = ( int32_t ) portPRIVILEGED_RAM_REGION; ( lRegion >= 0 ) && ( xSearchComplete == pdFALSE ); lRegion-- )
+            {
+                portMPU_REGION_NUMBER_REG = ( uint32_t ) lRegion;
+                ulRegionAttribute = portMPU_REGION_ATTRIBUTE_REG;
+
+                if( ( ulRegionAttribute & portMPU_REGION_ENABLE ) != 0UL )
+                {
+                    ulRegionStartAddress = portMPU_REGION_BASE_ADDRESS_REG & portMPU_REGION_ADDRESS_MASK;
+                    ulRegionEndAddress = ulRegionStartAddress + ( ( ( uint32_t ) 2UL << ( ( ulRegionAttribute & portMPU_REGION_SIZE_MASK ) >> 1UL ) ) - 1UL );
+                    ulRegionPermissions = ulRegionAttribute & portMPU_REGION_ACCESS_PERMISSION_MASK;
+
+                    if( ulRegionPermissions == portMPU_REGION_READ_WRITE )
+                    {
+                        ulRegionPermissions = tskMPU_READ_PERMISSION | tskMPU_WRITE_PERMISSION;
+                    }
+                    else if( ( ulRegionPermissions == portMPU_REGION_READ_ONLY ) ||
+                             ( ulRegionPermissions == portMPU_REGION_READ_ONLY_ALIAS ) ||
+                             ( ulRegionPermissions == portMPU_REGION_PRIVILEGED_READ_WRITE_UNPRIV_READ_ONLY ) )
+                    {
+                        ulRegionPermissions = tskMPU_READ_PERMISSION;
+                    }
+                    else
+                    {
+                        ulRegionPermissions = 0UL;
+                    }
+
+                    /* The kernel does not use subregions, so a region with any
+                     * of them disabled is taken not to grant any access. */
+                    if( ( ulRegionAttribute & portMPU_REGION_SUBREGION_DISABLE_MASK ) != 0UL )
+                    {
+                        ulRegionPermissions = 0UL;
+                    }
+
+                    if( ( ulBufferStartAddress <= ulRegionEndAddress ) && ( ulBufferEndAddress >= ulRegionStartAddress ) )
+                    {
+                        if( ( ulRegionPermissions & ulAccessRequested ) != ulAccessRequested )
+                        {
+                            xSearchComplete = pdTRUE;
+                        }
+                        else if( ( ulBufferStartAddress >= ulRegionStartAddress ) && ( ulBufferEndAddress <= ulRegionEndAddress ) )
+                        {
+                            xAccessGranted = pdTRUE;
+                            xSearchComplete = pdTRUE;
+                        }
+                        else
+                        {
+                            /* The rest of the buffer must be in a lower region. */
+                        }
+                    }
+                }
+            }
+        }
+        portEXIT_CRITICAL();
+    }
+    else
+    {
+        /* The buffer wraps around the end of the address space. */
+    }
+
+    return xAccessGranted;
+}
+/*-----------------------------------------------------------*/
+
 #if ( configASSERT_DEFINED == 1 )
 
     void vPortValidateInterruptPriority( void )
@@ -302,9 +302,21 @@ extern void vResetPrivilege( void );
 /**
  * @brief Checks whether or not the processor is privileged.
  *
+ * Inlined, rather than calling xIsPrivileged(), as every MPU wrapper function
+ * makes the check.
+ *
  * @return 1 if the processor is already privileged, 0 otherwise.
  */
-#define portIS_PRIVILEGED()      xIsPrivileged()
+portFORCE_INLINE static BaseType_t xPortIsPrivileged( void )
+{
+    uint32_t ulControl;
+
+    __asm volatile ( "mrs %0, control" : "=r" ( ulControl )::"memory" );
+
+    return ( ( ulControl & 1UL ) == 0UL ) ? pdTRUE : pdFALSE;
+}
+
+#define portIS_PRIVILEGED()      xPortIsPrivileged()
 
 /**
  * @brief Raise an SVC request to raise privilege.
@@ -313,9 +325,23 @@ extern void vResetPrivilege( void );
 
 /**
  * @brief Lowers the privilege level by setting the bit 0 of the CONTROL
- * register.
+ * register.  Inlined, rather than calling vResetPrivilege(), for the same
+ * reason as xPortIsPrivileged().
  */
-#define portRESET_PRIVILEGE()    vResetPrivilege()
+portFORCE_INLINE static void vPortResetPrivilege( void )
+{
+    uint32_t ulControl;
+
+    __asm volatile
+    (
+        "	mrs %0, control	\n"
+        "	orr %0, #1		\n"
+        "	msr control, %0	\n"
+        : "=r" ( ulControl )::"memory"
+    );
+}
+
+#define portRESET_PRIVILEGE()    vPortResetPrivilege()
 /*-----------------------------------------------------------*/
 
 portFORCE_INLINE static BaseType_t xPortIsInsideInterrupt( void )
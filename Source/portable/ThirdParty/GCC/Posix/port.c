@@ -48,11 +48,22 @@
 * stdio (printf() and friends) should be called from a single task
 * only or serialized with a FreeRTOS primitive such as a binary
 * semaphore or mutex.
+*
+* When configNUMBER_OF_CORES is greater than 1 each core is simulated by
+* the thread of the task that is current on that core, so that many
+* tasks run at once.  The thread simulating each core is recorded in a
+* per-core slot that is handed over, with the ISR spinlock held, when the
+* core switches task, and a thread learns which core it is simulating
+* when it is resumed.  Another core is interrupted by marking a yield
+* pending for the core and sending SIG_YIELD_CORE to the thread in its
+* slot.  A pending yield is passed on to the next thread if the core
+* switches task before the signal is taken, and a thread only takes a
+* yield that is still pending for the core it simulates.  The kernel
+* spinlocks are implemented with atomic operations.
 *----------------------------------------------------------*/
-#include "portmacro.h"
-
 #include <errno.h>
 #include <pthread.h>
+#include <sched.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -68,7 +79,8 @@
 #include "utils/wait_for_event.h"
 /*-----------------------------------------------------------*/
 
-#define SIG_RESUME    SIGUSR1
+#define SIG_RESUME        SIGUSR1
+#define SIG_YIELD_CORE    SIGUSR2
 
 typedef struct THREAD
 {
@@ -77,6 +89,9 @@ typedef struct THREAD
     void * pvParams;
     BaseType_t xDying;
     struct event * ev;
+    #if ( configNUMBER_OF_CORES > 1 )
+        BaseType_t xCoreID; /* The core the thread is to simulate when it is next resumed. */
+    #endif
 } Thread_t;
 
 /*
@@ -96,10 +111,38 @@ static pthread_once_t hSigSetupThread = PTHREAD_ONCE_INIT;
 static sigset_t xAllSignals;
 static sigset_t xSchedulerOriginalSignalMask;
 static pthread_t hMainThread = ( pthread_t ) NULL;
-static volatile portBASE_TYPE uxCriticalNesting;
+#if ( configNUMBER_OF_CORES == 1 )
+    static volatile portBASE_TYPE uxCriticalNesting;
+#endif
 /*-----------------------------------------------------------*/
 
-static portBASE_TYPE xSchedulerEnd = pdFALSE;
+static volatile portBASE_TYPE xSchedulerEnd = pdFALSE;
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* A recursive spinlock.  xOwner is the core holding the lock, or -1. */
+    typedef struct SPINLOCK
+    {
+        volatile BaseType_t xOwner;
+        UBaseType_t uxCount;
+    } Spinlock_t;
+
+    static Spinlock_t xTaskLock = { -1, 0 };
+    static Spinlock_t xISRLock = { -1, 0 };
+
+/* The thread simulating each core, and whether each core has been interrupted
+ * to yield but has not yet taken the interrupt.  Once the first tasks have
+ * started they are only accessed with the ISR spinlock held. */
+    static Thread_t * pxCoreThreads[ configNUMBER_OF_CORES ];
+    static BaseType_t xCoreYieldPendings[ configNUMBER_OF_CORES ];
+
+/* The state of the core simulated by the calling thread.  Each thread starts
+ * with all signals blocked. */
+    static __thread BaseType_t xThreadCoreID = 0;
+    static __thread BaseType_t xThreadInterruptsMasked = pdTRUE;
+    static __thread BaseType_t xThreadInsideInterrupt = pdFALSE;
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
 static void prvSetupSignalsAndSchedulerPolicy( void );
@@ -112,6 +155,9 @@ static void prvResumeThread( Thread_t * xThreadId );
 static void vPortSystemTickHandler( int sig );
 static void vPortStartFirstTask( void );
 static void prvPortYieldFromISR( void );
+#if ( configNUMBER_OF_CORES > 1 )
+    static void prvYieldCoreHandler( int sig );
+#endif
 /*-----------------------------------------------------------*/
 
 static void prvFatalError( const char * pcCall,
@@ -134,6 +180,10 @@ portSTACK_TYPE * pxPortInitialiseStack( portSTACK_TYPE * pxTopOfStack,
     size_t ulStackSize;
     int iRet;
 
+    #if ( configNUMBER_OF_CORES > 1 )
+        portBASE_TYPE xMask;
+    #endif
+
     ( void ) pthread_once( &hSigSetupThread, prvSetupSignalsAndSchedulerPolicy );
 
     /*
@@ -155,9 +205,17 @@ portSTACK_TYPE * pxPortInitialiseStack( portSTACK_TYPE * pxTopOfStack,
         fprintf( stderr, "[WARN] Increase the stack size to PTHREAD_STACK_MIN.\n" );
     }
 
-    thread->ev = event_create();
+    /* The new thread inherits the signal mask of the calling thread, so must
+     * be created with all signals blocked.  The event is created with them
+     * blocked too, as a task switched out while holding one of the C
+     * library's internal locks would block any thread that then needs it. */
+    #if ( configNUMBER_OF_CORES == 1 )
+        vPortEnterCritical();
+    #else
+        xMask = xPortSetInterruptMask();
+    #endif
 
-    vPortEnterCritical();
+    thread->ev = event_create();
 
     iRet = pthread_create( &thread->pthread, &xThreadAttributes,
                            prvWaitForStart, thread );
@@ -167,7 +225,11 @@ portSTACK_TYPE * pxPortInitialiseStack( portSTACK_TYPE * pxTopOfStack,
         prvFatalError( "pthread_create", iRet );
     }
 
-    vPortExitCritical();
+    #if ( configNUMBER_OF_CORES == 1 )
+        vPortExitCritical();
+    #else
+        vPortClearInterruptMask( xMask );
+    #endif
 
     return pxTopOfStack;
 }
@@ -175,10 +237,34 @@ portSTACK_TYPE * pxPortInitialiseStack( portSTACK_TYPE * pxTopOfStack,
 
 void vPortStartFirstTask( void )
 {
-    Thread_t * pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        Thread_t * pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
 
-    /* Start the first task. */
-    prvResumeThread( pxFirstThread );
+        /* Start the first task. */
+        prvResumeThread( pxFirstThread );
+    }
+    #else
+    {
+        Thread_t * pxFirstThread;
+        BaseType_t xCoreID;
+
+        /* Every core has a thread before any of them starts, as the first
+         * task to run may interrupt another core. */
+        for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+            pxFirstThread->xCoreID = xCoreID;
+            pxCoreThreads[ xCoreID ] = pxFirstThread;
+        }
+
+        /* Start the first task on each core. */
+        for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            prvResumeThread( pxCoreThreads[ xCoreID ] );
+        }
+    }
+    #endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
@@ -216,7 +302,18 @@ portBASE_TYPE xPortStartScheduler( void )
 
     /* Cancel the Idle task and free its resources */
     #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
-        vPortCancelThread( xTaskGetIdleTaskHandle() );
+        #if ( configNUMBER_OF_CORES == 1 )
+            vPortCancelThread( xTaskGetIdleTaskHandle() );
+        #else
+        {
+            BaseType_t xCoreID;
+
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                vPortCancelThread( xTaskGetIdleTaskHandleForCore( xCoreID ) );
+            }
+        }
+        #endif
     #endif
 
     #if ( configUSE_TIMERS == 1 )
@@ -255,11 +352,34 @@ void vPortEndScheduler( void )
     xSchedulerEnd = pdTRUE;
     ( void ) pthread_kill( hMainThread, SIG_RESUME );
 
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        BaseType_t xCoreID;
+
+        /* Stop the other cores.  Each parks its thread on taking the
+         * interrupt. */
+        vPortDisableInterrupts();
+        vPortGetISRLock();
+
+        for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            if( xCoreID != xThreadCoreID )
+            {
+                vPortYieldCore( xCoreID );
+            }
+        }
+
+        vPortReleaseISRLock();
+    }
+    #endif
+
     xCurrentThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
     prvSuspendSelf( xCurrentThread );
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES == 1 )
+
 void vPortEnterCritical( void )
 {
     if( uxCriticalNesting == 0 )
@@ -283,6 +403,8 @@ void vPortExitCritical( void )
 }
 /*-----------------------------------------------------------*/
 
+#endif /* configNUMBER_OF_CORES */
+
 static void prvPortYieldFromISR( void )
 {
     Thread_t * xThreadToSuspend;
@@ -298,6 +420,8 @@ static void prvPortYieldFromISR( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES == 1 )
+
 void vPortYield( void )
 {
     vPortEnterCritical();
@@ -334,6 +458,147 @@ void vPortClearInterruptMask( portBASE_TYPE xMask )
 }
 /*-----------------------------------------------------------*/
 
+#else /* configNUMBER_OF_CORES */
+
+void vPortYield( void )
+{
+    portBASE_TYPE xMask;
+
+    /* The critical section nesting count is held in the TCB, so only the
+     * interrupts need masking while the task is switched out. */
+    xMask = xPortSetInterruptMask();
+
+    prvPortYieldFromISR();
+
+    vPortClearInterruptMask( xMask );
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+    pthread_sigmask( SIG_BLOCK, &xAllSignals, NULL );
+    xThreadInterruptsMasked = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+    xThreadInterruptsMasked = pdFALSE;
+    pthread_sigmask( SIG_UNBLOCK, &xAllSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortSetInterruptMask( void )
+{
+    portBASE_TYPE xWasMasked = xThreadInterruptsMasked;
+
+    /* The kernel masks interrupts from task code too when there is more than
+     * one core, so the previous state is returned.  Interrupts are always
+     * masked inside ISRs (signal handlers). */
+    if( xWasMasked == pdFALSE )
+    {
+        vPortDisableInterrupts();
+    }
+
+    return xWasMasked;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( portBASE_TYPE xMask )
+{
+    if( xMask == pdFALSE )
+    {
+        vPortEnableInterrupts();
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortGetCoreID( void )
+{
+    return xThreadCoreID;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortIsInsideInterrupt( void )
+{
+    return xThreadInsideInterrupt;
+}
+/*-----------------------------------------------------------*/
+
+void vPortYieldCore( BaseType_t xCoreID )
+{
+    /* Called with the ISR spinlock held.  The signal is taken by the thread
+     * simulating the core the next time that thread unblocks signals, or is
+     * sent again to the thread that takes over the core before then. */
+    xCoreYieldPendings[ xCoreID ] = pdTRUE;
+    ( void ) pthread_kill( pxCoreThreads[ xCoreID ]->pthread, SIG_YIELD_CORE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSpinlockTake( Spinlock_t * pxLock )
+{
+    BaseType_t xFree;
+
+    if( __atomic_load_n( &( pxLock->xOwner ), __ATOMIC_ACQUIRE ) != xThreadCoreID )
+    {
+        for( ; ; )
+        {
+            xFree = -1;
+
+            if( __atomic_compare_exchange_n( &( pxLock->xOwner ), &xFree, xThreadCoreID, pdFALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+            {
+                break;
+            }
+
+            /* The holder may be a thread that is not currently scheduled by
+             * the host. */
+            sched_yield();
+        }
+    }
+
+    pxLock->uxCount++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSpinlockRelease( Spinlock_t * pxLock )
+{
+    configASSERT( pxLock->xOwner == xThreadCoreID );
+
+    pxLock->uxCount--;
+
+    if( pxLock->uxCount == 0U )
+    {
+        __atomic_store_n( &( pxLock->xOwner ), -1, __ATOMIC_RELEASE );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetTaskLock( void )
+{
+    prvSpinlockTake( &xTaskLock );
+}
+/*-----------------------------------------------------------*/
+
+void vPortReleaseTaskLock( void )
+{
+    prvSpinlockRelease( &xTaskLock );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetISRLock( void )
+{
+    prvSpinlockTake( &xISRLock );
+}
+/*-----------------------------------------------------------*/
+
+void vPortReleaseISRLock( void )
+{
+    prvSpinlockRelease( &xISRLock );
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configNUMBER_OF_CORES */
+
 static uint64_t prvGetTimeNs( void )
 {
     struct timespec t;
@@ -386,6 +651,8 @@ void prvSetupTimerInterrupt( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES == 1 )
+
 static void vPortSystemTickHandler( int sig )
 {
     Thread_t * pxThreadToSuspend;
@@ -428,6 +695,89 @@ static void vPortSystemTickHandler( int sig )
 }
 /*-----------------------------------------------------------*/
 
+#else /* configNUMBER_OF_CORES */
+
+static void vPortSystemTickHandler( int sig )
+{
+    BaseType_t xSavedInterruptsMasked = xThreadInterruptsMasked;
+    BaseType_t xSavedInsideInterrupt = xThreadInsideInterrupt;
+    UBaseType_t uxSavedInterruptStatus;
+    BaseType_t xSwitchRequired;
+
+    ( void ) sig;
+
+    /* Signals are blocked in this signal handler. */
+    xThreadInterruptsMasked = pdTRUE;
+    xThreadInsideInterrupt = pdTRUE;
+
+    /* The tick is taken by whichever core has signals unblocked.  The kernel
+     * interrupts any other core that must switch task. */
+    uxSavedInterruptStatus = portENTER_CRITICAL_FROM_ISR();
+    {
+        xSwitchRequired = xTaskIncrementTick();
+    }
+    portEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    if( xSwitchRequired != pdFALSE )
+    {
+        prvPortYieldFromISR();
+    }
+
+    xThreadInsideInterrupt = xSavedInsideInterrupt;
+    xThreadInterruptsMasked = xSavedInterruptsMasked;
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldCoreHandler( int sig )
+{
+    BaseType_t xSavedInterruptsMasked = xThreadInterruptsMasked;
+    BaseType_t xSavedInsideInterrupt = xThreadInsideInterrupt;
+    BaseType_t xYieldPending;
+
+    ( void ) sig;
+
+    if( xSchedulerEnd != pdFALSE )
+    {
+        /* vPortEndScheduler() was called on another core.  Park the thread
+         * until it is cancelled. */
+        for( ; ; )
+        {
+            prvSuspendSelf( prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xThreadCoreID ) ) );
+        }
+    }
+
+    xThreadInterruptsMasked = pdTRUE;
+    xThreadInsideInterrupt = pdTRUE;
+
+    /* The signal may have been sent while this thread was simulating another
+     * core, or the yield may already have been taken, so the pending state of
+     * the core the thread now simulates is checked with the ISR spinlock
+     * held. */
+    vPortGetISRLock();
+    {
+        xYieldPending = xCoreYieldPendings[ xThreadCoreID ];
+        xCoreYieldPendings[ xThreadCoreID ] = pdFALSE;
+    }
+    vPortReleaseISRLock();
+
+    if( xYieldPending != pdFALSE )
+    {
+        /* Another core has made a task ready that should preempt the task
+         * running on this one. */
+        prvPortYieldFromISR();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    xThreadInsideInterrupt = xSavedInsideInterrupt;
+    xThreadInterruptsMasked = xSavedInterruptsMasked;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configNUMBER_OF_CORES */
+
 void vPortThreadDying( void * pxTaskToDelete,
                        volatile BaseType_t * pxPendYield )
 {
@@ -442,12 +792,32 @@ void vPortCancelThread( void * pxTaskToDelete )
 {
     Thread_t * pxThreadToCancel = prvGetThreadFromTask( pxTaskToDelete );
 
+    #if ( configNUMBER_OF_CORES > 1 )
+        portBASE_TYPE xMask;
+    #endif
+
     /*
      * The thread has already been suspended so it can be safely cancelled.
+     *
+     * Signals are blocked so the calling task is not switched out while
+     * pthread_join() holds the C library's lock on the list of thread stacks,
+     * which pthread_create() in another task would then wait for.
      */
+    #if ( configNUMBER_OF_CORES == 1 )
+        vPortEnterCritical();
+    #else
+        xMask = xPortSetInterruptMask();
+    #endif
+
     pthread_cancel( pxThreadToCancel->pthread );
     pthread_join( pxThreadToCancel->pthread, NULL );
     event_delete( pxThreadToCancel->ev );
+
+    #if ( configNUMBER_OF_CORES == 1 )
+        vPortExitCritical();
+    #else
+        vPortClearInterruptMask( xMask );
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -458,7 +828,11 @@ static void * prvWaitForStart( void * pvParams )
     prvSuspendSelf( pxThread );
 
     /* Resumed for the first time, unblocks all signals. */
-    uxCriticalNesting = 0;
+    #if ( configNUMBER_OF_CORES == 1 )
+        uxCriticalNesting = 0;
+    #else
+        xThreadCoreID = pxThread->xCoreID;
+    #endif
     vPortEnableInterrupts();
 
     /* Call the task's entry point. */
@@ -478,7 +852,9 @@ static void * prvWaitForStart( void * pvParams )
 static void prvSwitchThread( Thread_t * pxThreadToResume,
                              Thread_t * pxThreadToSuspend )
 {
-    BaseType_t uxSavedCriticalNesting;
+    #if ( configNUMBER_OF_CORES == 1 )
+        BaseType_t uxSavedCriticalNesting;
+    #endif
 
     if( pxThreadToSuspend != pxThreadToResume )
     {
@@ -487,9 +863,26 @@ static void prvSwitchThread( Thread_t * pxThreadToResume,
          *
          * The critical section nesting is per-task, so save it on the
          * stack of the current (suspending thread), restoring it when
-         * we switch back to this task.
+         * we switch back to this task.  When there is more than one core
+         * it is held in the TCB instead, and the resumed thread takes over
+         * this thread's core, along with any yield the core has not yet
+         * taken.
          */
-        uxSavedCriticalNesting = uxCriticalNesting;
+        #if ( configNUMBER_OF_CORES == 1 )
+            uxSavedCriticalNesting = uxCriticalNesting;
+        #else
+            vPortGetISRLock();
+            {
+                pxThreadToResume->xCoreID = xThreadCoreID;
+                pxCoreThreads[ xThreadCoreID ] = pxThreadToResume;
+
+                if( xCoreYieldPendings[ xThreadCoreID ] != pdFALSE )
+                {
+                    ( void ) pthread_kill( pxThreadToResume->pthread, SIG_YIELD_CORE );
+                }
+            }
+            vPortReleaseISRLock();
+        #endif
 
         prvResumeThread( pxThreadToResume );
 
@@ -500,7 +893,11 @@ static void prvSwitchThread( Thread_t * pxThreadToResume,
 
         prvSuspendSelf( pxThreadToSuspend );
 
-        uxCriticalNesting = uxSavedCriticalNesting;
+        #if ( configNUMBER_OF_CORES == 1 )
+            uxCriticalNesting = uxSavedCriticalNesting;
+        #else
+            xThreadCoreID = pxThreadToSuspend->xCoreID;
+        #endif
     }
 }
 /*-----------------------------------------------------------*/
@@ -569,6 +966,23 @@ static void prvSetupSignalsAndSchedulerPolicy( void )
     {
         prvFatalError( "sigaction", errno );
     }
+
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        struct sigaction sigyield;
+
+        sigyield.sa_flags = 0;
+        sigyield.sa_handler = prvYieldCoreHandler;
+        sigfillset( &sigyield.sa_mask );
+
+        iRet = sigaction( SIG_YIELD_CORE, &sigyield, NULL );
+
+        if( iRet == -1 )
+        {
+            prvFatalError( "sigaction", errno );
+        }
+    }
+    #endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
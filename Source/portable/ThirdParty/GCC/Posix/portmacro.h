@@ -99,8 +99,50 @@ extern void vPortExitCritical( void );
 #define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortClearInterruptMask(x)
 #define portDISABLE_INTERRUPTS()				portSET_INTERRUPT_MASK()
 #define portENABLE_INTERRUPTS()					portCLEAR_INTERRUPT_MASK()
-#define portENTER_CRITICAL()					vPortEnterCritical()
-#define portEXIT_CRITICAL()						vPortExitCritical()
+
+#if ( configNUMBER_OF_CORES == 1 )
+	#define portENTER_CRITICAL()				vPortEnterCritical()
+	#define portEXIT_CRITICAL()					vPortExitCritical()
+#else
+	/* The critical section nesting count is held in the TCB, and the kernel
+	 * takes the spinlocks on entry. */
+	extern void vTaskEnterCritical( void );
+	extern void vTaskExitCritical( void );
+	extern UBaseType_t uxTaskEnterCriticalFromISR( void );
+	extern void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus );
+	#define portCRITICAL_NESTING_IN_TCB			1
+	#define portENTER_CRITICAL()				vTaskEnterCritical()
+	#define portEXIT_CRITICAL()					vTaskExitCritical()
+	#define portENTER_CRITICAL_FROM_ISR()		uxTaskEnterCriticalFromISR()
+	#define portEXIT_CRITICAL_FROM_ISR( x )		vTaskExitCriticalFromISR( x )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* Used by the kernel's two level priority bit map. */
+#define portCOUNT_LEADING_ZEROS( ulBitmap )		( ( uint32_t ) __builtin_clz( ulBitmap ) )
+
+/*-----------------------------------------------------------*/
+
+/* Symmetric multiprocessing.  Each core is simulated by whichever thread is
+ * running the task that is current on that core. */
+#if ( configNUMBER_OF_CORES > 1 )
+	extern BaseType_t xPortGetCoreID( void );
+	extern void vPortYieldCore( BaseType_t xCoreID );
+	extern void vPortGetTaskLock( void );
+	extern void vPortReleaseTaskLock( void );
+	extern void vPortGetISRLock( void );
+	extern void vPortReleaseISRLock( void );
+	extern BaseType_t xPortIsInsideInterrupt( void );
+
+	#define portGET_CORE_ID()				xPortGetCoreID()
+	#define portYIELD_CORE( xCoreID )		vPortYieldCore( xCoreID )
+	#define portGET_TASK_LOCK()				vPortGetTaskLock()
+	#define portRELEASE_TASK_LOCK()			vPortReleaseTaskLock()
+	#define portGET_ISR_LOCK()				vPortGetISRLock()
+	#define portRELEASE_ISR_LOCK()			vPortReleaseISRLock()
+	#define portASSERT_IF_IN_ISR()			configASSERT( xPortIsInsideInterrupt() == pdFALSE )
+#endif
 
 /*-----------------------------------------------------------*/
 
@@ -63,8 +63,16 @@
 /* If the cooperative scheduler is being used then a yield should not be
  * performed just because a higher priority task has been woken. */
     #define taskYIELD_IF_USING_PREEMPTION()
+    #define taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB )
+    #define taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB )
 #else
     #define taskYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
+
+/* When configNUMBER_OF_CORES is greater than 1 a task that becomes ready may
+ * preempt the task running on any core it is allowed to run on, and a running
+ * task that might no longer be the best choice yields the core it runs on. */
+    #define taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB )     prvYieldForTask( pxTCB )
+    #define taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB )    prvYieldCore( ( pxTCB )->xTaskRunState )
 #endif
 
 /* Values that can be assigned to the ucNotifyState member of the TCB. */
@@ -78,6 +86,10 @@
  */
 #define tskSTACK_FILL_BYTE                        ( 0xa5U )
 
+/* tskSTACK_FILL_BYTE in every byte of a StackType_t, so unused stack can be
+ * recognised a word at a time.  StackType_t is unsigned on every port. */
+#define tskSTACK_FILL_WORD                        ( ( StackType_t ) ( ( ( StackType_t ) ~( StackType_t ) 0U / ( StackType_t ) 0xffU ) * ( StackType_t ) tskSTACK_FILL_BYTE ) )
+
 /* Bits used to record how a task's stack and TCB were allocated. */
 #define tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB    ( ( uint8_t ) 0 )
 #define tskSTATICALLY_ALLOCATED_STACK_ONLY        ( ( uint8_t ) 1 )
@@ -101,6 +113,48 @@
 #define tskDELETED_CHAR      ( 'D' )
 #define tskSUSPENDED_CHAR    ( 'S' )
 
+#if ( configNUMBER_OF_CORES == 1 )
+    #define taskTASK_IS_RUNNING( pxTCB )                          ( ( pxTCB ) == pxCurrentTCB )
+    #define taskTASK_IS_RUNNING_OR_SCHEDULED_TO_YIELD( pxTCB )    taskTASK_IS_RUNNING( pxTCB )
+    #define taskASSERT_SCHEDULER_NOT_SUSPENDED()                  configASSERT( uxSchedulerSuspended == ( UBaseType_t ) 0U )
+#else
+
+/* Values that can be held by the xTaskRunState member of the TCB.  A task that
+ * is running holds the ID of the core it is running on.  A task that has been
+ * told to yield another core keeps that core until the core switches it out,
+ * so must not be selected to run on a different core in the meantime. */
+    #define taskTASK_NOT_RUNNING           ( ( BaseType_t ) ( -1 ) )
+    #define taskTASK_SCHEDULED_TO_YIELD    ( ( BaseType_t ) ( -2 ) )
+
+    #define taskTASK_IS_RUNNING( pxTCB )                          ( ( ( pxTCB )->xTaskRunState >= ( BaseType_t ) 0 ) && ( ( pxTCB )->xTaskRunState < ( BaseType_t ) configNUMBER_OF_CORES ) )
+    #define taskTASK_IS_RUNNING_OR_SCHEDULED_TO_YIELD( pxTCB )    ( ( pxTCB )->xTaskRunState != taskTASK_NOT_RUNNING )
+
+/* Bits that can be set in the uxTaskAttributes member of the TCB. */
+    #define taskATTRIBUTE_IS_IDLE    ( ( UBaseType_t ) ( 1U << 0U ) )
+
+/* Evaluates to pdTRUE if the affinity of pxTCB allows it to run on core
+ * xCoreID. */
+    #if ( configUSE_CORE_AFFINITY == 1 )
+        #define taskCAN_RUN_ON_CORE( pxTCB, xCoreID )    ( ( ( ( pxTCB )->uxCoreAffinityMask >> ( xCoreID ) ) & 1U ) != 0U )
+    #else
+        #define taskCAN_RUN_ON_CORE( pxTCB, xCoreID )    ( pdTRUE )
+    #endif
+
+/* uxSchedulerSuspended is also non-zero while another core has the scheduler
+ * suspended, so it is only checked with the task lock held. */
+    #if ( configASSERT_DEFINED == 1 )
+        #define taskASSERT_SCHEDULER_NOT_SUSPENDED()                    \
+    do {                                                                \
+        taskENTER_CRITICAL();                                           \
+        configASSERT( uxSchedulerSuspended == ( UBaseType_t ) 0U );     \
+        taskEXIT_CRITICAL();                                            \
+    } while( 0 )
+    #else
+        #define taskASSERT_SCHEDULER_NOT_SUSPENDED()
+    #endif
+
+#endif /* configNUMBER_OF_CORES */
+
 /*
  * Some kernel aware debuggers require the data the debugger needs access to to
  * be global, rather than file scope.
@@ -115,7 +169,72 @@
     #define configIDLE_TASK_NAME    "IDLE"
 #endif
 
-#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+#if ( configUSE_PRIORITY_BITMAP_TASK_SELECTION == 1 )
+
+/* If configUSE_PRIORITY_BITMAP_TASK_SELECTION is 1 then the ready priorities
+ * are held in a two level bit map, so the highest ready priority is found in
+ * constant time for up to 1024 priorities.  Bit n of ulReadyPriorities[ g ]
+ * is set if priority ( g * 32 ) + n has ready tasks, and bit g of
+ * ulReadyPriorityGroups is set if ulReadyPriorities[ g ] is not zero. */
+    #define taskPRIORITY_BITMAP_WORDS    ( ( ( UBaseType_t ) configMAX_PRIORITIES + ( UBaseType_t ) 31U ) / ( UBaseType_t ) 32U )
+    #define taskPRIORITY_GROUP( uxPriority )    ( ( UBaseType_t ) ( uxPriority ) >> 5 )
+    #define taskPRIORITY_BIT( uxPriority )      ( ( uint32_t ) 1UL << ( ( UBaseType_t ) ( uxPriority ) & ( UBaseType_t ) 31U ) )
+
+/* Ports that have a count leading zeros instruction define
+ * portCOUNT_LEADING_ZEROS() to use it, otherwise a de Bruijn sequence is used
+ * to find the most significant set bit. */
+    #ifdef portCOUNT_LEADING_ZEROS
+        #define taskHIGHEST_SET_BIT( ulBitmap )    ( ( UBaseType_t ) 31U - ( UBaseType_t ) portCOUNT_LEADING_ZEROS( ulBitmap ) )
+    #else
+        #define taskHIGHEST_SET_BIT( ulBitmap )    prvHighestSetBit( ulBitmap )
+    #endif
+
+    #define taskRECORD_READY_PRIORITY( uxPriority )                                                     \
+    {                                                                                                   \
+        ulReadyPriorities[ taskPRIORITY_GROUP( uxPriority ) ] |= taskPRIORITY_BIT( uxPriority );        \
+        ulReadyPriorityGroups |= ( ( uint32_t ) 1UL << taskPRIORITY_GROUP( uxPriority ) );              \
+    } /* taskRECORD_READY_PRIORITY */
+
+/*-----------------------------------------------------------*/
+
+    #define taskSELECT_HIGHEST_PRIORITY_TASK()                                                                    \
+    {                                                                                                             \
+        UBaseType_t uxTopGroup, uxTopPriority;                                                                    \
+                                                                                                                  \
+        /* Find the highest priority group that contains ready tasks, then the                                  \
+         * highest priority within that group. */                                                                \
+        uxTopGroup = taskHIGHEST_SET_BIT( ulReadyPriorityGroups );                                                \
+        uxTopPriority = ( uxTopGroup << 5 ) + taskHIGHEST_SET_BIT( ulReadyPriorities[ uxTopGroup ] );             \
+        configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );                   \
+        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );                     \
+    } /* taskSELECT_HIGHEST_PRIORITY_TASK() */
+
+/*-----------------------------------------------------------*/
+
+/* The second parameter is not used.  It is kept so the calls shared with the
+ * port optimised method of task selection need not change. */
+    #define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )                                  \
+    {                                                                                                   \
+        ulReadyPriorities[ taskPRIORITY_GROUP( uxPriority ) ] &= ~taskPRIORITY_BIT( uxPriority );       \
+                                                                                                        \
+        if( ulReadyPriorities[ taskPRIORITY_GROUP( uxPriority ) ] == 0UL )                              \
+        {                                                                                               \
+            ulReadyPriorityGroups &= ~( ( uint32_t ) 1UL << taskPRIORITY_GROUP( uxPriority ) );         \
+        }                                                                                               \
+    }
+
+/* Only clear the bit if the TCB being reset was the last task in its ready
+ * list.  If it is referenced from a delayed or suspended list then it won't be
+ * in a ready list. */
+    #define taskRESET_READY_PRIORITY( uxPriority )                                                     \
+    {                                                                                                  \
+        if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == ( UBaseType_t ) 0 ) \
+        {                                                                                              \
+            portRESET_READY_PRIORITY( ( uxPriority ), 0 );                                             \
+        }                                                                                              \
+    }
+
+#elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
  * performed in a generic way that is not optimised to any particular
@@ -214,15 +333,86 @@
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_PER_CORE_READY_LISTS == 1 )
+
+/* Each core has its own set of ready lists, one per priority, held one after
+ * the other in pxReadyTasksLists.  A ready task is held in the lists of the
+ * core given by its xReadyListCore member, which is the core it last ran on
+ * (or the core that created it).  uxTopReadyPriorities holds, for each core,
+ * the priority of the highest priority task in that core's ready lists. */
+    #define taskNUMBER_OF_READY_LISTS                     ( ( UBaseType_t ) configNUMBER_OF_CORES * ( UBaseType_t ) configMAX_PRIORITIES )
+    #define taskCORE_READY_LIST( xCoreID, uxPriority )    ( &( pxReadyTasksLists[ ( ( UBaseType_t ) ( xCoreID ) * ( UBaseType_t ) configMAX_PRIORITIES ) + ( uxPriority ) ] ) )
+    #define taskREADY_LIST( pxTCB, uxPriority )           taskCORE_READY_LIST( ( pxTCB )->xReadyListCore, ( uxPriority ) )
+    #define taskREADY_TASK_COUNT( uxPriority )            prvReadyTaskCount( uxPriority )
+
+#else /* configUSE_PER_CORE_READY_LISTS */
+
+    #define taskNUMBER_OF_READY_LISTS              ( ( UBaseType_t ) configMAX_PRIORITIES )
+    #define taskREADY_LIST( pxTCB, uxPriority )    ( &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+    #define taskREADY_TASK_COUNT( uxPriority )     listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+
+#endif /* configUSE_PER_CORE_READY_LISTS */
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WOKEN_TASK_SELECTION == 1 )
+
+/* Called each time a task is added to a ready list.  While only one task that
+ * can preempt the running task has been made ready since the last context
+ * switch that task is the highest priority ready task, so the next context
+ * switch can select it without searching the ready lists.  A change to the
+ * running task's own priority might let a task that was already ready preempt
+ * it, so forces the next context switch to search. */
+    #define taskRECORD_WOKEN_TASK( pxTCB )                          \
+    {                                                               \
+        if( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )      \
+        {                                                           \
+            pxWokenTCB = ( pxTCB );                                 \
+            uxWokenTasks++;                                         \
+        }                                                           \
+        else if( ( pxTCB ) == pxCurrentTCB )                        \
+        {                                                           \
+            uxWokenTasks = taskSEARCH_READY_LISTS;                  \
+        }                                                           \
+        else                                                        \
+        {                                                           \
+            mtCOVERAGE_TEST_MARKER();                               \
+        }                                                           \
+    } /* taskRECORD_WOKEN_TASK */
+
+/* Any value of uxWokenTasks other than 1 makes the next context switch search
+ * the ready lists. */
+    #define taskSEARCH_READY_LISTS    ( ( UBaseType_t ) 2U )
+
+#else /* configUSE_WOKEN_TASK_SELECTION */
+
+    #define taskRECORD_WOKEN_TASK( pxTCB )
+
+#endif /* configUSE_WOKEN_TASK_SELECTION */
+
+/*-----------------------------------------------------------*/
+
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
  * the task.  It is inserted at the end of the list.
  */
-#define prvAddTaskToReadyList( pxTCB )                                                                 \
+#if ( configUSE_PER_CORE_READY_LISTS == 1 )
+    #define prvAddTaskToReadyList( pxTCB )                                                                  \
+    traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                                \
+    if( ( pxTCB )->uxPriority > uxTopReadyPriorities[ ( pxTCB )->xReadyListCore ] )                         \
+    {                                                                                                       \
+        uxTopReadyPriorities[ ( pxTCB )->xReadyListCore ] = ( pxTCB )->uxPriority;                          \
+    }                                                                                                       \
+    listINSERT_END( taskREADY_LIST( ( pxTCB ), ( pxTCB )->uxPriority ), &( ( pxTCB )->xStateListItem ) );   \
+    tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+#else
+    #define prvAddTaskToReadyList( pxTCB )                                                                 \
     traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
     taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
+    taskRECORD_WOKEN_TASK( pxTCB );                                                                    \
     listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
     tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+#endif /* configUSE_PER_CORE_READY_LISTS */
 /*-----------------------------------------------------------*/
 
 /*
@@ -266,10 +456,27 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     StackType_t * pxStack;                      /*< Points to the start of the stack. */
     char pcTaskName[ configMAX_TASK_NAME_LEN ]; /*< Descriptive name given to the task when created.  Facilitates debugging only. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 
+    #if ( configNUMBER_OF_CORES > 1 )
+        volatile BaseType_t xTaskRunState; /*< The ID of the core the task is running on, taskTASK_NOT_RUNNING, or taskTASK_SCHEDULED_TO_YIELD. */
+        UBaseType_t uxTaskAttributes;      /*< Bit field of taskATTRIBUTE_ values. */
+    #endif
+
+    #if ( configUSE_CORE_AFFINITY == 1 )
+        UBaseType_t uxCoreAffinityMask; /*< Bit n is set if the task may run on core n. */
+    #endif
+
+    #if ( configUSE_PER_CORE_READY_LISTS == 1 )
+        BaseType_t xReadyListCore; /*< The core whose ready lists hold the task while it is ready.  Always the running core while the task is running. */
+    #endif
+
     #if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
         StackType_t * pxEndOfStack; /*< Points to the highest valid address for the stack. */
     #endif
 
+    #if ( configSTACK_HIGH_WATER_MARK_BINARY_SEARCH == 1 )
+        configSTACK_DEPTH_TYPE uxStackHighWaterMark; /*< The high water mark found last time, in words.  The search for the next one starts below it. */
+    #endif
+
     #if ( portCRITICAL_NESTING_IN_TCB == 1 )
         UBaseType_t uxCriticalNesting; /*< Holds the critical section nesting depth for ports that do not maintain their own count in the port layer. */
     #endif
@@ -296,6 +503,12 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /*< Stores the amount of time the task has spent in the Running state. */
     #endif
 
+    #if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+        CriticalSectionStats_t * pxCriticalSectionStatsSite; /*< The call site of the critical section being timed. */
+        uint32_t ulCriticalSectionStatsStart;                /*< The time at which the critical section being timed was entered. */
+        UBaseType_t uxCriticalSectionStatsNesting;           /*< Only the outermost of a set of nested critical sections is timed. */
+    #endif
+
     #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
         configTLS_BLOCK_TYPE xTLSBlock; /*< Memory block used as Thread Local Storage (TLS) Block for the task. */
     #endif
@@ -326,13 +539,21 @@ typedef tskTCB TCB_t;
 
 /*lint -save -e956 A manual analysis and inspection has been used to determine
  * which static variables must be declared volatile. */
-portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#if ( configNUMBER_OF_CORES == 1 )
+    portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#else
+
+/* Each core has its own running task.  pxCurrentTCB is the task running on the
+ * calling core. */
+    portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCBs[ configNUMBER_OF_CORES ];
+    #define pxCurrentTCB    xTaskGetCurrentTaskHandle()
+#endif
 
 /* Lists for ready and blocked tasks. --------------------
  * xDelayedTaskList1 and xDelayedTaskList2 could be moved to function scope but
  * doing so breaks some kernel aware debuggers and debuggers that rely on removing
  * the static qualifier. */
-PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ]; /*< Prioritised ready tasks. */
+PRIVILEGED_DATA static List_t pxReadyTasksLists[ taskNUMBER_OF_READY_LISTS ]; /*< Prioritised ready tasks. */
 PRIVILEGED_DATA static List_t xDelayedTaskList1;                         /*< Delayed tasks. */
 PRIVILEGED_DATA static List_t xDelayedTaskList2;                         /*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /*< Points to the delayed task list currently being used. */
@@ -361,14 +582,37 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tas
 /* Other file private variables. --------------------------------*/
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
-PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
+#if ( configUSE_PER_CORE_READY_LISTS == 1 )
+    PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriorities[ configNUMBER_OF_CORES ] = { tskIDLE_PRIORITY };
+#elif ( configUSE_PRIORITY_BITMAP_TASK_SELECTION == 1 )
+    PRIVILEGED_DATA static volatile uint32_t ulReadyPriorityGroups = 0UL;
+    PRIVILEGED_DATA static volatile uint32_t ulReadyPriorities[ taskPRIORITY_BITMAP_WORDS ] = { 0UL };
+#else
+    PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
+#endif
+#if ( configUSE_WOKEN_TASK_SELECTION == 1 )
+    PRIVILEGED_DATA static TCB_t * volatile pxWokenTCB = NULL;             /*< The last task made ready with a priority above the running task. */
+    PRIVILEGED_DATA static volatile UBaseType_t uxWokenTasks = ( UBaseType_t ) 0U; /*< The number of such tasks made ready since the last context switch. */
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning = pdFALSE;
 PRIVILEGED_DATA static volatile TickType_t xPendedTicks = ( TickType_t ) 0U;
-PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
+
+#if ( configNUMBER_OF_CORES == 1 )
+    PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
+#else
+
+/* A yield is held pending per core.  xYieldPending refers to the calling core
+ * so can only be used while the calling task cannot move to another core -
+ * that is, from an interrupt, a critical section, or with the scheduler
+ * suspended. */
+    PRIVILEGED_DATA static volatile BaseType_t xYieldPendings[ configNUMBER_OF_CORES ] = { pdFALSE };
+    #define xYieldPending    xYieldPendings[ portGET_CORE_ID() ]
+#endif
+
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows = ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime = ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
-PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle = NULL;                          /*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandles[ configNUMBER_OF_CORES ];       /*< Holds the handles of the idle tasks, one per core.  The idle tasks are created automatically when the scheduler is started. */
 
 /* Improve support for OpenOCD. The kernel tracks Ready tasks via priority lists.
  * For tracking the state of remote threads, OpenOCD uses uxTopUsedPriority
@@ -389,11 +633,43 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t
 
 /* Do not move these variables to function scope as doing so prevents the
  * code working with debuggers that need to remove the static qualifier. */
-    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;    /*< Holds the value of a timer/counter the last time a task was switched in. */
+    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime[ configNUMBER_OF_CORES ]; /*< Holds the value of a timer/counter the last time a task was switched in on each core. */
     PRIVILEGED_DATA static volatile configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL; /*< Holds the total amount of execution time as defined by the run time counter clock. */
 
 #endif
 
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+/* The table of call sites.  It is only accessed with interrupts masked and,
+ * when configNUMBER_OF_CORES is greater than 1, the ISR spinlock held.  The
+ * state of the critical section being timed is held in the TCB of the task
+ * that entered it, as some ports switch tasks from within a critical section.
+ * The scheduler suspended region state is only accessed by the task that
+ * suspended the scheduler. */
+    PRIVILEGED_DATA static CriticalSectionStats_t xCriticalSectionStats[ configCRITICAL_SECTION_STATS_MAX_SITES ];
+    PRIVILEGED_DATA static UBaseType_t uxCriticalSectionStatsSites = ( UBaseType_t ) 0U;  /*< The number of entries of xCriticalSectionStats[] that are in use. */
+    PRIVILEGED_DATA static uint32_t ulCriticalSectionStatsDropped = 0UL;                  /*< Regions not recorded because xCriticalSectionStats[] was full. */
+    PRIVILEGED_DATA static CriticalSectionStats_t * pxSchedulerSuspendedStatsSite = NULL; /*< The call site that suspended the scheduler. */
+    PRIVILEGED_DATA static uint32_t ulSchedulerSuspendedStatsStart = 0UL;                 /*< The time at which the scheduler was suspended. */
+
+/* A task that is switched out from within a critical section holds the time it
+ * has spent in the region so far in place of the time at which it entered it,
+ * so the time for which it is not running is not attributed to the region.
+ * The same conversion turns one back into the other when it is switched in. */
+    #define taskCRITICAL_SECTION_STATS_SWITCH( pxTCB )                                                                              \
+    do {                                                                                                                            \
+        if( ( pxTCB )->uxCriticalSectionStatsNesting != ( UBaseType_t ) 0U )                                                        \
+        {                                                                                                                           \
+            ( pxTCB )->ulCriticalSectionStatsStart = portGET_CRITICAL_SECTION_TIMESTAMP() - ( pxTCB )->ulCriticalSectionStatsStart; \
+        }                                                                                                                           \
+    } while( 0 )
+
+#else
+
+    #define taskCRITICAL_SECTION_STATS_SWITCH( pxTCB )
+
+#endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -417,6 +693,32 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t
  */
 static void prvInitialiseTaskLists( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Create the idle task of each core.  Called when the scheduler is started.
+ */
+static BaseType_t prvCreateIdleTasks( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the entry of xCriticalSectionStats[] that records the call site at
+ * ulLine of pcFile, adding one if this is the first time the call site has been
+ * reached.  Returns NULL if the call site is new and the table is full.  MUST
+ * BE CALLED WITH INTERRUPTS MASKED.
+ */
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+    static CriticalSectionStats_t * prvCriticalSectionStatsGetSite( const char * pcFile,
+                                                                    uint32_t ulLine,
+                                                                    eCriticalRegionType eType ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+/*
+ * Add a region of ulDuration timestamp counts to the statistics of pxSite.
+ * MUST BE CALLED WITH INTERRUPTS MASKED.
+ */
+    static void prvCriticalSectionStatsRecord( CriticalSectionStats_t * pxSite,
+                                               uint32_t ulDuration ) PRIVILEGED_FUNCTION;
+
+#endif /* configGENERATE_CRITICAL_SECTION_STATS */
+
 /*
  * The idle task, which as all tasks is implemented as a never ending loop.
  * The idle task is automatically created and added to the ready lists upon
@@ -430,6 +732,77 @@ static void prvInitialiseTaskLists( void ) PRIVILEGED_FUNCTION;
  */
 static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * The idle task run by every core other than core 0.  It does not clean up
+ * deleted tasks or call the idle hook, as those are done by the idle task of
+ * core 0.
+ */
+    static portTASK_FUNCTION_PROTO( prvPassiveIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Make core xCoreID select a new task to run.  If xCoreID is the calling core
+ * the yield is held pending, otherwise the core is interrupted.  MUST BE CALLED
+ * FROM A CRITICAL SECTION.
+ */
+    static void prvYieldCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when pxTCB has become ready to run.  If pxTCB has a higher priority
+ * than the lowest priority task that is running on a core it is allowed to run
+ * on then that core is made to yield.  MUST BE CALLED FROM A CRITICAL SECTION.
+ */
+    static void prvYieldForTask( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Select the highest priority ready task that is not already running on
+ * another core, and is allowed to run on core xCoreID, as the task to run on
+ * core xCoreID.  MUST BE CALLED WITH BOTH KERNEL SPINLOCKS HELD.
+ */
+    static void prvSelectHighestPriorityTask( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_PER_CORE_READY_LISTS == 1 )
+
+/*
+ * Search the ready lists of core xListCore, from the highest priority down to
+ * uxLowestPriority, for a task that can be run on core xCoreID.  Returns NULL
+ * if there is no such task.  MUST BE CALLED WITH BOTH KERNEL SPINLOCKS HELD.
+ */
+        static TCB_t * prvSearchCoreReadyLists( BaseType_t xListCore,
+                                                BaseType_t xCoreID,
+                                                UBaseType_t uxLowestPriority ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of ready tasks of priority uxPriority held in the ready
+ * lists of all the cores.
+ */
+        static UBaseType_t prvReadyTaskCount( UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_PER_CORE_READY_LISTS */
+
+/*
+ * Called with interrupts masked before the calling core takes the kernel
+ * spinlocks.  If another core has told the calling task to yield while it was
+ * waiting for the spinlocks then the spinlocks are released and the yield is
+ * taken, so the calling task only enters the critical section once it is
+ * running again.
+ */
+    static void prvCheckForRunStateChange( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configNUMBER_OF_CORES */
+
+#if ( ( configUSE_PRIORITY_BITMAP_TASK_SELECTION == 1 ) && !defined( portCOUNT_LEADING_ZEROS ) )
+
+/*
+ * Returns the bit number of the most significant set bit in ulBitmap, which
+ * must not be zero.  Used by the priority bit map when the port does not
+ * provide a count leading zeros instruction.
+ */
+    static UBaseType_t prvHighestSetBit( uint32_t ulBitmap ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Utility to free all memory allocated by the scheduler to hold a TCB,
  * including the stack pointed to by the TCB.
@@ -491,7 +864,7 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 #if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
 
-    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte ) PRIVILEGED_FUNCTION;
+    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
 
 #endif
 
@@ -527,6 +900,23 @@ static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
 #endif
 
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+/*
+ * Marks notification uxIndexToNotify of pxTCB as received and updates its
+ * value as specified by eAction.  ucOriginalNotifyState is the notify state
+ * before the call.  Returns pdFAIL if eAction is eSetValueWithoutOverwrite and
+ * a notification was already pending, otherwise pdPASS.  MUST BE CALLED FROM A
+ * CRITICAL SECTION.
+ */
+    static BaseType_t prvSetNotificationValue( TCB_t * pxTCB,
+                                               UBaseType_t uxIndexToNotify,
+                                               uint32_t ulValue,
+                                               eNotifyAction eAction,
+                                               uint8_t ucOriginalNotifyState ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Called after a Task_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -848,6 +1238,13 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     }
     #endif /* tskSET_NEW_STACKS_TO_KNOWN_VALUE */
 
+    #if ( configSTACK_HIGH_WATER_MARK_BINARY_SEARCH == 1 )
+    {
+        /* None of the stack has been used yet. */
+        pxNewTCB->uxStackHighWaterMark = ( configSTACK_DEPTH_TYPE ) ulStackDepth;
+    }
+    #endif
+
     /* Calculate the top of stack address.  This depends on whether the stack
      * grows from high memory to low (as per the 80x86) or vice versa.
      * portSTACK_GROWTH is used to make the result positive or negative as required
@@ -940,6 +1337,34 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
     listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
 
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        pxNewTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+
+        #if ( configUSE_PER_CORE_READY_LISTS == 1 )
+        {
+            /* The task starts in the ready lists of the core that created it. */
+            pxNewTCB->xReadyListCore = portGET_CORE_ID();
+        }
+        #endif
+
+        if( ( pxTaskCode == prvIdleTask ) || ( pxTaskCode == prvPassiveIdleTask ) )
+        {
+            pxNewTCB->uxTaskAttributes |= taskATTRIBUTE_IS_IDLE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configNUMBER_OF_CORES */
+
+    #if ( configUSE_CORE_AFFINITY == 1 )
+    {
+        pxNewTCB->uxCoreAffinityMask = tskNO_AFFINITY;
+    }
+    #endif
+
     #if ( portUSING_MPU_WRAPPERS == 1 )
     {
         vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
@@ -1023,26 +1448,79 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 }
 /*-----------------------------------------------------------*/
 
-static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
-{
-    /* Ensure interrupts don't access the task lists while the lists are being
-     * updated. */
-    taskENTER_CRITICAL();
-    {
-        uxCurrentNumberOfTasks++;
+#if ( configNUMBER_OF_CORES == 1 )
 
-        if( pxCurrentTCB == NULL )
+    static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
+    {
+        /* Ensure interrupts don't access the task lists while the lists are being
+         * updated. */
+        taskENTER_CRITICAL();
         {
-            /* There are no other tasks, or all the other tasks are in
-             * the suspended state - make this the current task. */
-            pxCurrentTCB = pxNewTCB;
+            uxCurrentNumberOfTasks++;
+
+            if( pxCurrentTCB == NULL )
+            {
+                /* There are no other tasks, or all the other tasks are in
+                 * the suspended state - make this the current task. */
+                pxCurrentTCB = pxNewTCB;
+
+                if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+                {
+                    /* This is the first task to be created so do the preliminary
+                     * initialisation required.  We will not recover if this call
+                     * fails, but we will report the failure. */
+                    prvInitialiseTaskLists();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* If the scheduler is not already running, make this task the
+                 * current task if it is the highest priority task to be created
+                 * so far. */
+                if( xSchedulerRunning == pdFALSE )
+                {
+                    if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+                    {
+                        pxCurrentTCB = pxNewTCB;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            uxTaskNumber++;
 
-            if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+            #if ( configUSE_TRACE_FACILITY == 1 )
             {
-                /* This is the first task to be created so do the preliminary
-                 * initialisation required.  We will not recover if this call
-                 * fails, but we will report the failure. */
-                prvInitialiseTaskLists();
+                /* Add a counter into the TCB for tracing only. */
+                pxNewTCB->uxTCBNumber = uxTaskNumber;
+            }
+            #endif /* configUSE_TRACE_FACILITY */
+            traceTASK_CREATE( pxNewTCB );
+
+            prvAddTaskToReadyList( pxNewTCB );
+
+            portSETUP_TCB( pxNewTCB );
+        }
+        taskEXIT_CRITICAL();
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* If the created task is of a higher priority than the current task
+             * then it should run now. */
+            if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+            {
+                taskYIELD_IF_USING_PREEMPTION();
             }
             else
             {
@@ -1051,14 +1529,60 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         }
         else
         {
-            /* If the scheduler is not already running, make this task the
-             * current task if it is the highest priority task to be created
-             * so far. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#else /* configNUMBER_OF_CORES */
+
+    static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
+    {
+        /* Ensure interrupts don't access the task lists while the lists are
+         * being updated. */
+        taskENTER_CRITICAL();
+        {
+            uxCurrentNumberOfTasks++;
+
             if( xSchedulerRunning == pdFALSE )
             {
-                if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+                if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+                {
+                    /* This is the first task to be created so do the
+                     * preliminary initialisation required.  We will not recover
+                     * if this call fails, but we will report the failure. */
+                    prvInitialiseTaskLists();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Each core starts the scheduler running an idle task.  The
+                 * idle tasks yield as soon as they run, so the application
+                 * tasks are then selected in priority order. */
+                if( ( pxNewTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
                 {
-                    pxCurrentTCB = pxNewTCB;
+                    BaseType_t xCoreID;
+
+                    for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                    {
+                        if( pxCurrentTCBs[ xCoreID ] == NULL )
+                        {
+                            pxNewTCB->xTaskRunState = xCoreID;
+                            pxCurrentTCBs[ xCoreID ] = pxNewTCB;
+
+                            #if ( configUSE_PER_CORE_READY_LISTS == 1 )
+                            {
+                                pxNewTCB->xReadyListCore = xCoreID;
+                            }
+                            #endif
+                            break;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
                 }
                 else
                 {
@@ -1069,42 +1593,37 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             {
                 mtCOVERAGE_TEST_MARKER();
             }
-        }
 
-        uxTaskNumber++;
+            uxTaskNumber++;
 
-        #if ( configUSE_TRACE_FACILITY == 1 )
-        {
-            /* Add a counter into the TCB for tracing only. */
-            pxNewTCB->uxTCBNumber = uxTaskNumber;
-        }
-        #endif /* configUSE_TRACE_FACILITY */
-        traceTASK_CREATE( pxNewTCB );
+            #if ( configUSE_TRACE_FACILITY == 1 )
+            {
+                /* Add a counter into the TCB for tracing only. */
+                pxNewTCB->uxTCBNumber = uxTaskNumber;
+            }
+            #endif /* configUSE_TRACE_FACILITY */
+            traceTASK_CREATE( pxNewTCB );
 
-        prvAddTaskToReadyList( pxNewTCB );
+            prvAddTaskToReadyList( pxNewTCB );
 
-        portSETUP_TCB( pxNewTCB );
-    }
-    taskEXIT_CRITICAL();
+            portSETUP_TCB( pxNewTCB );
 
-    if( xSchedulerRunning != pdFALSE )
-    {
-        /* If the created task is of a higher priority than the current task
-         * then it should run now. */
-        if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
-        {
-            taskYIELD_IF_USING_PREEMPTION();
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
+            if( xSchedulerRunning != pdFALSE )
+            {
+                /* If the created task is of a higher priority than a task
+                 * running on a core it can run on then that core should switch
+                 * to it. */
+                prvYieldForTask( pxNewTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
+        taskEXIT_CRITICAL();
     }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
-}
+
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -1112,6 +1631,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     void vTaskDelete( TaskHandle_t xTaskToDelete )
     {
         TCB_t * pxTCB;
+        BaseType_t xDeleteTCBInIdleTask = pdFALSE;
 
         taskENTER_CRITICAL();
         {
@@ -1139,13 +1659,31 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 mtCOVERAGE_TEST_MARKER();
             }
 
+            #if ( configUSE_WOKEN_TASK_SELECTION == 1 )
+            {
+                /* The TCB can be freed before the next context switch, which
+                 * must not then look at it. */
+                if( pxTCB == pxWokenTCB )
+                {
+                    uxWokenTasks = taskSEARCH_READY_LISTS;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+
             /* Increment the uxTaskNumber also so kernel aware debuggers can
              * detect that the task lists need re-generating.  This is done before
              * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
              * not return. */
             uxTaskNumber++;
 
-            if( pxTCB == pxCurrentTCB )
+            /* When configNUMBER_OF_CORES is greater than 1 the task being
+             * deleted might be running on another core, in which case its stack
+             * is still in use until that core switches away from it. */
+            if( taskTASK_IS_RUNNING_OR_SCHEDULED_TO_YIELD( pxTCB ) )
             {
                 /* A task is deleting itself.  This cannot complete within the
                  * task itself, as a context switch to another task is required.
@@ -1153,6 +1691,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                  * check the termination list and free up any memory allocated by
                  * the scheduler for the TCB and stack of the deleted task. */
                 vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
+                xDeleteTCBInIdleTask = pdTRUE;
 
                 /* Increment the ucTasksDeleted variable so the idle task knows
                  * there is a task that has been deleted and that it should therefore
@@ -1169,10 +1708,25 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                  * hence xYieldPending is used to latch that a context switch is
                  * required. */
                 portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
-            }
-            else
-            {
-                --uxCurrentNumberOfTasks;
+
+                #if ( configNUMBER_OF_CORES > 1 )
+                {
+                    /* A task deleted while running on another core is made to
+                     * yield that core. */
+                    if( ( taskTASK_IS_RUNNING( pxTCB ) ) && ( pxTCB->xTaskRunState != portGET_CORE_ID() ) )
+                    {
+                        prvYieldCore( pxTCB->xTaskRunState );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configNUMBER_OF_CORES */
+            }
+            else
+            {
+                --uxCurrentNumberOfTasks;
                 traceTASK_DELETE( pxTCB );
 
                 /* Reset the next expected unblock time in case it referred to
@@ -1185,7 +1739,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         /* If the task is not deleting itself, call prvDeleteTCB from outside of
          * critical section. If a task deletes itself, prvDeleteTCB is called
          * from prvCheckTasksWaitingTermination which is called from Idle task. */
-        if( pxTCB != pxCurrentTCB )
+        if( xDeleteTCBInIdleTask != pdTRUE )
         {
             prvDeleteTCB( pxTCB );
         }
@@ -1196,7 +1750,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         {
             if( pxTCB == pxCurrentTCB )
             {
-                configASSERT( uxSchedulerSuspended == 0 );
+                taskASSERT_SCHEDULER_NOT_SUSPENDED();
                 portYIELD_WITHIN_API();
             }
             else
@@ -1219,7 +1773,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 
         configASSERT( pxPreviousWakeTime );
         configASSERT( ( xTimeIncrement > 0U ) );
-        configASSERT( uxSchedulerSuspended == 0 );
+        taskASSERT_SCHEDULER_NOT_SUSPENDED();
 
         vTaskSuspendAll();
         {
@@ -1305,7 +1859,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         /* A delay time of zero just forces a reschedule. */
         if( xTicksToDelay > ( TickType_t ) 0U )
         {
-            configASSERT( uxSchedulerSuspended == 0 );
+            taskASSERT_SCHEDULER_NOT_SUSPENDED();
             vTaskSuspendAll();
             {
                 traceTASK_DELAY();
@@ -1353,9 +1907,11 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 
         configASSERT( pxTCB );
 
-        if( pxTCB == pxCurrentTCB )
+        if( taskTASK_IS_RUNNING( pxTCB ) )
         {
-            /* The task calling this function is querying its own state. */
+            /* The task is the task calling this function or, when
+             * configNUMBER_OF_CORES is greater than 1, is running on another
+             * core. */
             eReturn = eRunning;
         }
         else
@@ -1487,14 +2043,14 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
          * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
         portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-        uxSavedInterruptState = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptState = taskENTER_CRITICAL_FROM_ISR();
         {
             /* If null is passed in here then it is the priority of the calling
              * task that is being queried. */
             pxTCB = prvGetTCBFromHandle( xTask );
             uxReturn = pxTCB->uxPriority;
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptState );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptState );
 
         return uxReturn;
     }
@@ -1543,44 +2099,49 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 
             if( uxCurrentBasePriority != uxNewPriority )
             {
-                /* The priority change may have readied a task of higher
-                 * priority than the calling task. */
-                if( uxNewPriority > uxCurrentBasePriority )
+                #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    if( pxTCB != pxCurrentTCB )
+                    /* The priority change may have readied a task of higher
+                     * priority than the calling task. */
+                    if( uxNewPriority > uxCurrentBasePriority )
                     {
-                        /* The priority of a task other than the currently
-                         * running task is being raised.  Is the priority being
-                         * raised above that of the running task? */
-                        if( uxNewPriority >= pxCurrentTCB->uxPriority )
+                        if( pxTCB != pxCurrentTCB )
                         {
-                            xYieldRequired = pdTRUE;
+                            /* The priority of a task other than the currently
+                             * running task is being raised.  Is the priority
+                             * being raised above that of the running task? */
+                            if( uxNewPriority >= pxCurrentTCB->uxPriority )
+                            {
+                                xYieldRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
                         }
                         else
                         {
-                            mtCOVERAGE_TEST_MARKER();
+                            /* The priority of the running task is being raised,
+                             * but the running task must already be the highest
+                             * priority task able to run so no yield is
+                             * required. */
                         }
                     }
+                    else if( pxTCB == pxCurrentTCB )
+                    {
+                        /* Setting the priority of the running task down means
+                         * there may now be another task of higher priority that
+                         * is ready to execute. */
+                        xYieldRequired = pdTRUE;
+                    }
                     else
                     {
-                        /* The priority of the running task is being raised,
-                         * but the running task must already be the highest
-                         * priority task able to run so no yield is required. */
+                        /* Setting the priority of any other task down does not
+                         * require a yield as the running task must be above the
+                         * new priority of the task being modified. */
                     }
                 }
-                else if( pxTCB == pxCurrentTCB )
-                {
-                    /* Setting the priority of the running task down means
-                     * there may now be another task of higher priority that
-                     * is ready to execute. */
-                    xYieldRequired = pdTRUE;
-                }
-                else
-                {
-                    /* Setting the priority of any other task down does not
-                     * require a yield as the running task must be above the
-                     * new priority of the task being modified. */
-                }
+                #endif /* configNUMBER_OF_CORES */
 
                 /* Remember the ready list the task might be referenced from
                  * before its uxPriority member is changed so the
@@ -1624,7 +2185,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                  * nothing more than change its priority variable. However, if
                  * the task is in a ready list it needs to be removed and placed
                  * in the list appropriate to its new priority. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                if( listIS_CONTAINED_WITHIN( taskREADY_LIST( pxTCB, uxPriorityUsedOnEntry ), &( pxTCB->xStateListItem ) ) != pdFALSE )
                 {
                     /* The task is currently in its ready list - remove before
                      * adding it to its new ready list.  As we are in a critical
@@ -1648,14 +2209,47 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                     mtCOVERAGE_TEST_MARKER();
                 }
 
-                if( xYieldRequired != pdFALSE )
+                #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    taskYIELD_IF_USING_PREEMPTION();
+                    if( xYieldRequired != pdFALSE )
+                    {
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
-                else
+                #else /* configNUMBER_OF_CORES */
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    if( taskTASK_IS_RUNNING( pxTCB ) )
+                    {
+                        /* Setting the priority of a running task down means
+                         * there may now be a task of higher priority that is
+                         * ready to run on the core it is running on. */
+                        if( uxNewPriority < uxCurrentBasePriority )
+                        {
+                            taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else if( listIS_CONTAINED_WITHIN( taskREADY_LIST( pxTCB, pxTCB->uxPriority ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                    {
+                        /* A ready task whose priority has been raised might now
+                         * preempt the task running on a core. */
+                        taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    ( void ) xYieldRequired;
                 }
+                #endif /* configNUMBER_OF_CORES */
 
                 /* Remove compiler warning about unused variables when the port
                  * optimised task selection is not being used. */
@@ -1668,6 +2262,83 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 #endif /* INCLUDE_vTaskPrioritySet */
 /*-----------------------------------------------------------*/
 
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+
+    void vTaskCoreAffinitySet( const TaskHandle_t xTask,
+                               UBaseType_t uxCoreAffinityMask )
+    {
+        TCB_t * pxTCB;
+
+        /* A task must be allowed to run on at least one core. */
+        configASSERT( ( uxCoreAffinityMask & ( ( ( UBaseType_t ) 1U << configNUMBER_OF_CORES ) - 1U ) ) != 0U );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            /* The idle tasks are what each core runs when there is nothing
+             * else to run, so must remain free to run on any core. */
+            configASSERT( ( pxTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) == 0U );
+
+            pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+
+            if( xSchedulerRunning != pdFALSE )
+            {
+                if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
+                {
+                    /* The task must leave a core it is no longer allowed to
+                     * run on. */
+                    if( taskCAN_RUN_ON_CORE( pxTCB, pxTCB->xTaskRunState ) == pdFALSE )
+                    {
+                        prvYieldCore( pxTCB->xTaskRunState );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else if( listIS_CONTAINED_WITHIN( taskREADY_LIST( pxTCB, pxTCB->uxPriority ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                {
+                    /* A ready task might now be allowed to run on a core that
+                     * is running a task of lower priority. */
+                    taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+
+    UBaseType_t uxTaskCoreAffinityGet( const TaskHandle_t xTask )
+    {
+        const TCB_t * pxTCB;
+        UBaseType_t uxCoreAffinityMask;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxCoreAffinityMask = pxTCB->uxCoreAffinityMask;
+        }
+        taskEXIT_CRITICAL();
+
+        return uxCoreAffinityMask;
+    }
+
+#endif /* ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskSuspend == 1 )
 
     void vTaskSuspend( TaskHandle_t xTaskToSuspend )
@@ -1720,6 +2391,21 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 }
             }
             #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                /* A task suspended while running on another core is made to
+                 * yield that core.  The calling task yields below. */
+                if( ( xSchedulerRunning != pdFALSE ) && ( taskTASK_IS_RUNNING( pxTCB ) ) && ( pxTCB->xTaskRunState != portGET_CORE_ID() ) )
+                {
+                    prvYieldCore( pxTCB->xTaskRunState );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configNUMBER_OF_CORES */
         }
         taskEXIT_CRITICAL();
 
@@ -1743,26 +2429,38 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             if( xSchedulerRunning != pdFALSE )
             {
                 /* The current task has just been suspended. */
-                configASSERT( uxSchedulerSuspended == 0 );
+                taskASSERT_SCHEDULER_NOT_SUSPENDED();
                 portYIELD_WITHIN_API();
             }
             else
             {
-                /* The scheduler is not running, but the task that was pointed
-                 * to by pxCurrentTCB has just been suspended and pxCurrentTCB
-                 * must be adjusted to point to a different task. */
-                if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
+                #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    /* No other tasks are ready, so set pxCurrentTCB back to
-                     * NULL so when the next task is created pxCurrentTCB will
-                     * be set to point to it no matter what its relative priority
-                     * is. */
-                    pxCurrentTCB = NULL;
+                    /* The scheduler is not running, but the task that was
+                     * pointed to by pxCurrentTCB has just been suspended and
+                     * pxCurrentTCB must be adjusted to point to a different
+                     * task. */
+                    if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
+                    {
+                        /* No other tasks are ready, so set pxCurrentTCB back to
+                         * NULL so when the next task is created pxCurrentTCB
+                         * will be set to point to it no matter what its relative
+                         * priority is. */
+                        pxCurrentTCB = NULL;
+                    }
+                    else
+                    {
+                        vTaskSwitchContext();
+                    }
                 }
-                else
+                #else /* configNUMBER_OF_CORES */
                 {
-                    vTaskSwitchContext();
+                    /* Before the scheduler is started only the idle tasks are
+                     * assigned to cores, and the idle tasks are never
+                     * suspended. */
+                    configASSERT( pdFALSE );
                 }
+                #endif /* configNUMBER_OF_CORES */
             }
         }
         else
@@ -1845,17 +2543,25 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                     prvAddTaskToReadyList( pxTCB );
 
                     /* A higher priority task may have just been resumed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #if ( configNUMBER_OF_CORES == 1 )
                     {
-                        /* This yield may not cause the task just resumed to run,
-                         * but will leave the lists in the correct state for the
-                         * next yield. */
-                        taskYIELD_IF_USING_PREEMPTION();
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                        {
+                            /* This yield may not cause the task just resumed to
+                             * run, but will leave the lists in the correct state
+                             * for the next yield. */
+                            taskYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
-                    else
+                    #else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
                     }
+                    #endif /* configNUMBER_OF_CORES */
                 }
                 else
                 {
@@ -1902,7 +2608,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
          * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
         portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
             if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
             {
@@ -1913,22 +2619,36 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 {
                     /* Ready lists can be accessed so move the task from the
                      * suspended list to the ready list directly. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #if ( configNUMBER_OF_CORES == 1 )
                     {
-                        xYieldRequired = pdTRUE;
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                        {
+                            xYieldRequired = pdTRUE;
 
-                        /* Mark that a yield is pending in case the user is not
-                         * using the return value to initiate a context switch
-                         * from the ISR using portYIELD_FROM_ISR. */
-                        xYieldPending = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
+                            /* Mark that a yield is pending in case the user is
+                             * not using the return value to initiate a context
+                             * switch from the ISR using portYIELD_FROM_ISR. */
+                            xYieldPending = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
+                    #endif /* configNUMBER_OF_CORES */
 
                     ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
                     prvAddTaskToReadyList( pxTCB );
+
+                    #if ( configNUMBER_OF_CORES > 1 )
+                    {
+                        /* The resumed task may preempt the task running on any
+                         * core.  Only a yield of the core running this interrupt
+                         * is reported to the caller. */
+                        taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
+                        xYieldRequired = xYieldPending;
+                    }
+                    #endif /* configNUMBER_OF_CORES */
                 }
                 else
                 {
@@ -1943,7 +2663,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
         return xYieldRequired;
     }
@@ -1951,48 +2671,133 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 #endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-void vTaskStartScheduler( void )
+static BaseType_t prvCreateIdleTasks( void )
 {
-    BaseType_t xReturn;
+    BaseType_t xReturn = pdPASS;
+    BaseType_t xCoreID;
+    TaskFunction_t pxIdleTaskFunction = prvIdleTask;
+    const char * pcIdleTaskName = configIDLE_TASK_NAME; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        char cIdleName[ configMAX_TASK_NAME_LEN ]; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    #endif
 
-    /* Add the idle task at the lowest priority. */
-    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    /* One idle task is created for each core, all at the lowest priority. */
+    for( xCoreID = ( BaseType_t ) 0; ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) && ( xReturn == pdPASS ); xCoreID++ )
     {
-        StaticTask_t * pxIdleTaskTCBBuffer = NULL;
-        StackType_t * pxIdleTaskStackBuffer = NULL;
-        uint32_t ulIdleTaskStackSize;
+        #if ( configNUMBER_OF_CORES > 1 )
+        {
+            UBaseType_t x;
+
+            /* The idle tasks are named after the core they are created for
+             * so they can be told apart.  The name is truncated if necessary
+             * to leave room for the core number. */
+            for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) ( configMAX_TASK_NAME_LEN - 3 ); x++ )
+            {
+                cIdleName[ x ] = configIDLE_TASK_NAME[ x ];
+
+                if( cIdleName[ x ] == ( char ) 0x00 )
+                {
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            if( xCoreID >= ( BaseType_t ) 10 )
+            {
+                cIdleName[ x ] = ( char ) ( ( xCoreID / 10 ) + '0' );
+                x++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-        /* The Idle task is created using user provided RAM - obtain the
-         * address of the RAM then create the idle task. */
-        vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
-        xIdleTaskHandle = xTaskCreateStatic( prvIdleTask,
-                                             configIDLE_TASK_NAME,
-                                             ulIdleTaskStackSize,
-                                             ( void * ) NULL,       /*lint !e961.  The cast is not redundant for all compilers. */
-                                             portPRIVILEGE_BIT,     /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-                                             pxIdleTaskStackBuffer,
-                                             pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+            cIdleName[ x ] = ( char ) ( ( xCoreID % 10 ) + '0' );
+            cIdleName[ x + 1U ] = ( char ) 0x00;
+            pcIdleTaskName = cIdleName;
+
+            /* Only the idle task of core 0 cleans up deleted tasks and calls
+             * the idle hook. */
+            if( xCoreID != ( BaseType_t ) 0 )
+            {
+                pxIdleTaskFunction = prvPassiveIdleTask;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configNUMBER_OF_CORES */
 
-        if( xIdleTaskHandle != NULL )
+        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
         {
-            xReturn = pdPASS;
+            StaticTask_t * pxIdleTaskTCBBuffer = NULL;
+            StackType_t * pxIdleTaskStackBuffer = NULL;
+            uint32_t ulIdleTaskStackSize;
+
+            /* The Idle task is created using user provided RAM - obtain the
+             * address of the RAM then create the idle task. */
+            #if ( configNUMBER_OF_CORES == 1 )
+            {
+                vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
+            }
+            #else
+            {
+                if( xCoreID == ( BaseType_t ) 0 )
+                {
+                    vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
+                }
+                else
+                {
+                    vApplicationGetPassiveIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize, xCoreID - ( BaseType_t ) 1 );
+                }
+            }
+            #endif /* configNUMBER_OF_CORES */
+
+            xIdleTaskHandles[ xCoreID ] = xTaskCreateStatic( pxIdleTaskFunction,
+                                                             pcIdleTaskName,
+                                                             ulIdleTaskStackSize,
+                                                             ( void * ) NULL,       /*lint !e961.  The cast is not redundant for all compilers. */
+                                                             portPRIVILEGE_BIT,     /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                                             pxIdleTaskStackBuffer,
+                                                             pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+
+            if( xIdleTaskHandles[ xCoreID ] != NULL )
+            {
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
         }
-        else
+        #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
         {
-            xReturn = pdFAIL;
+            /* The Idle task is being created using dynamically allocated RAM. */
+            xReturn = xTaskCreate( pxIdleTaskFunction,
+                                   pcIdleTaskName,
+                                   configMINIMAL_STACK_SIZE,
+                                   ( void * ) NULL,
+                                   portPRIVILEGE_BIT,             /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                   &xIdleTaskHandles[ xCoreID ] ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
         }
+        #endif /* configSUPPORT_STATIC_ALLOCATION */
     }
-    #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
-    {
-        /* The Idle task is being created using dynamically allocated RAM. */
-        xReturn = xTaskCreate( prvIdleTask,
-                               configIDLE_TASK_NAME,
-                               configMINIMAL_STACK_SIZE,
-                               ( void * ) NULL,
-                               portPRIVILEGE_BIT,  /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-                               &xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
-    }
-    #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskStartScheduler( void )
+{
+    BaseType_t xReturn;
+
+    /* Add the idle tasks at the lowest priority. */
+    xReturn = prvCreateIdleTasks();
 
     #if ( configUSE_TIMERS == 1 )
     {
@@ -2037,6 +2842,14 @@ void vTaskStartScheduler( void )
         xSchedulerRunning = pdTRUE;
         xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
 
+        #if ( configUSE_WOKEN_TASK_SELECTION == 1 )
+        {
+            /* pxCurrentTCB already holds the highest priority task created, so
+             * forget the tasks recorded as they were created. */
+            uxWokenTasks = ( UBaseType_t ) 0U;
+        }
+        #endif
+
         /* If configGENERATE_RUN_TIME_STATS is defined then the following
          * macro must be defined to configure the timer/counter used to generate
          * the run time counter time base.   NOTE:  If configGENERATE_RUN_TIME_STATS
@@ -2067,8 +2880,8 @@ void vTaskStartScheduler( void )
     }
 
     /* Prevent compiler warnings if INCLUDE_xTaskGetIdleTaskHandle is set to 0,
-     * meaning xIdleTaskHandle is not used anywhere else. */
-    ( void ) xIdleTaskHandle;
+     * meaning xIdleTaskHandles is not used anywhere else. */
+    ( void ) xIdleTaskHandles;
 
     /* OpenOCD makes use of uxTopUsedPriority for thread debugging. Prevent uxTopUsedPriority
      * from getting optimized out as it is no longer used by the kernel. */
@@ -2087,27 +2900,107 @@ void vTaskEndScheduler( void )
 }
 /*----------------------------------------------------------*/
 
-void vTaskSuspendAll( void )
+/* The name is in parenthesis so it is not expanded by the vTaskSuspendAll()
+ * macro that task.h defines when configGENERATE_CRITICAL_SECTION_STATS is 1. */
+void ( vTaskSuspendAll )( void )
 {
-    /* A critical section is not required as the variable is of type
-     * BaseType_t.  Please read Richard Barry's reply in the following link to a
-     * post in the FreeRTOS support forum before reporting this as a bug! -
-     * https://goo.gl/wu4acr */
-
-    /* portSOFTWARE_BARRIER() is only implemented for emulated/simulated ports that
-     * do not otherwise exhibit real time behaviour. */
-    portSOFTWARE_BARRIER();
-
-    /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
-     * is used to allow calls to vTaskSuspendAll() to nest. */
-    ++uxSchedulerSuspended;
-
-    /* Enforces ordering for ports and optimised compilers that may otherwise place
-     * the above increment elsewhere. */
-    portMEMORY_BARRIER();
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        /* A critical section is not required as the variable is of type
+         * BaseType_t.  Please read Richard Barry's reply in the following link
+         * to a post in the FreeRTOS support forum before reporting this as a
+         * bug! - https://goo.gl/wu4acr */
+
+        /* portSOFTWARE_BARRIER() is only implemented for emulated/simulated
+         * ports that do not otherwise exhibit real time behaviour. */
+        portSOFTWARE_BARRIER();
+
+        /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An
+         * increment is used to allow calls to vTaskSuspendAll() to nest. */
+        ++uxSchedulerSuspended;
+
+        /* Enforces ordering for ports and optimised compilers that may
+         * otherwise place the above increment elsewhere. */
+        portMEMORY_BARRIER();
+    }
+    #else /* configNUMBER_OF_CORES */
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* Interrupts are masked so the calling task cannot move to another
+             * core while it takes the task lock.  The task lock is held until
+             * the matching call to xTaskResumeAll(), which stops tasks on other
+             * cores entering critical sections or suspending the scheduler. */
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+            portSOFTWARE_BARRIER();
+            portGET_TASK_LOCK();
+
+            /* Another core may have told the calling task to yield while it
+             * was waiting for the task lock. */
+            if( ( uxSchedulerSuspended == ( UBaseType_t ) 0U ) && ( pxCurrentTCBs[ portGET_CORE_ID() ]->uxCriticalNesting == ( UBaseType_t ) 0U ) )
+            {
+                prvCheckForRunStateChange();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The ISR lock is taken so interrupts on other cores see a
+             * consistent value. */
+            portGET_ISR_LOCK();
+            {
+                ++uxSchedulerSuspended;
+            }
+            portRELEASE_ISR_LOCK();
+
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        }
+        else
+        {
+            ++uxSchedulerSuspended;
+        }
+    }
+    #endif /* configNUMBER_OF_CORES */
 }
 /*----------------------------------------------------------*/
 
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+    void vTaskSuspendAllFromSite( const char * pcFile,
+                                  uint32_t ulLine ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        ( vTaskSuspendAll )();
+
+        /* Only the outermost call is timed.  No other task can suspend the
+         * scheduler until the matching call to xTaskResumeAll(), so the
+         * suspended region state does not need protecting - but the call site
+         * table is shared with interrupts and, when configNUMBER_OF_CORES is
+         * greater than 1, with critical sections on other cores.  The port
+         * layer critical section is used so the lookup is not itself recorded
+         * as a critical section. */
+        if( uxSchedulerSuspended == ( UBaseType_t ) 1U )
+        {
+            portENTER_CRITICAL();
+            {
+                pxSchedulerSuspendedStatsSite = prvCriticalSectionStatsGetSite( pcFile, ulLine, eSchedulerSuspended );
+            }
+            portEXIT_CRITICAL();
+
+            ulSchedulerSuspendedStatsStart = portGET_CRITICAL_SECTION_TIMESTAMP();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configGENERATE_CRITICAL_SECTION_STATS */
+/*----------------------------------------------------------*/
+
 #if ( configUSE_TICKLESS_IDLE != 0 )
 
     static TickType_t prvGetExpectedIdleTime( void )
@@ -2119,7 +3012,16 @@ void vTaskSuspendAll( void )
          * configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
          * task that are in the Ready state, even though the idle task is
          * running. */
-        #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+        #if ( configUSE_PRIORITY_BITMAP_TASK_SELECTION == 1 )
+        {
+            /* Bits other than bit 0 of the first group are set if tasks that
+             * have a priority above the idle priority are in the Ready state. */
+            if( ( ulReadyPriorityGroups > 1UL ) || ( ulReadyPriorities[ 0 ] > 1UL ) )
+            {
+                uxHigherPriorityReadyTasks = pdTRUE;
+            }
+        }
+        #elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
         {
             if( uxTopReadyPriority > tskIDLE_PRIORITY )
             {
@@ -2140,7 +3042,7 @@ void vTaskSuspendAll( void )
                 uxHigherPriorityReadyTasks = pdTRUE;
             }
         }
-        #endif /* if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) */
+        #endif /* if ( configUSE_PRIORITY_BITMAP_TASK_SELECTION == 1 ) */
 
         if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
         {
@@ -2189,8 +3091,37 @@ BaseType_t xTaskResumeAll( void )
     {
         --uxSchedulerSuspended;
 
+        #if ( configNUMBER_OF_CORES > 1 )
+        {
+            /* Release the task lock taken by the matching vTaskSuspendAll().
+             * It is still held by the critical section. */
+            if( xSchedulerRunning != pdFALSE )
+            {
+                portRELEASE_TASK_LOCK();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
         if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
         {
+            #if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+            {
+                if( pxSchedulerSuspendedStatsSite != NULL )
+                {
+                    prvCriticalSectionStatsRecord( pxSchedulerSuspendedStatsSite, portGET_CRITICAL_SECTION_TIMESTAMP() - ulSchedulerSuspendedStatsStart );
+                    pxSchedulerSuspendedStatsSite = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configGENERATE_CRITICAL_SECTION_STATS */
+
             if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
             {
                 /* Move any readied tasks from the pending list into the
@@ -2203,16 +3134,27 @@ BaseType_t xTaskResumeAll( void )
                     listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
                     prvAddTaskToReadyList( pxTCB );
 
-                    /* If the moved task has a priority higher than or equal to
-                     * the current task then a yield must be performed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #if ( configNUMBER_OF_CORES == 1 )
                     {
-                        xYieldPending = pdTRUE;
+                        /* If the moved task has a priority higher than or
+                         * equal to the current task then a yield must be
+                         * performed. */
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                        {
+                            xYieldPending = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
-                    else
+                    #else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        /* The moved task may preempt the task running on any
+                         * core, including this one. */
+                        taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
                     }
+                    #endif /* configNUMBER_OF_CORES */
                 }
 
                 if( pxTCB != NULL )
@@ -2424,7 +3366,7 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
 
     TaskHandle_t xTaskGetHandle( const char * pcNameToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
     {
-        UBaseType_t uxQueue = configMAX_PRIORITIES;
+        UBaseType_t uxQueue = taskNUMBER_OF_READY_LISTS;
         TCB_t * pxTCB;
 
         /* Task names will be truncated to configMAX_TASK_NAME_LEN - 1 bytes. */
@@ -2490,7 +3432,7 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
                                       const UBaseType_t uxArraySize,
                                       configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
     {
-        UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
+        UBaseType_t uxTask = 0, uxQueue = taskNUMBER_OF_READY_LISTS;
 
         vTaskSuspendAll();
         {
@@ -2564,14 +3506,29 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
     TaskHandle_t xTaskGetIdleTaskHandle( void )
     {
         /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
-         * started, then xIdleTaskHandle will be NULL. */
-        configASSERT( ( xIdleTaskHandle != NULL ) );
-        return xIdleTaskHandle;
+         * started, then xIdleTaskHandles[ 0 ] will be NULL. */
+        configASSERT( ( xIdleTaskHandles[ 0 ] != NULL ) );
+        return xIdleTaskHandles[ 0 ];
     }
 
 #endif /* INCLUDE_xTaskGetIdleTaskHandle */
 /*----------------------------------------------------------*/
 
+#if ( ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
+
+    TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID )
+    {
+        configASSERT( ( xCoreID >= ( BaseType_t ) 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
+
+        /* If xTaskGetIdleTaskHandleForCore() is called before the scheduler has
+         * been started, then the handle will be NULL. */
+        configASSERT( ( xIdleTaskHandles[ xCoreID ] != NULL ) );
+        return xIdleTaskHandles[ xCoreID ];
+    }
+
+#endif /* ( ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) && ( configNUMBER_OF_CORES > 1 ) ) */
+/*----------------------------------------------------------*/
+
 /* This conditional compilation should use inequality to 0, not equality to 1.
  * This is to ensure vTaskStepTick() is available when user defined low power mode
  * implementations require configUSE_TICKLESS_IDLE to be set to a value other than
@@ -2619,7 +3576,7 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
 
     /* Must not be called with the scheduler suspended as the implementation
      * relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
-    configASSERT( uxSchedulerSuspended == 0 );
+    taskASSERT_SCHEDULER_NOT_SUSPENDED();
 
     /* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
      * the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
@@ -2688,19 +3645,35 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                  * switch if preemption is turned off. */
                 #if ( configUSE_PREEMPTION == 1 )
                 {
-                    /* Preemption is on, but a context switch should only be
-                     * performed if the unblocked task has a priority that is
-                     * higher than the currently executing task. */
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    #if ( configNUMBER_OF_CORES == 1 )
                     {
-                        /* Pend the yield to be performed when the scheduler
-                         * is unsuspended. */
-                        xYieldPending = pdTRUE;
+                        /* Preemption is on, but a context switch should only be
+                         * performed if the unblocked task has a priority that
+                         * is higher than the currently executing task. */
+                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        {
+                            /* Pend the yield to be performed when the scheduler
+                             * is unsuspended. */
+                            xYieldPending = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
-                    else
+                    #else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        /* The run state of the tasks on other cores is only
+                         * stable within a critical section.  A yield of this
+                         * core is held pending until the scheduler is
+                         * unsuspended. */
+                        taskENTER_CRITICAL();
+                        {
+                            prvYieldForTask( pxTCB );
+                        }
+                        taskEXIT_CRITICAL();
                     }
+                    #endif /* configNUMBER_OF_CORES */
                 }
                 #endif /* configUSE_PREEMPTION */
             }
@@ -2723,6 +3696,10 @@ BaseType_t xTaskIncrementTick( void )
     TickType_t xItemValue;
     BaseType_t xSwitchRequired = pdFALSE;
 
+    #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) )
+        BaseType_t xYieldRequiredForCore[ configNUMBER_OF_CORES ] = { pdFALSE };
+    #endif
+
     /* Called by the portable layer each time a tick interrupt occurs.
      * Increments the tick then checks to see if the new tick value will cause any
      * tasks to be unblocked. */
@@ -2819,14 +3796,25 @@ BaseType_t xTaskIncrementTick( void )
                          * processing time (which happens when both
                          * preemption and time slicing are on) is
                          * handled below.*/
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        #if ( configNUMBER_OF_CORES == 1 )
                         {
-                            xSwitchRequired = pdTRUE;
+                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                            {
+                                xSwitchRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
                         }
-                        else
+                        #else
                         {
-                            mtCOVERAGE_TEST_MARKER();
+                            /* The unblocked task may preempt the task running
+                             * on any core.  A yield of this core is picked up
+                             * from xYieldPending below. */
+                            prvYieldForTask( pxTCB );
                         }
+                        #endif /* configNUMBER_OF_CORES */
                     }
                     #endif /* configUSE_PREEMPTION */
                 }
@@ -2838,14 +3826,53 @@ BaseType_t xTaskIncrementTick( void )
          * writer has not explicitly turned time slicing off. */
         #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
         {
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+            #if ( configNUMBER_OF_CORES == 1 )
             {
-                xSwitchRequired = pdTRUE;
+                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-            else
+            #else /* configNUMBER_OF_CORES */
             {
-                mtCOVERAGE_TEST_MARKER();
+                BaseType_t xCoreID, x;
+                UBaseType_t uxPriority, uxRunningAtPriority;
+
+                /* A core only needs to give up its time slice if there are
+                 * more ready tasks at the priority of the task it is running
+                 * than there are cores running tasks of that priority. */
+                for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    uxPriority = pxCurrentTCBs[ xCoreID ]->uxPriority;
+                    uxRunningAtPriority = ( UBaseType_t ) 0U;
+
+                    for( x = ( BaseType_t ) 0; x < ( BaseType_t ) configNUMBER_OF_CORES; x++ )
+                    {
+                        if( pxCurrentTCBs[ x ]->uxPriority == uxPriority )
+                        {
+                            uxRunningAtPriority++;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+
+                    if( taskREADY_TASK_COUNT( uxPriority ) > uxRunningAtPriority )
+                    {
+                        xYieldRequiredForCore[ xCoreID ] = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
             }
+            #endif /* configNUMBER_OF_CORES */
         }
         #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
@@ -2866,14 +3893,43 @@ BaseType_t xTaskIncrementTick( void )
 
         #if ( configUSE_PREEMPTION == 1 )
         {
-            if( xYieldPending != pdFALSE )
+            #if ( configNUMBER_OF_CORES == 1 )
             {
-                xSwitchRequired = pdTRUE;
+                if( xYieldPending != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-            else
+            #else /* configNUMBER_OF_CORES */
             {
-                mtCOVERAGE_TEST_MARKER();
+                BaseType_t xCoreID;
+
+                /* This core switches on return from the tick interrupt.  Other
+                 * cores are interrupted. */
+                for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    if( ( xYieldRequiredForCore[ xCoreID ] != pdFALSE ) || ( xYieldPendings[ xCoreID ] != pdFALSE ) )
+                    {
+                        if( xCoreID == portGET_CORE_ID() )
+                        {
+                            xSwitchRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            prvYieldCore( xCoreID );
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
             }
+            #endif /* configNUMBER_OF_CORES */
         }
         #endif /* configUSE_PREEMPTION */
     }
@@ -2961,11 +4017,11 @@ BaseType_t xTaskIncrementTick( void )
 
         /* Save the hook function in the TCB.  A critical section is required as
          * the value can be accessed from an interrupt. */
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
             xReturn = pxTCB->pxTaskTag;
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
         return xReturn;
     }
@@ -3006,110 +4062,624 @@ BaseType_t xTaskIncrementTick( void )
 #endif /* configUSE_APPLICATION_TASK_TAG */
 /*-----------------------------------------------------------*/
 
-void vTaskSwitchContext( void )
-{
-    if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static void prvYieldCore( BaseType_t xCoreID )
     {
-        /* The scheduler is currently suspended - do not allow a context
-         * switch. */
-        xYieldPending = pdTRUE;
+        configASSERT( ( xCoreID >= ( BaseType_t ) 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
+
+        if( xCoreID == portGET_CORE_ID() )
+        {
+            /* The calling core switches when it leaves the critical section,
+             * or on return from the interrupt. */
+            xYieldPendings[ xCoreID ] = pdTRUE;
+        }
+        else if( pxCurrentTCBs[ xCoreID ]->xTaskRunState != taskTASK_SCHEDULED_TO_YIELD )
+        {
+            /* The task running on the other core keeps it until the core
+             * takes the interrupt, and must not be selected to run anywhere
+             * else in the meantime. */
+            portYIELD_CORE( xCoreID );
+            pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_SCHEDULED_TO_YIELD;
+        }
+        else
+        {
+            /* The core has already been interrupted. */
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
-    else
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static void prvYieldForTask( const TCB_t * pxTCB )
     {
-        xYieldPending = pdFALSE;
-        traceTASK_SWITCHED_OUT();
+        BaseType_t xCoreID;
+        BaseType_t xLowestPriorityCore = ( BaseType_t ) -1;
+        BaseType_t xLowestPriority = ( BaseType_t ) pxTCB->uxPriority;
+        BaseType_t xPriority;
+        const TCB_t * pxRunningTCB;
+
+        /* A task that is running, or is still being switched out of a core,
+         * does not need a core. */
+        if( taskTASK_IS_RUNNING_OR_SCHEDULED_TO_YIELD( pxTCB ) == pdFALSE )
+        {
+            /* Find the core running the lowest priority task that pxTCB may
+             * preempt.  Idle tasks are treated as being below the idle priority
+             * so a core running an idle task is preferred to a core running an
+             * application task of the idle priority.  Cores that are already
+             * going to select a new task are skipped. */
+            for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                pxRunningTCB = pxCurrentTCBs[ xCoreID ];
 
-        #if ( configGENERATE_RUN_TIME_STATS == 1 )
-        {
-            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
-            #else
-                ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-            #endif
+                if( ( taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) != pdFALSE ) &&
+                    ( taskTASK_IS_RUNNING( pxRunningTCB ) ) &&
+                    ( xYieldPendings[ xCoreID ] == pdFALSE ) )
+                {
+                    xPriority = ( BaseType_t ) pxRunningTCB->uxPriority;
+
+                    if( ( pxRunningTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
+                    {
+                        xPriority--;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xPriority < xLowestPriority )
+                    {
+                        xLowestPriority = xPriority;
+                        xLowestPriorityCore = xCoreID;
+                    }
+
+                    #if ( configUSE_PER_CORE_READY_LISTS == 1 )
+                        else if( ( xPriority == xLowestPriority ) && ( xCoreID == pxTCB->xReadyListCore ) && ( xLowestPriorityCore >= ( BaseType_t ) 0 ) )
+                        {
+                            /* Given the choice, yield the core whose ready lists
+                             * already hold pxTCB so it need not be stolen. */
+                            xLowestPriorityCore = xCoreID;
+                        }
+                    #endif
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
 
-            /* Add the amount of time the task has been running to the
-             * accumulated time so far.  The time the task started running was
-             * stored in ulTaskSwitchedInTime.  Note that there is no overflow
-             * protection here so count values are only valid until the timer
-             * overflows.  The guard against negative values is to protect
-             * against suspect run time stat counter implementations - which
-             * are provided by the application, not the kernel. */
-            if( ulTotalRunTime > ulTaskSwitchedInTime )
+            if( xLowestPriorityCore >= ( BaseType_t ) 0 )
             {
-                pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+                prvYieldCore( xLowestPriorityCore );
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
-
-            ulTaskSwitchedInTime = ulTotalRunTime;
         }
-        #endif /* configGENERATE_RUN_TIME_STATS */
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PER_CORE_READY_LISTS == 0 ) )
 
-        /* Check for stack overflow, if configured. */
-        taskCHECK_FOR_STACK_OVERFLOW();
+    static void prvSelectHighestPriorityTask( BaseType_t xCoreID )
+    {
+        UBaseType_t uxCurrentPriority = uxTopReadyPriority;
+        BaseType_t xTaskScheduled = pdFALSE;
+        BaseType_t xDecrementTopPriority = pdTRUE;
+        TCB_t * const pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+        TCB_t * pxTCB;
+        const ListItem_t * pxEndMarker;
+        ListItem_t * pxIterator;
 
-        /* Before the currently running task is switched out, save its errno. */
-        #if ( configUSE_POSIX_ERRNO == 1 )
+        /* If the task being switched out is still ready it is moved to the end
+         * of its ready list, so tasks of equal priority take turns on the
+         * cores. */
+        if( listIS_CONTAINED_WITHIN( taskREADY_LIST( pxPreviousTCB, pxPreviousTCB->uxPriority ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE )
         {
-            pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
+            ( void ) uxListRemove( &( pxPreviousTCB->xStateListItem ) );
+            prvAddTaskToReadyList( pxPreviousTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif
-
-        /* Select a new task to run using either the generic C or port
-         * optimised asm code. */
-        taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-        traceTASK_SWITCHED_IN();
 
-        /* After the new task is switched in, update the global errno. */
-        #if ( configUSE_POSIX_ERRNO == 1 )
+        /* Find the first task of the highest priority that is not running on
+         * another core and is allowed to run on this core.  There is an idle
+         * task for each core so one is always found. */
+        while( xTaskScheduled == pdFALSE )
         {
-            FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
+            if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxCurrentPriority ] ) ) == pdFALSE )
+            {
+                /* There are ready tasks at this priority, so
+                 * uxTopReadyPriority must not be lowered past it. */
+                xDecrementTopPriority = pdFALSE;
+                pxEndMarker = listGET_END_MARKER( &( pxReadyTasksLists[ uxCurrentPriority ] ) );
+
+                for( pxIterator = listGET_HEAD_ENTRY( &( pxReadyTasksLists[ uxCurrentPriority ] ) ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+                {
+                    pxTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                    if( ( ( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING ) || ( pxTCB == pxPreviousTCB ) ) &&
+                        ( taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) != pdFALSE ) )
+                    {
+                        pxPreviousTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+                        pxTCB->xTaskRunState = xCoreID;
+                        pxCurrentTCBs[ xCoreID ] = pxTCB;
+                        xTaskScheduled = pdTRUE;
+                        break;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            else if( xDecrementTopPriority != pdFALSE )
+            {
+                /* Nothing is ready at this priority or above. */
+                uxTopReadyPriority--;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xTaskScheduled == pdFALSE )
+            {
+                configASSERT( uxCurrentPriority > tskIDLE_PRIORITY );
+                uxCurrentPriority--;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-        #endif
 
-        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        #if ( configUSE_CORE_AFFINITY == 1 )
         {
-            /* Switch C-Runtime's TLS Block to point to the TLS
-             * Block specific to this task. */
-            configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+            /* If the task switched out is still ready but could not be selected
+             * again because its affinity has changed, it may be able to preempt
+             * a task on another core. */
+            if( ( pxPreviousTCB != pxCurrentTCBs[ xCoreID ] ) &&
+                ( listIS_CONTAINED_WITHIN( taskREADY_LIST( pxPreviousTCB, pxPreviousTCB->uxPriority ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE ) )
+            {
+                prvYieldForTask( pxPreviousTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-        #endif
+        #endif /* configUSE_CORE_AFFINITY */
     }
-}
+
+#endif /* ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PER_CORE_READY_LISTS == 0 ) ) */
 /*-----------------------------------------------------------*/
 
-void vTaskPlaceOnEventList( List_t * const pxEventList,
-                            const TickType_t xTicksToWait )
-{
-    configASSERT( pxEventList );
+#if ( configUSE_PER_CORE_READY_LISTS == 1 )
 
-    /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
-     * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+    static TCB_t * prvSearchCoreReadyLists( BaseType_t xListCore,
+                                            BaseType_t xCoreID,
+                                            UBaseType_t uxLowestPriority )
+    {
+        UBaseType_t uxCurrentPriority = uxTopReadyPriorities[ xListCore ];
+        BaseType_t xDecrementTopPriority = pdTRUE;
+        TCB_t * const pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+        TCB_t * pxReturn = NULL;
+        TCB_t * pxTCB;
+        List_t * pxList;
+        const ListItem_t * pxEndMarker;
+        ListItem_t * pxIterator;
 
-    /* Place the event list item of the TCB in the appropriate event list.
-     * This is placed in the list in priority order so the highest priority task
-     * is the first to be woken by the event.
-     *
-     * Note: Lists are sorted in ascending order by ListItem_t.xItemValue.
-     * Normally, the xItemValue of a TCB's ListItem_t members is:
-     *      xItemValue = ( configMAX_PRIORITIES - uxPriority )
-     * Therefore, the event list is sorted in descending priority order.
-     *
-     * The queue that contains the event list is locked, preventing
-     * simultaneous access from interrupts. */
-    vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+        while( ( pxReturn == NULL ) && ( uxCurrentPriority >= uxLowestPriority ) )
+        {
+            pxList = taskCORE_READY_LIST( xListCore, uxCurrentPriority );
 
-    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-}
-/*-----------------------------------------------------------*/
+            if( listLIST_IS_EMPTY( pxList ) == pdFALSE )
+            {
+                /* There are ready tasks at this priority, so the top ready
+                 * priority of xListCore must not be lowered past it. */
+                xDecrementTopPriority = pdFALSE;
+                pxEndMarker = listGET_END_MARKER( pxList );
 
-void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
-                                     const TickType_t xItemValue,
-                                     const TickType_t xTicksToWait )
-{
-    configASSERT( pxEventList );
+                for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+                {
+                    pxTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                    if( ( ( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING ) || ( pxTCB == pxPreviousTCB ) ) &&
+                        ( taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) != pdFALSE ) )
+                    {
+                        pxReturn = pxTCB;
+                        break;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            else if( ( xDecrementTopPriority != pdFALSE ) && ( uxCurrentPriority > tskIDLE_PRIORITY ) )
+            {
+                /* Nothing is ready in the lists of xListCore at this priority
+                 * or above. */
+                uxTopReadyPriorities[ xListCore ] = uxCurrentPriority - ( UBaseType_t ) 1U;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( uxCurrentPriority == tskIDLE_PRIORITY )
+            {
+                break;
+            }
+            else
+            {
+                uxCurrentPriority--;
+            }
+        }
+
+        return pxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvReadyTaskCount( UBaseType_t uxPriority )
+    {
+        UBaseType_t uxCount = ( UBaseType_t ) 0U;
+        BaseType_t xCoreID;
+
+        for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            uxCount += listCURRENT_LIST_LENGTH( taskCORE_READY_LIST( xCoreID, uxPriority ) );
+        }
+
+        return uxCount;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSelectHighestPriorityTask( BaseType_t xCoreID )
+    {
+        TCB_t * const pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+        TCB_t * pxTCB;
+        TCB_t * pxStolenTCB;
+        UBaseType_t uxLowestPriority = tskIDLE_PRIORITY;
+        BaseType_t xListCore, x;
+
+        /* If the task being switched out is still ready it is moved to the end
+         * of its ready list, so tasks of equal priority take turns on the
+         * core. */
+        if( listIS_CONTAINED_WITHIN( taskREADY_LIST( pxPreviousTCB, pxPreviousTCB->uxPriority ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE )
+        {
+            ( void ) uxListRemove( &( pxPreviousTCB->xStateListItem ) );
+            prvAddTaskToReadyList( pxPreviousTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The lists of the calling core are searched first.  A task is only
+         * taken from another core's lists if it has a higher priority than the
+         * task found here - or the same priority if the only task found here
+         * is the task being switched out, so tasks of equal priority still
+         * take turns across all the cores. */
+        pxTCB = prvSearchCoreReadyLists( xCoreID, xCoreID, tskIDLE_PRIORITY );
+
+        if( pxTCB != NULL )
+        {
+            uxLowestPriority = pxTCB->uxPriority;
+
+            if( pxTCB != pxPreviousTCB )
+            {
+                uxLowestPriority++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Look at the other cores, starting with the next one so the cores do
+         * not all steal from the same core first.  uxTopReadyPriorities lets
+         * cores with nothing of interest be skipped without touching their
+         * lists. */
+        for( x = ( BaseType_t ) 1; x < ( BaseType_t ) configNUMBER_OF_CORES; x++ )
+        {
+            xListCore = ( xCoreID + x ) % ( BaseType_t ) configNUMBER_OF_CORES;
+
+            if( uxTopReadyPriorities[ xListCore ] >= uxLowestPriority )
+            {
+                pxStolenTCB = prvSearchCoreReadyLists( xListCore, xCoreID, uxLowestPriority );
+
+                if( pxStolenTCB != NULL )
+                {
+                    pxTCB = pxStolenTCB;
+                    uxLowestPriority = pxStolenTCB->uxPriority + ( UBaseType_t ) 1U;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        /* There is an idle task for each core so a task is always found. */
+        configASSERT( pxTCB != NULL );
+
+        if( pxTCB->xReadyListCore != xCoreID )
+        {
+            /* The task was taken from another core.  Running tasks are always
+             * held in the lists of the core running them, so move it here. */
+            ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+            pxTCB->xReadyListCore = xCoreID;
+            prvAddTaskToReadyList( pxTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxPreviousTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+        pxTCB->xTaskRunState = xCoreID;
+        pxCurrentTCBs[ xCoreID ] = pxTCB;
+
+        #if ( configUSE_CORE_AFFINITY == 1 )
+        {
+            /* If the task switched out is still ready but could not be selected
+             * again because its affinity has changed, it may be able to preempt
+             * a task on another core. */
+            if( ( pxPreviousTCB != pxCurrentTCBs[ xCoreID ] ) &&
+                ( listIS_CONTAINED_WITHIN( taskREADY_LIST( pxPreviousTCB, pxPreviousTCB->uxPriority ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE ) )
+            {
+                prvYieldForTask( pxPreviousTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_CORE_AFFINITY */
+    }
+
+#endif /* configUSE_PER_CORE_READY_LISTS */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES == 1 )
+
+    void vTaskSwitchContext( void )
+    {
+        if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+        {
+            /* The scheduler is currently suspended - do not allow a context
+             * switch. */
+            xYieldPending = pdTRUE;
+        }
+        else
+        {
+            xYieldPending = pdFALSE;
+            traceTASK_SWITCHED_OUT();
+
+            #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            {
+                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                    portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+                #else
+                    ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+                #endif
+
+                /* Add the amount of time the task has been running to the
+                 * accumulated time so far.  The time the task started running was
+                 * stored in ulTaskSwitchedInTime[ 0 ].  Note that there is no overflow
+                 * protection here so count values are only valid until the timer
+                 * overflows.  The guard against negative values is to protect
+                 * against suspect run time stat counter implementations - which
+                 * are provided by the application, not the kernel. */
+                if( ulTotalRunTime > ulTaskSwitchedInTime[ 0 ] )
+                {
+                    pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime[ 0 ] );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                ulTaskSwitchedInTime[ 0 ] = ulTotalRunTime;
+            }
+            #endif /* configGENERATE_RUN_TIME_STATS */
+
+            /* Check for stack overflow, if configured. */
+            taskCHECK_FOR_STACK_OVERFLOW();
+
+            taskCRITICAL_SECTION_STATS_SWITCH( pxCurrentTCB );
+
+            /* Before the currently running task is switched out, save its errno. */
+            #if ( configUSE_POSIX_ERRNO == 1 )
+            {
+                pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
+            }
+            #endif
+
+            #if ( configUSE_WOKEN_TASK_SELECTION == 1 )
+            {
+                /* If exactly one task that can preempt the previous task has
+                 * been made ready since the last context switch, and it still
+                 * can and is still the only ready task at its priority, then it
+                 * is the task to run next and the search can be skipped.  This
+                 * is the common case of an interrupt, or another task, giving a
+                 * higher priority task the queue, semaphore or notification it
+                 * was waiting for. */
+                if( ( uxWokenTasks == ( UBaseType_t ) 1U ) &&
+                    ( pxWokenTCB->uxPriority > pxCurrentTCB->uxPriority ) &&
+                    ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxWokenTCB->uxPriority ] ) ) == ( UBaseType_t ) 1U ) &&
+                    ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxWokenTCB->uxPriority ] ), &( pxWokenTCB->xStateListItem ) ) != pdFALSE ) )
+                {
+                    pxCurrentTCB = pxWokenTCB;
+                }
+                else
+                {
+                    taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                }
+
+                uxWokenTasks = ( UBaseType_t ) 0U;
+            }
+            #else /* configUSE_WOKEN_TASK_SELECTION */
+            {
+                /* Select a new task to run using either the generic C or port
+                 * optimised asm code. */
+                taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            }
+            #endif /* configUSE_WOKEN_TASK_SELECTION */
+            traceTASK_SWITCHED_IN();
+
+            taskCRITICAL_SECTION_STATS_SWITCH( pxCurrentTCB );
+
+            /* After the new task is switched in, update the global errno. */
+            #if ( configUSE_POSIX_ERRNO == 1 )
+            {
+                FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
+            }
+            #endif
+
+            #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+            {
+                /* Switch C-Runtime's TLS Block to point to the TLS
+                 * Block specific to this task. */
+                configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+            }
+            #endif
+        }
+    }
+
+#else /* configNUMBER_OF_CORES */
+
+    void vTaskSwitchContext( void )
+    {
+        BaseType_t xCoreID;
+
+        /* Called with interrupts masked, so the calling core cannot change.
+         * The task lock is taken as well as the ISR lock so the switch waits
+         * while another core has the scheduler suspended, rather than being
+         * held pending on this core. */
+        portGET_TASK_LOCK();
+        portGET_ISR_LOCK();
+        {
+            xCoreID = portGET_CORE_ID();
+
+            if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+            {
+                /* The scheduler is suspended by this core - do not allow a
+                 * context switch. */
+                xYieldPendings[ xCoreID ] = pdTRUE;
+            }
+            else
+            {
+                xYieldPendings[ xCoreID ] = pdFALSE;
+                traceTASK_SWITCHED_OUT();
+
+                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                {
+                    #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                        portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+                    #else
+                        ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+                    #endif
+
+                    /* Add the amount of time the task has been running to the
+                     * accumulated time so far.  The time the task started
+                     * running on this core was stored in ulTaskSwitchedInTime. */
+                    if( ulTotalRunTime > ulTaskSwitchedInTime[ xCoreID ] )
+                    {
+                        pxCurrentTCBs[ xCoreID ]->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime[ xCoreID ] );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    ulTaskSwitchedInTime[ xCoreID ] = ulTotalRunTime;
+                }
+                #endif /* configGENERATE_RUN_TIME_STATS */
+
+                /* Check for stack overflow, if configured. */
+                taskCHECK_FOR_STACK_OVERFLOW();
+
+                taskCRITICAL_SECTION_STATS_SWITCH( pxCurrentTCBs[ xCoreID ] );
+
+                /* Select a new task to run on this core. */
+                prvSelectHighestPriorityTask( xCoreID );
+                traceTASK_SWITCHED_IN();
+
+                taskCRITICAL_SECTION_STATS_SWITCH( pxCurrentTCBs[ xCoreID ] );
+
+                #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+                {
+                    /* Switch C-Runtime's TLS Block to point to the TLS
+                     * Block specific to this task. */
+                    configSET_TLS_BLOCK( pxCurrentTCBs[ xCoreID ]->xTLSBlock );
+                }
+                #endif
+            }
+        }
+        portRELEASE_ISR_LOCK();
+        portRELEASE_TASK_LOCK();
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnEventList( List_t * const pxEventList,
+                            const TickType_t xTicksToWait )
+{
+    configASSERT( pxEventList );
+
+    /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
+     * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+
+    /* Place the event list item of the TCB in the appropriate event list.
+     * This is placed in the list in priority order so the highest priority task
+     * is the first to be woken by the event.
+     *
+     * Note: Lists are sorted in ascending order by ListItem_t.xItemValue.
+     * Normally, the xItemValue of a TCB's ListItem_t members is:
+     *      xItemValue = ( configMAX_PRIORITIES - uxPriority )
+     * Therefore, the event list is sorted in descending priority order.
+     *
+     * The queue that contains the event list is locked, preventing
+     * simultaneous access from interrupts. */
+    vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
+                                     const TickType_t xItemValue,
+                                     const TickType_t xTicksToWait )
+{
+    configASSERT( pxEventList );
 
     /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
      * the event groups implementation. */
@@ -3214,21 +4784,49 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
         listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
     }
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #if ( configNUMBER_OF_CORES == 1 )
     {
-        /* Return true if the task removed from the event list has a higher
-         * priority than the calling task.  This allows the calling task to know if
-         * it should force a context switch now. */
-        xReturn = pdTRUE;
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        {
+            /* Return true if the task removed from the event list has a higher
+             * priority than the calling task.  This allows the calling task to
+             * know if it should force a context switch now. */
+            xReturn = pdTRUE;
 
-        /* Mark that a yield is pending in case the user is not using the
-         * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
-        xYieldPending = pdTRUE;
+            /* Mark that a yield is pending in case the user is not using the
+             * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS
+             * function. */
+            xYieldPending = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
     }
-    else
+    #else /* configNUMBER_OF_CORES */
     {
         xReturn = pdFALSE;
+
+        #if ( configUSE_PREEMPTION == 1 )
+        {
+            /* The unblocked task may preempt the task running on any core.
+             * Only a yield of the calling core is reported to the caller, and
+             * it is also held pending in case the caller does not use the
+             * return value. */
+            prvYieldForTask( pxUnblockedTCB );
+
+            if( xYieldPending != pdFALSE )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_PREEMPTION */
     }
+    #endif /* configNUMBER_OF_CORES */
 
     return xReturn;
 }
@@ -3272,14 +4870,30 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
     listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
     prvAddTaskToReadyList( pxUnblockedTCB );
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        {
+            /* The unblocked task has a priority above that of the calling task,
+             * so a context switch is required.  This function is called with
+             * the scheduler suspended so xYieldPending is set so the context
+             * switch occurs immediately that the scheduler is resumed
+             * (unsuspended). */
+            xYieldPending = pdTRUE;
+        }
+    }
+    #elif ( configUSE_PREEMPTION == 1 )
     {
-        /* The unblocked task has a priority above that of the calling task, so
-         * a context switch is required.  This function is called with the
-         * scheduler suspended so xYieldPending is set so the context switch
-         * occurs immediately that the scheduler is resumed (unsuspended). */
-        xYieldPending = pdTRUE;
+        /* The run state of the tasks on other cores is only stable within a
+         * critical section.  A yield of this core is held pending until the
+         * scheduler is resumed. */
+        taskENTER_CRITICAL();
+        {
+            prvYieldForTask( pxUnblockedTCB );
+        }
+        taskEXIT_CRITICAL();
     }
+    #endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
@@ -3437,6 +5051,14 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
      * any. */
     portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
 
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        /* Every core starts the scheduler running an idle task.  This initial
+         * yield gets the application tasks started. */
+        taskYIELD();
+    }
+    #endif /* configNUMBER_OF_CORES */
+
     for( ; ; )
     {
         /* See if any tasks have deleted themselves - if so then the idle task
@@ -3463,8 +5085,9 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
              * A critical region is not required here as we are just reading from
              * the list, and an occasional incorrect value will not matter.  If
              * the ready list at the idle priority contains more than one task
-             * then a task other than the idle task is ready to execute. */
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+             * per core then a task other than an idle task is ready to
+             * execute. */
+            if( taskREADY_TASK_COUNT( tskIDLE_PRIORITY ) > ( UBaseType_t ) configNUMBER_OF_CORES )
             {
                 taskYIELD();
             }
@@ -3541,18 +5164,72 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TICKLESS_IDLE != 0 )
+#if ( configNUMBER_OF_CORES > 1 )
 
-    eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+/*
+ * The passive idle task runs on every core other than the first.  It performs
+ * none of the housekeeping of the idle task, which remains the responsibility
+ * of the idle task alone.
+ */
+    static portTASK_FUNCTION( prvPassiveIdleTask, pvParameters )
     {
-        #if ( INCLUDE_vTaskSuspend == 1 )
-            /* The idle task exists in addition to the application tasks. */
-            const UBaseType_t uxNonApplicationTasks = 1;
-        #endif /* INCLUDE_vTaskSuspend */
+        /* Stop warnings. */
+        ( void ) pvParameters;
 
-        eSleepModeStatus eReturn = eStandardSleep;
+        /* See prvIdleTask(). */
+        taskYIELD();
 
-        /* This function must be called from a critical section. */
+        for( ; ; )
+        {
+            #if ( configUSE_PREEMPTION == 0 )
+            {
+                /* Without preemption a passive idle task only gives up its
+                 * core when it yields. */
+                taskYIELD();
+            }
+            #endif /* configUSE_PREEMPTION */
+
+            #if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+            {
+                /* As in the idle task, yield if a task other than an idle task
+                 * shares the idle priority. */
+                if( taskREADY_TASK_COUNT( tskIDLE_PRIORITY ) > ( UBaseType_t ) configNUMBER_OF_CORES )
+                {
+                    taskYIELD();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
+
+            #if ( configUSE_PASSIVE_IDLE_HOOK == 1 )
+            {
+                extern void vApplicationPassiveIdleHook( void );
+
+                /* The same restrictions apply as to vApplicationIdleHook(). */
+                vApplicationPassiveIdleHook();
+            }
+            #endif /* configUSE_PASSIVE_IDLE_HOOK */
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+    eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+    {
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            /* The idle task exists in addition to the application tasks. */
+            const UBaseType_t uxNonApplicationTasks = 1;
+        #endif /* INCLUDE_vTaskSuspend */
+
+        eSleepModeStatus eReturn = eStandardSleep;
+
+        /* This function must be called from a critical section. */
 
         if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
         {
@@ -3654,13 +5331,38 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 #endif /* portUSING_MPU_WRAPPERS */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_PRIORITY_BITMAP_TASK_SELECTION == 1 ) && !defined( portCOUNT_LEADING_ZEROS ) )
+
+    static UBaseType_t prvHighestSetBit( uint32_t ulBitmap )
+    {
+        static const uint8_t ucDeBruijnBitPosition[ 32 ] =
+        {
+            0U,  9U,  1U,  10U, 13U, 21U, 2U,  29U, 11U, 14U, 16U, 18U, 22U, 25U, 3U,  30U,
+            8U,  12U, 20U, 28U, 15U, 17U, 24U, 7U,  19U, 27U, 23U, 6U,  26U, 5U,  4U,  31U
+        };
+
+        /* Set every bit below the most significant set bit, so the value is
+         * one less than a power of two, then look the bit number up from the
+         * top five bits of its product with a de Bruijn sequence. */
+        ulBitmap |= ulBitmap >> 1;
+        ulBitmap |= ulBitmap >> 2;
+        ulBitmap |= ulBitmap >> 4;
+        ulBitmap |= ulBitmap >> 8;
+        ulBitmap |= ulBitmap >> 16;
+
+        return ( UBaseType_t ) ucDeBruijnBitPosition[ ( uint32_t ) ( ulBitmap * 0x07C4ACDDUL ) >> 27 ];
+    }
+
+#endif /* if ( ( configUSE_PRIORITY_BITMAP_TASK_SELECTION == 1 ) && !defined( portCOUNT_LEADING_ZEROS ) ) */
+/*-----------------------------------------------------------*/
+
 static void prvInitialiseTaskLists( void )
 {
-    UBaseType_t uxPriority;
+    UBaseType_t uxList;
 
-    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+    for( uxList = ( UBaseType_t ) 0U; uxList < taskNUMBER_OF_READY_LISTS; uxList++ )
     {
-        vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
+        vListInitialise( &( pxReadyTasksLists[ uxList ] ) );
     }
 
     vListInitialise( &xDelayedTaskList1 );
@@ -3701,13 +5403,45 @@ static void prvCheckTasksWaitingTermination( void )
             taskENTER_CRITICAL();
             {
                 pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                --uxCurrentNumberOfTasks;
-                --uxDeletedTasksWaitingCleanUp;
+
+                #if ( configNUMBER_OF_CORES > 1 )
+                {
+                    /* A task that deleted itself remains on its core until
+                     * that core next switches context, so its stack cannot be
+                     * freed before then. */
+                    if( pxTCB->xTaskRunState != taskTASK_NOT_RUNNING )
+                    {
+                        pxTCB = NULL;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configNUMBER_OF_CORES */
+
+                if( pxTCB != NULL )
+                {
+                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    --uxCurrentNumberOfTasks;
+                    --uxDeletedTasksWaitingCleanUp;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
             taskEXIT_CRITICAL();
 
-            prvDeleteTCB( pxTCB );
+            if( pxTCB != NULL )
+            {
+                prvDeleteTCB( pxTCB );
+            }
+            else
+            {
+                /* Try again on the next iteration of the idle task. */
+                break;
+            }
         }
     }
     #endif /* INCLUDE_vTaskDelete */
@@ -3761,7 +5495,7 @@ static void prvCheckTasksWaitingTermination( void )
          * state is just set to whatever is passed in. */
         if( eState != eInvalid )
         {
-            if( pxTCB == pxCurrentTCB )
+            if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
             {
                 pxTaskStatus->eCurrentState = eRunning;
             }
@@ -3798,15 +5532,7 @@ static void prvCheckTasksWaitingTermination( void )
          * parameter is provided to allow it to be skipped. */
         if( xGetFreeStackSpace != pdFALSE )
         {
-            #if ( portSTACK_GROWTH > 0 )
-            {
-                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
-            }
-            #else
-            {
-                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
-            }
-            #endif
+            pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( pxTCB );
         }
         else
         {
@@ -3855,17 +5581,54 @@ static void prvCheckTasksWaitingTermination( void )
 
 #if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
 
-    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+    /* The word ulIndex words in from the end of the stack that is used last. */
+    #if ( portSTACK_GROWTH < 0 )
+        #define prvSTACK_WORD_FROM_END( pxTCB, ulIndex )    ( ( pxTCB )->pxStack[ ( ulIndex ) ] )
+    #else
+        #define prvSTACK_WORD_FROM_END( pxTCB, ulIndex )    ( *( ( pxTCB )->pxEndOfStack - ( ulIndex ) ) )
+    #endif
+
+    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( TCB_t * pxTCB )
     {
         uint32_t ulCount = 0U;
 
-        while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+        #if ( configSTACK_HIGH_WATER_MARK_BINARY_SEARCH == 1 )
         {
-            pucStackByte -= portSTACK_GROWTH;
-            ulCount++;
-        }
+            uint32_t ulHigh = ( uint32_t ) pxTCB->uxStackHighWaterMark;
+            uint32_t ulMiddle;
 
-        ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
+            /* A word that has been written is never rewritten with the fill
+             * value, so the mark can only move towards the end of the stack.
+             * Find the first written word below the last mark, taking every word
+             * below a word that is still unused to be unused too. */
+            while( ulCount < ulHigh )
+            {
+                ulMiddle = ulCount + ( ( ulHigh - ulCount ) >> 1 );
+
+                if( prvSTACK_WORD_FROM_END( pxTCB, ulMiddle ) == tskSTACK_FILL_WORD )
+                {
+                    ulCount = ulMiddle + 1U;
+                }
+                else
+                {
+                    ulHigh = ulMiddle;
+                }
+            }
+
+            pxTCB->uxStackHighWaterMark = ( configSTACK_DEPTH_TYPE ) ulCount;
+        }
+        #else /* configSTACK_HIGH_WATER_MARK_BINARY_SEARCH */
+        {
+            /* The stack is an array of StackType_t, so it can be compared a
+             * word at a time.  A word the task has written part of is not
+             * free, so counting whole words gives the same result as counting
+             * bytes and dividing by the word size. */
+            while( prvSTACK_WORD_FROM_END( pxTCB, ulCount ) == tskSTACK_FILL_WORD )
+            {
+                ulCount++;
+            }
+        }
+        #endif /* configSTACK_HIGH_WATER_MARK_BINARY_SEARCH */
 
         return ( configSTACK_DEPTH_TYPE ) ulCount;
     }
@@ -3883,7 +5646,6 @@ static void prvCheckTasksWaitingTermination( void )
     configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
     {
         TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
         configSTACK_DEPTH_TYPE uxReturn;
 
         /* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
@@ -3895,17 +5657,7 @@ static void prvCheckTasksWaitingTermination( void )
 
         pxTCB = prvGetTCBFromHandle( xTask );
 
-        #if portSTACK_GROWTH < 0
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
-        }
-        #else
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
-        }
-        #endif
-
-        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
+        uxReturn = prvTaskCheckFreeStackSpace( pxTCB );
 
         return uxReturn;
     }
@@ -3918,22 +5670,11 @@ static void prvCheckTasksWaitingTermination( void )
     UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
     {
         TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
         UBaseType_t uxReturn;
 
         pxTCB = prvGetTCBFromHandle( xTask );
 
-        #if portSTACK_GROWTH < 0
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
-        }
-        #else
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
-        }
-        #endif
-
-        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pxTCB );
 
         return uxReturn;
     }
@@ -4017,21 +5758,58 @@ static void prvResetNextTaskUnblockTime( void )
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUMBER_OF_CORES > 1 ) )
 
     TaskHandle_t xTaskGetCurrentTaskHandle( void )
     {
         TaskHandle_t xReturn;
 
-        /* A critical section is not required as this is not called from
-         * an interrupt and the current TCB will always be the same for any
-         * individual execution thread. */
-        xReturn = pxCurrentTCB;
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            /* A critical section is not required as this is not called from
+             * an interrupt and the current TCB will always be the same for any
+             * individual execution thread. */
+            xReturn = pxCurrentTCB;
+        }
+        #else
+        {
+            UBaseType_t uxSavedInterruptStatus;
+
+            /* Interrupts are masked so the calling task cannot move to another
+             * core between reading the core ID and reading its current task. */
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+            {
+                xReturn = pxCurrentTCBs[ portGET_CORE_ID() ];
+            }
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        }
+        #endif /* configNUMBER_OF_CORES */
+
+        return xReturn;
+    }
+
+#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUMBER_OF_CORES > 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID )
+    {
+        TaskHandle_t xReturn = NULL;
+
+        if( ( xCoreID >= ( BaseType_t ) 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) )
+        {
+            xReturn = pxCurrentTCBs[ xCoreID ];
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
         return xReturn;
     }
 
-#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
@@ -4046,6 +5824,15 @@ static void prvResetNextTaskUnblockTime( void )
         }
         else
         {
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                /* The task lock cannot be taken while another core has the
+                 * scheduler suspended, so only a suspension by the calling
+                 * core is reported. */
+                taskENTER_CRITICAL();
+            }
+            #endif
+
             if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
             {
                 xReturn = taskSCHEDULER_RUNNING;
@@ -4054,6 +5841,12 @@ static void prvResetNextTaskUnblockTime( void )
             {
                 xReturn = taskSCHEDULER_SUSPENDED;
             }
+
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                taskEXIT_CRITICAL();
+            }
+            #endif
         }
 
         return xReturn;
@@ -4093,7 +5886,7 @@ static void prvResetNextTaskUnblockTime( void )
 
                 /* If the task being modified is in the ready state it will need
                  * to be moved into a new list. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
+                if( listIS_CONTAINED_WITHIN( taskREADY_LIST( pxMutexHolderTCB, pxMutexHolderTCB->uxPriority ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
                 {
                     if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
                     {
@@ -4292,13 +6085,29 @@ static void prvResetNextTaskUnblockTime( void )
                         mtCOVERAGE_TEST_MARKER();
                     }
 
+                    #if ( configNUMBER_OF_CORES > 1 )
+                    {
+                        /* The mutex holder may be running on another core, in
+                         * which case that core must reschedule as the holder
+                         * now runs at a lower priority. */
+                        if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
+                        {
+                            prvYieldCore( pxTCB->xTaskRunState );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configNUMBER_OF_CORES */
+
                     /* If the running task is not the task that holds the mutex
                      * then the task that holds the mutex could be in either the
                      * Ready, Blocked or Suspended states.  Only remove the task
                      * from its current state list if it is in the Ready state as
                      * the task's priority is going to change and there is one
                      * Ready list per priority. */
-                    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                    if( listIS_CONTAINED_WITHIN( taskREADY_LIST( pxTCB, uxPriorityUsedOnEntry ), &( pxTCB->xStateListItem ) ) != pdFALSE )
                     {
                         if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
                         {
@@ -4338,7 +6147,7 @@ static void prvResetNextTaskUnblockTime( void )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if ( ( portCRITICAL_NESTING_IN_TCB == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
 
     void vTaskEnterCritical( void )
     {
@@ -4359,46 +6168,566 @@ static void prvResetNextTaskUnblockTime( void )
                 portASSERT_IF_IN_ISR();
             }
         }
-        else
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
+/*-----------------------------------------------------------*/
+
+#if ( ( portCRITICAL_NESTING_IN_TCB == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
+
+    void vTaskExitCritical( void )
+    {
+        if( xSchedulerRunning != pdFALSE )
+        {
+            if( pxCurrentTCB->uxCriticalNesting > 0U )
+            {
+                ( pxCurrentTCB->uxCriticalNesting )--;
+
+                if( pxCurrentTCB->uxCriticalNesting == 0U )
+                {
+                    portENABLE_INTERRUPTS();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vTaskEnterCritical( void )
+    {
+        TCB_t * pxThisTCB;
+
+        portDISABLE_INTERRUPTS();
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* Interrupts are disabled so the calling core cannot change. */
+            pxThisTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
+
+            /* The outermost critical section takes both kernel spinlocks, the
+             * task lock first. */
+            if( pxThisTCB->uxCriticalNesting == 0U )
+            {
+                portGET_TASK_LOCK();
+                portGET_ISR_LOCK();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            ( pxThisTCB->uxCriticalNesting )++;
+
+            /* This is not the interrupt safe version of the enter critical
+             * function so  assert() if it is being called from an interrupt
+             * context.  Only API functions that end in "FromISR" can be used in an
+             * interrupt.  Only assert if the critical nesting count is 1 to
+             * protect against recursive calls if the assert function also uses a
+             * critical section. */
+            if( pxThisTCB->uxCriticalNesting == 1U )
+            {
+                portASSERT_IF_IN_ISR();
+
+                /* Another core may have told the calling task to yield while it
+                 * was waiting for the spinlocks.  Not done if this core has the
+                 * scheduler suspended, as the yield is then held pending. */
+                if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
+                {
+                    prvCheckForRunStateChange();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vTaskExitCritical( void )
+    {
+        TCB_t * pxThisTCB;
+        BaseType_t xYieldCurrentTask;
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* Interrupts are disabled so the calling core cannot change. */
+            pxThisTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
+
+            if( pxThisTCB->uxCriticalNesting > 0U )
+            {
+                ( pxThisTCB->uxCriticalNesting )--;
+
+                if( pxThisTCB->uxCriticalNesting == 0U )
+                {
+                    /* A yield requested while the spinlocks were held is taken
+                     * now, unless this core has the scheduler suspended. */
+                    xYieldCurrentTask = ( ( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE ) && ( uxSchedulerSuspended == ( UBaseType_t ) 0U ) ) ? pdTRUE : pdFALSE;
+
+                    portRELEASE_ISR_LOCK();
+                    portRELEASE_TASK_LOCK();
+                    portENABLE_INTERRUPTS();
+
+                    if( xYieldCurrentTask != pdFALSE )
+                    {
+                        portYIELD();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    UBaseType_t uxTaskEnterCriticalFromISR( void )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        TCB_t * pxThisTCB;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* Only the ISR lock is taken, as an interrupt cannot wait for a
+             * task on another core to resume the scheduler. */
+            pxThisTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
+
+            if( pxThisTCB->uxCriticalNesting == 0U )
+            {
+                portGET_ISR_LOCK();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            ( pxThisTCB->uxCriticalNesting )++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxSavedInterruptStatus;
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus )
+    {
+        TCB_t * pxThisTCB;
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            pxThisTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
+
+            if( pxThisTCB->uxCriticalNesting > 0U )
+            {
+                ( pxThisTCB->uxCriticalNesting )--;
+
+                if( pxThisTCB->uxCriticalNesting == 0U )
+                {
+                    portRELEASE_ISR_LOCK();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vTaskYieldWithinAPI( void )
+    {
+        if( pxCurrentTCB->uxCriticalNesting == 0U )
+        {
+            portYIELD();
+        }
+        else
+        {
+            /* The calling task is in a critical section so cannot move to
+             * another core.  The yield is taken when the critical section is
+             * exited. */
+            xYieldPending = pdTRUE;
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static void prvCheckForRunStateChange( void )
+    {
+        TCB_t * const pxThisTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
+        UBaseType_t uxPrevCriticalNesting;
+
+        /* Called with interrupts disabled, and with either the task lock held
+         * by vTaskSuspendAll() or both spinlocks held by the outermost
+         * vTaskEnterCritical(). */
+        while( pxThisTCB->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD )
+        {
+            /* Another core has interrupted this one to switch the calling
+             * task out.  Release the spinlocks and let the interrupt be taken,
+             * then take the spinlocks again once the task is next selected to
+             * run, possibly on a different core. */
+            uxPrevCriticalNesting = pxThisTCB->uxCriticalNesting;
+
+            if( uxPrevCriticalNesting > 0U )
+            {
+                pxThisTCB->uxCriticalNesting = 0U;
+                portRELEASE_ISR_LOCK();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            portRELEASE_TASK_LOCK();
+            portMEMORY_BARRIER();
+
+            portENABLE_INTERRUPTS();
+
+            /* The pending yield is taken as soon as interrupts are enabled. */
+            configASSERT( pxThisTCB->xTaskRunState != taskTASK_SCHEDULED_TO_YIELD );
+
+            portDISABLE_INTERRUPTS();
+            portGET_TASK_LOCK();
+            portGET_ISR_LOCK();
+
+            pxThisTCB->uxCriticalNesting = uxPrevCriticalNesting;
+
+            if( uxPrevCriticalNesting == 0U )
+            {
+                portRELEASE_ISR_LOCK();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+    static CriticalSectionStats_t * prvCriticalSectionStatsGetSite( const char * pcFile,
+                                                                    uint32_t ulLine,
+                                                                    eCriticalRegionType eType ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        CriticalSectionStats_t * pxSite = NULL;
+        UBaseType_t x;
+
+        for( x = ( UBaseType_t ) 0U; x < uxCriticalSectionStatsSites; x++ )
+        {
+            /* Compare the line first as it is cheap, then the file name.  The
+             * same string literal is normally shared within a translation unit
+             * so the pointer comparison is usually enough. */
+            if( ( xCriticalSectionStats[ x ].ulLine == ulLine ) &&
+                ( xCriticalSectionStats[ x ].eType == eType ) &&
+                ( ( xCriticalSectionStats[ x ].pcFile == pcFile ) || ( strcmp( xCriticalSectionStats[ x ].pcFile, pcFile ) == 0 ) ) )
+            {
+                pxSite = &( xCriticalSectionStats[ x ] );
+                break;
+            }
+        }
+
+        if( pxSite == NULL )
+        {
+            if( uxCriticalSectionStatsSites < ( UBaseType_t ) configCRITICAL_SECTION_STATS_MAX_SITES )
+            {
+                pxSite = &( xCriticalSectionStats[ uxCriticalSectionStatsSites ] );
+                ( void ) memset( ( void * ) pxSite, 0x00, sizeof( CriticalSectionStats_t ) );
+                pxSite->pcFile = pcFile;
+                pxSite->ulLine = ulLine;
+                pxSite->eType = eType;
+                uxCriticalSectionStatsSites++;
+            }
+            else
+            {
+                ulCriticalSectionStatsDropped++;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxSite;
+    }
+
+#endif /* configGENERATE_CRITICAL_SECTION_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+    static void prvCriticalSectionStatsRecord( CriticalSectionStats_t * pxSite,
+                                               uint32_t ulDuration )
+    {
+        uint32_t ulScaled = ulDuration >> configCRITICAL_SECTION_STATS_HISTOGRAM_SHIFT;
+        UBaseType_t uxBucket = ( UBaseType_t ) 0U;
+
+        ( pxSite->ulCount )++;
+        pxSite->ullTotalDuration += ( uint64_t ) ulDuration;
+
+        if( ulDuration > pxSite->ulMaxDuration )
+        {
+            pxSite->ulMaxDuration = ulDuration;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The bucket is the position of the most significant set bit. */
+        while( ( ulScaled > 1UL ) && ( uxBucket < ( ( UBaseType_t ) configCRITICAL_SECTION_STATS_HISTOGRAM_BUCKETS - ( UBaseType_t ) 1U ) ) )
+        {
+            ulScaled >>= 1UL;
+            uxBucket++;
+        }
+
+        ( pxSite->ulHistogram[ uxBucket ] )++;
+    }
+
+#endif /* configGENERATE_CRITICAL_SECTION_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+    void vTaskCriticalSectionStatsEnter( const char * pcFile,
+                                         uint32_t ulLine ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        TCB_t * pxTCB;
+
+        /* Regions are only timed once the scheduler is running, which is also
+         * when a critical section begins to nest.  An interrupt is charged to
+         * the task it interrupted, which cannot run again until the interrupt
+         * has left its critical section. */
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* Called from within the critical section, so the core and its
+             * current task cannot change. */
+            #if ( configNUMBER_OF_CORES == 1 )
+                pxTCB = pxCurrentTCB;
+            #else
+                pxTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
+            #endif
+
+            if( pxTCB->uxCriticalSectionStatsNesting == ( UBaseType_t ) 0U )
+            {
+                /* Look up the call site before taking the timestamp so the
+                 * time taken by the search is not attributed to the region. */
+                pxTCB->pxCriticalSectionStatsSite = prvCriticalSectionStatsGetSite( pcFile, ulLine, eInterruptsMasked );
+                pxTCB->ulCriticalSectionStatsStart = portGET_CRITICAL_SECTION_TIMESTAMP();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            ( pxTCB->uxCriticalSectionStatsNesting )++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configGENERATE_CRITICAL_SECTION_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+    UBaseType_t uxTaskCriticalSectionStatsEnterFromISR( UBaseType_t uxSavedInterruptStatus,
+                                                        const char * pcFile,
+                                                        uint32_t ulLine ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        vTaskCriticalSectionStatsEnter( pcFile, ulLine );
+
+        return uxSavedInterruptStatus;
+    }
+
+#endif /* configGENERATE_CRITICAL_SECTION_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+    void vTaskCriticalSectionStatsExit( void )
+    {
+        const uint32_t ulNow = portGET_CRITICAL_SECTION_TIMESTAMP();
+        TCB_t * pxTCB;
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            #if ( configNUMBER_OF_CORES == 1 )
+                pxTCB = pxCurrentTCB;
+            #else
+                pxTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
+            #endif
+
+            configASSERT( pxTCB->uxCriticalSectionStatsNesting > ( UBaseType_t ) 0U );
+
+            ( pxTCB->uxCriticalSectionStatsNesting )--;
+
+            if( ( pxTCB->uxCriticalSectionStatsNesting == ( UBaseType_t ) 0U ) && ( pxTCB->pxCriticalSectionStatsSite != NULL ) )
+            {
+                prvCriticalSectionStatsRecord( pxTCB->pxCriticalSectionStatsSite, ulNow - pxTCB->ulCriticalSectionStatsStart );
+                pxTCB->pxCriticalSectionStatsSite = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configGENERATE_CRITICAL_SECTION_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+    UBaseType_t uxTaskGetCriticalSectionStats( CriticalSectionStats_t * const pxStatsArray,
+                                               const UBaseType_t uxArraySize,
+                                               uint32_t * const pulDropped )
+    {
+        UBaseType_t uxSites, x;
+
+        taskENTER_CRITICAL();
+        {
+            uxSites = uxCriticalSectionStatsSites;
+
+            if( pulDropped != NULL )
+            {
+                *pulDropped = ulCriticalSectionStatsDropped;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( uxSites > uxArraySize )
         {
-            mtCOVERAGE_TEST_MARKER();
+            uxSites = uxArraySize;
+        }
+
+        /* Entries are never removed from the table so it is safe to copy one
+         * at a time, which keeps the time for which interrupts are masked
+         * short. */
+        for( x = ( UBaseType_t ) 0U; x < uxSites; x++ )
+        {
+            taskENTER_CRITICAL();
+            {
+                pxStatsArray[ x ] = xCriticalSectionStats[ x ];
+            }
+            taskEXIT_CRITICAL();
         }
+
+        return uxSites;
     }
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+#endif /* configGENERATE_CRITICAL_SECTION_STATS */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
 
-    void vTaskExitCritical( void )
+    void vTaskClearCriticalSectionStats( void )
     {
-        if( xSchedulerRunning != pdFALSE )
-        {
-            if( pxCurrentTCB->uxCriticalNesting > 0U )
-            {
-                ( pxCurrentTCB->uxCriticalNesting )--;
+        UBaseType_t x;
 
-                if( pxCurrentTCB->uxCriticalNesting == 0U )
-                {
-                    portENABLE_INTERRUPTS();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else
+        /* The call sites themselves are retained as a region that is still
+         * being timed may reference them. */
+        for( x = ( UBaseType_t ) 0U; x < ( UBaseType_t ) configCRITICAL_SECTION_STATS_MAX_SITES; x++ )
+        {
+            taskENTER_CRITICAL();
             {
-                mtCOVERAGE_TEST_MARKER();
+                xCriticalSectionStats[ x ].ulCount = 0UL;
+                xCriticalSectionStats[ x ].ulMaxDuration = 0UL;
+                xCriticalSectionStats[ x ].ullTotalDuration = 0ULL;
+                ( void ) memset( ( void * ) xCriticalSectionStats[ x ].ulHistogram, 0x00, sizeof( xCriticalSectionStats[ x ].ulHistogram ) );
             }
+            taskEXIT_CRITICAL();
         }
-        else
+
+        taskENTER_CRITICAL();
         {
-            mtCOVERAGE_TEST_MARKER();
+            ulCriticalSectionStatsDropped = 0UL;
         }
+        taskEXIT_CRITICAL();
     }
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+#endif /* configGENERATE_CRITICAL_SECTION_STATS */
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
@@ -4844,6 +7173,68 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    static BaseType_t prvSetNotificationValue( TCB_t * pxTCB,
+                                               UBaseType_t uxIndexToNotify,
+                                               uint32_t ulValue,
+                                               eNotifyAction eAction,
+                                               uint8_t ucOriginalNotifyState )
+    {
+        BaseType_t xReturn = pdPASS;
+
+        pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
+
+        switch( eAction )
+        {
+            case eSetBits:
+                pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
+                break;
+
+            case eIncrement:
+                ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+                break;
+
+            case eSetValueWithOverwrite:
+                pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+                break;
+
+            case eSetValueWithoutOverwrite:
+
+                if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
+                {
+                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+                }
+                else
+                {
+                    /* The value could not be written to the task. */
+                    xReturn = pdFAIL;
+                }
+
+                break;
+
+            case eNoAction:
+
+                /* The task is being notified without its notify value being
+                 * updated. */
+                break;
+
+            default:
+
+                /* Should not get here if all enums are handled.
+                 * Artificially force an assert by testing a value the
+                 * compiler can't assume is const. */
+                configASSERT( xTickCount == ( TickType_t ) 0 );
+
+                break;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
     BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify,
@@ -4869,51 +7260,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
             ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
 
-            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
-
-            switch( eAction )
-            {
-                case eSetBits:
-                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
-                    break;
-
-                case eIncrement:
-                    ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
-                    break;
-
-                case eSetValueWithOverwrite:
-                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
-                    break;
-
-                case eSetValueWithoutOverwrite:
-
-                    if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
-                    {
-                        pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
-                    }
-                    else
-                    {
-                        /* The value could not be written to the task. */
-                        xReturn = pdFAIL;
-                    }
-
-                    break;
-
-                case eNoAction:
-
-                    /* The task is being notified without its notify value being
-                     * updated. */
-                    break;
-
-                default:
-
-                    /* Should not get here if all enums are handled.
-                     * Artificially force an assert by testing a value the
-                     * compiler can't assume is const. */
-                    configASSERT( xTickCount == ( TickType_t ) 0 );
-
-                    break;
-            }
+            xReturn = prvSetNotificationValue( pxTCB, uxIndexToNotify, ulValue, eAction, ucOriginalNotifyState );
 
             traceTASK_NOTIFY( uxIndexToNotify );
 
@@ -4943,16 +7290,27 @@ TickType_t uxTaskResetEventItemValue( void )
                 }
                 #endif
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
-                    taskYIELD_IF_USING_PREEMPTION();
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    {
+                        /* The notified task has a priority above the currently
+                         * executing task so a yield is required. */
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
-                else
+                #else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* The notified task may preempt the task running on any
+                     * core.  A yield of this core is taken on exiting the
+                     * critical section. */
+                    taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
                 }
+                #endif /* configNUMBER_OF_CORES */
             }
             else
             {
@@ -4967,6 +7325,123 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    BaseType_t xTaskGenericNotifyGroup( TaskHandle_t const * pxTasksToNotify,
+                                        UBaseType_t uxNumberOfTasks,
+                                        UBaseType_t uxIndexToNotify,
+                                        uint32_t ulValue,
+                                        eNotifyAction eAction )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xReturn = pdPASS;
+        UBaseType_t uxTask;
+        uint8_t ucOriginalNotifyState;
+
+        #if ( configNUMBER_OF_CORES == 1 )
+            TCB_t * pxHighestPriorityWokenTCB = NULL;
+        #endif
+
+        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        configASSERT( ( pxTasksToNotify != NULL ) || ( uxNumberOfTasks == ( UBaseType_t ) 0U ) );
+
+        taskENTER_CRITICAL();
+        {
+            for( uxTask = ( UBaseType_t ) 0U; uxTask < uxNumberOfTasks; uxTask++ )
+            {
+                configASSERT( pxTasksToNotify[ uxTask ] );
+                pxTCB = pxTasksToNotify[ uxTask ];
+
+                ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+
+                if( prvSetNotificationValue( pxTCB, uxIndexToNotify, ulValue, eAction, ucOriginalNotifyState ) != pdPASS )
+                {
+                    xReturn = pdFAIL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                traceTASK_NOTIFY( uxIndexToNotify );
+
+                /* If the task is in the blocked state specifically to wait for
+                 * a notification then unblock it now. */
+                if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+                {
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
+
+                    /* The task should not have been on an event list. */
+                    configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+                    #if ( configNUMBER_OF_CORES == 1 )
+                    {
+                        /* Only the highest priority task woken can need to
+                         * preempt the calling task, so the yield check is made
+                         * once all the tasks have been notified. */
+                        if( ( pxHighestPriorityWokenTCB == NULL ) || ( pxTCB->uxPriority > pxHighestPriorityWokenTCB->uxPriority ) )
+                        {
+                            pxHighestPriorityWokenTCB = pxTCB;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #else
+                    {
+                        /* Each woken task may preempt the task running on a
+                         * different core.  Cores that are already going to
+                         * yield are not chosen again, and a yield of this core
+                         * is taken once on exiting the critical section. */
+                        taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
+                    }
+                    #endif /* configNUMBER_OF_CORES */
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            #if ( configNUMBER_OF_CORES == 1 )
+            {
+                if( pxHighestPriorityWokenTCB != NULL )
+                {
+                    #if ( configUSE_TICKLESS_IDLE != 0 )
+                    {
+                        /* See the comment in xTaskGenericNotify(). */
+                        prvResetNextTaskUnblockTime();
+                    }
+                    #endif
+
+                    if( pxHighestPriorityWokenTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    {
+                        /* The highest priority task woken has a priority above
+                         * the currently executing task so a yield is required. */
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configNUMBER_OF_CORES */
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
     BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify,
@@ -5004,7 +7479,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
         pxTCB = xTaskToNotify;
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
             if( pulPreviousNotificationValue != NULL )
             {
@@ -5078,27 +7553,47 @@ TickType_t uxTaskResetEventItemValue( void )
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
-                    if( pxHigherPriorityTaskWoken != NULL )
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
                     {
-                        *pxHigherPriorityTaskWoken = pdTRUE;
-                    }
+                        /* The notified task has a priority above the currently
+                         * executing task so a yield is required. */
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
 
-                    /* Mark that a yield is pending in case the user is not
-                     * using the "xHigherPriorityTaskWoken" parameter to an ISR
-                     * safe FreeRTOS function. */
-                    xYieldPending = pdTRUE;
+                        /* Mark that a yield is pending in case the user is not
+                         * using the "xHigherPriorityTaskWoken" parameter to an ISR
+                         * safe FreeRTOS function. */
+                        xYieldPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
-                else
+                #elif ( configUSE_PREEMPTION == 1 )
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* The notified task may preempt the task running on any
+                     * core.  Only a yield of the core running this interrupt is
+                     * reported to the caller. */
+                    prvYieldForTask( pxTCB );
+
+                    if( ( xYieldPending != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
+                #endif /* configNUMBER_OF_CORES */
             }
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
         return xReturn;
     }
@@ -5139,7 +7634,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
         pxTCB = xTaskToNotify;
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
             ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
             pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
@@ -5169,27 +7664,47 @@ TickType_t uxTaskResetEventItemValue( void )
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
-                    if( pxHigherPriorityTaskWoken != NULL )
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
                     {
-                        *pxHigherPriorityTaskWoken = pdTRUE;
-                    }
+                        /* The notified task has a priority above the currently
+                         * executing task so a yield is required. */
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
 
-                    /* Mark that a yield is pending in case the user is not
-                     * using the "xHigherPriorityTaskWoken" parameter in an ISR
-                     * safe FreeRTOS function. */
-                    xYieldPending = pdTRUE;
+                        /* Mark that a yield is pending in case the user is not
+                         * using the "xHigherPriorityTaskWoken" parameter in an ISR
+                         * safe FreeRTOS function. */
+                        xYieldPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
-                else
+                #elif ( configUSE_PREEMPTION == 1 )
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* The notified task may preempt the task running on any
+                     * core.  Only a yield of the core running this interrupt is
+                     * reported to the caller. */
+                    prvYieldForTask( pxTCB );
+
+                    if( ( xYieldPending != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
+                #endif /* configNUMBER_OF_CORES */
             }
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
     }
 
 #endif /* configUSE_TASK_NOTIFICATIONS */
@@ -5261,7 +7776,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
     configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
     {
-        return xIdleTaskHandle->ulRunTimeCounter;
+        return xIdleTaskHandles[ 0 ]->ulRunTimeCounter;
     }
 
 #endif
@@ -5281,7 +7796,7 @@ TickType_t uxTaskResetEventItemValue( void )
         /* Avoid divide by zero errors. */
         if( ulTotalTime > ( configRUN_TIME_COUNTER_TYPE ) 0 )
         {
-            ulReturn = xIdleTaskHandle->ulRunTimeCounter / ulTotalTime;
+            ulReturn = xIdleTaskHandles[ 0 ]->ulRunTimeCounter / ulTotalTime;
         }
         else
         {